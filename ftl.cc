@@ -1,4 +1,11 @@
+#include <ftl/batch.hh>
 #include <ftl/bigint.hh>
+#include <ftl/charconv.hh>
+#include <ftl/json.hh>
+#include <ftl/json_schema.hh>
+#include <ftl/json_stream.hh>
+#include <ftl/mapped_file.hh>
+#include <ftl/radix_stream.hh>
 
 #include <cstdio>
 #include <iostream>
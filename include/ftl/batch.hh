@@ -0,0 +1,104 @@
+#ifndef FTL_BATCH_HH
+#define FTL_BATCH_HH
+
+#include <ftl/bigint_arithmetic_division.hh>
+#include <ftl/bigint_arithmetic_multiplication.hh>
+#include <ftl/bigint_arithmetic_power.hh>
+#include <ftl/bigint_base.hh>
+#include <ftl/identity.hh>
+#include <ftl/parallel.hh>
+#include <ftl/span.hh>
+
+#include <algorithm>
+#include <cstddef>
+
+namespace ftl {
+
+/*
+ * batch (Independent bigint operations spread over worker threads)
+ *
+ * Item i of every input produces item i of every output, for as many items
+ * as the first output holds. Fixed width operations allocate nothing, so
+ * each worker's scratch is its own stack and there is no allocator to
+ * contend on; 'parallel_for' balances the items by work stealing. Every
+ * call starts and joins its own 'threads - 1' threads, there is no pool,
+ * so a batch should be large enough to pay for that.
+ */
+namespace batch {
+namespace impl {
+
+/*
+ * grain_work (Limb products worth one claim from the scheduler)
+ */
+struct grain_work : identity<std::size_t, std::size_t{ 1 } << 16> {};
+
+/*
+ * grain (Items per claim)
+ *
+ * Enough items to amortize one claim at 'cost' limb products each, rounded
+ * up to whole cache lines of 'V' so neighbouring chunks do not write to
+ * the same line.
+ */
+template<typename V>
+constexpr std::size_t grain(std::size_t cost) {
+    constexpr std::size_t line = sizeof(V) >= 64 ? 1 : 64 / sizeof(V);
+    const std::size_t items = std::max<std::size_t>(1, grain_work::value / std::max<std::size_t>(cost, 1));
+    return (items + line - 1) / line * line;
+}
+
+} //namespace impl
+
+/*
+ * multiply
+ */
+template<std::size_t A_BITS, std::size_t B_BITS, typename T, typename P>
+void multiply(span<const bigint<A_BITS, T>> a, span<const bigint<B_BITS, T>> b, span<P> out, std::size_t threads) {
+    const std::size_t cost = bigint<A_BITS, T>::count * bigint<B_BITS, T>::count;
+    parallel_for(out.size(), impl::grain<P>(cost), threads, [&](std::size_t begin, std::size_t end) {
+        for (std::size_t i = begin; i < end; ++i) {
+            out[i] = ftl::multiply(a[i], b[i]);
+        }
+    });
+}
+
+/*
+ * divmod
+ */
+template<std::size_t A_BITS, std::size_t B_BITS, typename T>
+void divmod(span<const bigint<A_BITS, T>> a, span<const bigint<B_BITS, T>> b,
+    span<bigint<A_BITS, T>> quotient, span<bigint<B_BITS, T>> remainder, std::size_t threads) {
+    const std::size_t cost = bigint<A_BITS, T>::count * bigint<B_BITS, T>::count;
+    parallel_for(quotient.size(), impl::grain<bigint<A_BITS, T>>(cost), threads, [&](std::size_t begin, std::size_t end) {
+        for (std::size_t i = begin; i < end; ++i) {
+            const auto result = ftl::divmod(a[i], b[i]);
+            quotient[i] = result.first;
+            remainder[i] = result.second;
+        }
+    });
+}
+
+/*
+ * pow_mod (Shared modulus)
+ */
+template<std::size_t BITS, std::size_t E_BITS, typename T>
+void pow_mod(span<const bigint<BITS, T>> base, span<const bigint<E_BITS, T>> exponent, const bigint<BITS, T>& modulus,
+    span<bigint<BITS, T>> out, std::size_t threads) {
+    const std::size_t cost = 2 * E_BITS * bigint<BITS, T>::count * bigint<BITS, T>::count;
+    parallel_for(out.size(), impl::grain<bigint<BITS, T>>(cost), threads, [&](std::size_t begin, std::size_t end) {
+        for (std::size_t i = begin; i < end; ++i) {
+            out[i] = ftl::pow_mod(base[i], exponent[i], modulus);
+        }
+    });
+}
+
+} //namespace batch
+} //namespace ftl
+
+/*
+ * grain
+ */
+static_assert(ftl::batch::impl::grain<ftl::bigint<2048>>(64 * 64) == 16);
+static_assert(ftl::batch::impl::grain<ftl::bigint<64>>(4) == 16384);
+static_assert(ftl::batch::impl::grain<ftl::bigint<64>>(std::size_t{ 1 } << 20) == 8);
+
+#endif//FTL_BATCH_HH
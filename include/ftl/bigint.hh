@@ -2,11 +2,26 @@
 #define FTL_BIGINT_HH
 
 #include <ftl/bigint_base.hh>
+#include <ftl/bigint_batch.hh>
+#include <ftl/bigint_bytes.hh>
+#include <ftl/bigint_dyn.hh>
+#include <ftl/bigint_expression.hh>
+#include <ftl/bigint_gcd.hh>
+#include <ftl/bigint_montgomery.hh>
+#include <ftl/bigint_parallel.hh>
+#include <ftl/bigint_prime.hh>
 #include <ftl/bigint_radix.hh>
+#include <ftl/bigint_root.hh>
+#include <ftl/bigint_sort.hh>
+#include <ftl/bigint_varint.hh>
+#include <ftl/bigint_view.hh>
+#include <ftl/mpn.hh>
 
 #include <ftl/bigint_arithmetic_addition.hh>
 #include <ftl/bigint_arithmetic_division.hh>
 #include <ftl/bigint_arithmetic_multiplication.hh>
+#include <ftl/bigint_arithmetic_power.hh>
+#include <ftl/bigint_arithmetic_shift.hh>
 #include <ftl/bigint_arithmetic_subtraction.hh>
 
 #endif//FTL_BIGINT_HH
\ No newline at end of file
@@ -3,6 +3,7 @@
 
 #include <ftl/identity.hh>
 #include <ftl/bigint_base.hh>
+#include <ftl/mpn.hh>
 
 #include <algorithm>
 #include <cstdint>
@@ -22,35 +23,25 @@ template<typename T, size_t A_BITS, size_t B_BITS>
 constexpr auto add(bigint<A_BITS, T> a, bigint<B_BITS, T> b) {
     constexpr size_t BITS = impl::required_bits_addition<T, A_BITS, B_BITS>::value;
     std::array<T, impl::required_elements<T, BITS>::value> result = {};
-    T carry = { zero<T>::value };
-    for (size_t i = 0; i < result.size() - 1; i++) {
-        T ai = i < a.count ? a[i] : zero<T>::value;
-        T bi = i < b.count ? b[i] : zero<T>::value;
-        T current = ai + bi;
-        T partial = current + carry;
-        carry = (current < ai) || (partial < current) ? one<T>::value : zero<T>::value;
-        result[i] = partial;
+    for (size_t i = 0; i < a.count; i++) {
+        result[i] = a[i];
     }
-    result[result.size() - 1] = carry;
+    mpn::add(result.data(), result.data(), result.size(), b.data(), b.count);
     return bigint<BITS, T>{ result };
 }
 
 /*
- * add_in_place
+ * add_in_place (Sum truncated to the wider operand)
  */
 template<typename T, size_t A_BITS, size_t B_BITS>
 constexpr auto add_in_place(bigint<A_BITS, T> a, bigint<B_BITS, T> b) {
     constexpr size_t BITS = std::max(A_BITS, B_BITS);
     std::array<T, impl::required_elements<T, BITS>::value> result = {};
-    T carry = {zero<T>::value };
-    for (size_t i = 0; i < result.count; i++) {
-        T ai = i < a.count ? a[i] : zero<T>::value;
-        T bi = i < b.count ? b[i] : zero<T>::value;
-        T current = ai + bi;
-        T partial = current + carry;
-        carry = (current < ai) || (partial < current) ? one<T>::value : zero<T>::value;
-        result[i] = partial;
+    for (size_t i = 0; i < a.count; i++) {
+        result[i] = a[i];
     }
+    mpn::add(result.data(), result.data(), result.size(), b.data(), b.count);
+    impl::mask_top_limb<BITS>(result);
     return bigint<BITS, T>{ result };
 }
 
@@ -93,5 +84,13 @@ static_assert(ftl::add<std::uint8_t, 8, 16>({255}, {0, 255})[1] == 255);
 static_assert(ftl::add<std::uint8_t, 8, 16>({255}, {0, 255})[2] == 0);
 static_assert(ftl::add<std::uint8_t, 8, 16>({1}, {1}).size() == 3);
 static_assert(ftl::add<std::uint8_t, 8, 16>({255}, {0, 255}).highest_bit() == 16);
+static_assert(ftl::add<std::uint8_t, 12, 12>({255, 15}, {1, 0})[1] == 16);
+static_assert(ftl::add<std::uint32_t, 64, 32>({0xFFFFFFFF, 0xFFFFFFFF}, {1})[2] == 1);
+
+/*
+ * add_in_place
+ */
+static_assert(ftl::add_in_place<std::uint8_t, 16, 8>({255, 255}, {1}).highest_bit() == 0);
+static_assert(ftl::add_in_place<std::uint8_t, 12, 12>({255, 15}, {1, 0})[1] == 0);
 
 #endif//FTL_BIGINT_ARITHMETIC_ADDITION_HH
\ No newline at end of file
@@ -1,16 +1,154 @@
 #ifndef FTL_BIGINT_ARITHMETIC_DIVISION_HH
 #define FTL_BIGINT_ARITHMETIC_DIVISION_HH
 
+#include <ftl/identity.hh>
+#include <ftl/bigint_base.hh>
+#include <ftl/mpn.hh>
+
+#include <array>
+#include <cstdint>
+#include <limits>
+#include <utility>
+
 namespace ftl {
 namespace impl {
 
+/*
+ * divide_in_place (Single limb divisor)
+ *
+ * Divides the lowest 'size' limbs by 'divisor', trims 'size' past the new
+ * leading zero limbs and returns the remainder.
+ */
+template<typename T, std::size_t N>
+constexpr T divide_in_place(std::array<T, N>& limbs, std::size_t& size, T divisor) {
+    const T remainder = mpn::divrem_1(limbs.data(), limbs.data(), size, divisor);
+    size = mpn::normalized_size(limbs.data(), size);
+    return remainder;
+}
+
+}//namespace impl
+
+/*
+ * divmod (Single limb divisor)
+ */
+template<std::size_t BITS, typename T>
+constexpr auto divmod(bigint<BITS, T> a, T b) {
+    std::array<T, impl::required_elements<T, BITS>::value> quotient = a;
+    std::size_t size = quotient.size();
+    const T remainder = impl::divide_in_place(quotient, size, b);
+    return std::make_pair(bigint<BITS, T>{ quotient }, remainder);
+}
+
+/*
+ * divmod (bigint divisor)
+ *
+ * A zero divisor gives a zero quotient and remainder, so 'mpn::divrem'
+ * only ever sees a normalized divisor.
+ */
+template<std::size_t A_BITS, typename T, std::size_t B_BITS>
+constexpr auto divmod(bigint<A_BITS, T> a, bigint<B_BITS, T> b) {
+    std::array<T, impl::required_elements<T, A_BITS>::value> quotient = {};
+    std::array<T, impl::required_elements<T, B_BITS>::value> remainder = {};
+    const std::size_t an = mpn::normalized_size(a.data(), a.count);
+    const std::size_t bn = mpn::normalized_size(b.data(), b.count);
+    if (bn == 0) {
+        return std::make_pair(bigint<A_BITS, T>{ quotient }, bigint<B_BITS, T>{ remainder });
+    }
+    if (an < bn) {
+        for (std::size_t i = 0; i < an; ++i) {
+            remainder[i] = a[i];
+        }
+    } else {
+        std::array<T, impl::required_elements<T, A_BITS>::value + impl::required_elements<T, B_BITS>::value + 1> scratch = {};
+        mpn::divrem(quotient.data(), remainder.data(), a.data(), an, b.data(), bn, scratch.data());
+    }
+    return std::make_pair(bigint<A_BITS, T>{ quotient }, bigint<B_BITS, T>{ remainder });
+}
+
+/*
+ * divide (Single limb divisor)
+ */
+template<std::size_t BITS, typename T>
+constexpr auto divide(bigint<BITS, T> a, T b) {
+    return divmod(a, b).first;
+}
+
+/*
+ * modulo (Single limb divisor)
+ */
+template<std::size_t BITS, typename T>
+constexpr auto modulo(bigint<BITS, T> a, T b) {
+    return divmod(a, b).second;
+}
+
+/*
+ * divide (bigint divisor)
+ */
+template<std::size_t A_BITS, typename T, std::size_t B_BITS>
+constexpr auto divide(bigint<A_BITS, T> a, bigint<B_BITS, T> b) {
+    return divmod(a, b).first;
+}
+
+/*
+ * modulo (bigint divisor)
+ */
+template<std::size_t A_BITS, typename T, std::size_t B_BITS>
+constexpr auto modulo(bigint<A_BITS, T> a, bigint<B_BITS, T> b) {
+    return divmod(a, b).second;
+}
+
+/*
+ * '/' (Division Operators)
+ */
+template<std::size_t BITS, typename T>
+constexpr auto operator/(bigint<BITS, T> a, T b) {
+    return divide(a, b);
+}
+
+template<std::size_t A_BITS, typename T, std::size_t B_BITS>
+constexpr auto operator/(bigint<A_BITS, T> a, bigint<B_BITS, T> b) {
+    return divide(a, b);
 }
 
 /*
- * Division
+ * '%' (Modulo Operators)
  */
-// TODO
+template<std::size_t BITS, typename T>
+constexpr auto operator%(bigint<BITS, T> a, T b) {
+    return modulo(a, b);
+}
 
+template<std::size_t A_BITS, typename T, std::size_t B_BITS>
+constexpr auto operator%(bigint<A_BITS, T> a, bigint<B_BITS, T> b) {
+    return modulo(a, b);
 }
 
-#endif//FTL_BIGINT_ARITHMETIC_DIVISION_HH
\ No newline at end of file
+}//namespace ftl
+
+/*
+ * divmod
+ */
+static_assert(ftl::divmod<16, std::uint8_t>({ 0x39, 0x30 }, 10).first[0] == 0xD2);
+static_assert(ftl::divmod<16, std::uint8_t>({ 0x39, 0x30 }, 10).first[1] == 0x04);
+static_assert(ftl::divmod<16, std::uint8_t>({ 0x39, 0x30 }, 10).second == 5);
+static_assert(ftl::divmod<64, std::uint32_t>({ 0, 1 }, 3).first[0] == 0x55555555);
+static_assert(ftl::divmod<64, std::uint32_t>({ 0, 1 }, 3).first[1] == 0);
+static_assert(ftl::divmod<64, std::uint32_t>({ 0, 1 }, 3).second == 1);
+
+static_assert(ftl::divmod<64, std::uint16_t, 32>({ 0xCDEF, 0x89AB, 0x4567, 0x0123 }, { 0x0001, 0x8000 }).first[0] == 0x8ACF);
+static_assert(ftl::divmod<64, std::uint16_t, 32>({ 0xCDEF, 0x89AB, 0x4567, 0x0123 }, { 0x0001, 0x8000 }).second[1] == 0x0765);
+static_assert(ftl::divmod<16, std::uint8_t, 32>({ 0x39, 0x30 }, { 0, 0, 1, 0 }).second[1] == 0x30);
+static_assert(ftl::divmod<16, std::uint8_t, 32>({ 0x39, 0x30 }, { 0, 0, 0, 0 }).first == ftl::bigint<16, std::uint8_t>{ 0, 0 });
+static_assert(ftl::divmod<16, std::uint8_t, 32>({ 0x39, 0x30 }, { 0, 0, 0, 0 }).second == ftl::bigint<32, std::uint8_t>{ 0, 0, 0, 0 });
+
+/*
+ * '/' and '%'
+ */
+static_assert((ftl::bigint<16, std::uint8_t>{ 0x39, 0x30 } / std::uint8_t{ 100 })[0] == 123);
+static_assert((ftl::bigint<16, std::uint8_t>{ 0x39, 0x30 } % std::uint8_t{ 100 }) == 45);
+static_assert((ftl::bigint<128>{ 0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF } / ftl::bigint<96>{ 1, 0, 1 })
+    == ftl::bigint<64>{ 0xFFFFFFFF, 0xFFFFFFFF });
+static_assert((ftl::bigint<128>{ 0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF } % ftl::bigint<96>{ 0, 0, 1 })
+    == ftl::bigint<64>{ 0xFFFFFFFF, 0xFFFFFFFF });
+
+#endif//FTL_BIGINT_ARITHMETIC_DIVISION_HH
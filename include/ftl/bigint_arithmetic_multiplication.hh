@@ -3,9 +3,12 @@
 
 #include <ftl/identity.hh>
 #include <ftl/bigint_base.hh>
+#include <ftl/mpn.hh>
 
 #include <algorithm>
+#include <array>
 #include <cstdint>
+#include <limits>
 
 namespace ftl {
 namespace impl {
@@ -13,31 +16,37 @@ namespace impl {
 template<typename T, std::size_t A_BITS, std::size_t B_BITS>
 struct required_bits_multiplication : identity<size_t, A_BITS + B_BITS> {};
 
+/*
+ * multiply_add_in_place (limbs = limbs * factor + addend)
+ *
+ * Only the lowest 'size' limbs are read; 'size' grows with the carry. The
+ * carry that did not fit in N limbs is returned.
+ */
+template<typename T, std::size_t N>
+constexpr T multiply_add_in_place(std::array<T, N>& limbs, std::size_t& size, T factor, T addend) {
+    T carry = mpn::mul_1(limbs.data(), limbs.data(), size, factor);
+    const T overflow = mpn::add_1(limbs.data(), limbs.data(), size, addend);
+    carry = static_cast<T>(carry + overflow);
+    if (carry != zero<T>::value && size < N) {
+        limbs[size++] = carry;
+        carry = zero<T>::value;
+    }
+    return carry;
+}
+
 } //namespace impl
 
 /*
- * multiply
+ * multiply (Schoolbook, one 'addmul_1' row per limb of 'b')
  */
 template<typename T, std::size_t A_BITS, std::size_t B_BITS>
 constexpr auto multiply(bigint<A_BITS, T> a, bigint<B_BITS, T> b) {
-    using OverflowType = typename impl::bigint_datatype<T>::overflow_type;
     bigint<impl::required_bits_multiplication<T, A_BITS, B_BITS>::value, T> result = { zero<T>::value };
-    for (auto bi = 0; bi < b.count; ++bi) {
-        T k = 0;
-        const auto count = std::min(a.count, result.count - bi);
-        for (auto ai = 0; ai < count; ++ai) {
-            OverflowType product = multiply(
-            static_cast<OverflowType>(a[ai]),
-            static_cast<OverflowType>(b[bi]));
-            OverflowType partial = add(
-            static_cast<OverflowType>(result[ai + bi]),
-            static_cast<OverflowType>(k));
-            OverflowType sum = add(partial, product);
-            result[ai + bi] = static_cast<T>(sum);
-            k = sum >> static_cast<T>(std::numeric_limits<T>::digits);
-        }
+    for (std::size_t bi = 0; bi < b.count; ++bi) {
+        const std::size_t count = std::min(a.count, result.count - bi);
+        const T carry = mpn::addmul_1(result.data() + bi, a.data(), count, b[bi]);
         if (bi + count < result.count) {
-            result[bi + count] = k;
+            result[bi + count] = carry;
         }
     }
     return result;
@@ -0,0 +1,52 @@
+#ifndef FTL_BIGINT_ARITHMETIC_POWER_HH
+#define FTL_BIGINT_ARITHMETIC_POWER_HH
+
+#include <ftl/bigint_arithmetic_division.hh>
+#include <ftl/bigint_arithmetic_multiplication.hh>
+#include <ftl/bigint_base.hh>
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+
+namespace ftl {
+
+/*
+ * multiply_mod ((a * b) % modulus)
+ */
+template<std::size_t BITS, typename T>
+constexpr auto multiply_mod(bigint<BITS, T> a, bigint<BITS, T> b, bigint<BITS, T> modulus) {
+    return modulo(multiply(a, b), modulus);
+}
+
+/*
+ * pow_mod ((base ^ exponent) % modulus, modulus not zero)
+ *
+ * Left-to-right square and multiply over the bits of 'exponent'.
+ */
+template<std::size_t BITS, typename T, std::size_t E_BITS>
+constexpr auto pow_mod(bigint<BITS, T> base, bigint<E_BITS, T> exponent, bigint<BITS, T> modulus) {
+    bigint<BITS, T> result = modulo(one<bigint<BITS, T>>::value, modulus);
+    base = modulo(base, modulus);
+    for (std::size_t i = exponent.highest_bit(); i > 0; --i) {
+        result = multiply_mod(result, result, modulus);
+        const T limb = exponent[(i - 1) / std::numeric_limits<T>::digits];
+        if ((limb >> ((i - 1) % std::numeric_limits<T>::digits)) & one<T>::value) {
+            result = multiply_mod(result, base, modulus);
+        }
+    }
+    return result;
+}
+
+} //namespace ftl
+
+/*
+ * pow_mod
+ */
+static_assert(ftl::pow_mod<16, std::uint8_t, 8>({ 4, 0 }, { 13 }, { 0xF1, 0x01 })[0] == 445 - 256);
+static_assert(ftl::pow_mod<16, std::uint8_t, 8>({ 4, 0 }, { 13 }, { 0xF1, 0x01 })[1] == 1);
+static_assert(ftl::pow_mod<64, std::uint32_t, 32>({ 2, 0 }, { 0 }, { 1, 0 })[0] == 0);
+static_assert(ftl::pow_mod<64, std::uint32_t, 64>({ 3, 0 }, { 0xFFFFFFFF, 0 }, { 0xFFFFFFFB, 0xFFFFFFFF })
+    == ftl::bigint<64, std::uint32_t>{ 0x56DB39B2, 0x26CEB20A });
+
+#endif//FTL_BIGINT_ARITHMETIC_POWER_HH
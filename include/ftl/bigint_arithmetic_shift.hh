@@ -0,0 +1,88 @@
+#ifndef FTL_BIGINT_ARITHMETIC_SHIFT_HH
+#define FTL_BIGINT_ARITHMETIC_SHIFT_HH
+
+#include <ftl/bigint_base.hh>
+#include <ftl/mpn.hh>
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+
+namespace ftl {
+
+/*
+ * shift_left (Bits shifted past BITS are dropped)
+ */
+template<std::size_t BITS, typename T>
+constexpr auto shift_left(bigint<BITS, T> a, std::size_t shift) {
+    constexpr std::size_t digits = std::numeric_limits<T>::digits;
+    std::array<T, impl::required_elements<T, BITS>::value> result = {};
+    const std::size_t limbs = shift / digits;
+    if (limbs < result.size()) {
+        const std::size_t n = result.size() - limbs;
+        if (shift % digits == 0) {
+            for (std::size_t i = 0; i < n; ++i) {
+                result[limbs + i] = a[i];
+            }
+        } else {
+            mpn::lshift(result.data() + limbs, a.data(), n, static_cast<unsigned>(shift % digits));
+        }
+        impl::mask_top_limb<BITS>(result);
+    }
+    return bigint<BITS, T>{ result };
+}
+
+/*
+ * shift_right
+ */
+template<std::size_t BITS, typename T>
+constexpr auto shift_right(bigint<BITS, T> a, std::size_t shift) {
+    constexpr std::size_t digits = std::numeric_limits<T>::digits;
+    std::array<T, impl::required_elements<T, BITS>::value> result = {};
+    const std::size_t limbs = shift / digits;
+    if (limbs < result.size()) {
+        const std::size_t n = result.size() - limbs;
+        if (shift % digits == 0) {
+            for (std::size_t i = 0; i < n; ++i) {
+                result[i] = a[limbs + i];
+            }
+        } else {
+            mpn::rshift(result.data(), a.data() + limbs, n, static_cast<unsigned>(shift % digits));
+        }
+    }
+    return bigint<BITS, T>{ result };
+}
+
+/*
+ * '<<' and '>>' (Shift Operators)
+ */
+template<std::size_t BITS, typename T>
+constexpr auto operator<<(bigint<BITS, T> a, std::size_t shift) {
+    return shift_left(a, shift);
+}
+
+template<std::size_t BITS, typename T>
+constexpr auto operator>>(bigint<BITS, T> a, std::size_t shift) {
+    return shift_right(a, shift);
+}
+
+} //namespace ftl
+
+/*
+ * shift_left
+ */
+static_assert(ftl::shift_left<16, std::uint8_t>({ 0x81, 0x42 }, 1)[1] == 0x85);
+static_assert(ftl::shift_left<16, std::uint8_t>({ 0x81, 0x42 }, 8)[1] == 0x81);
+static_assert(ftl::shift_left<16, std::uint8_t>({ 0x81, 0x42 }, 16)[1] == 0);
+static_assert(ftl::shift_left<12, std::uint8_t>({ 0x81, 0x02 }, 4)[1] == 0x08);
+
+/*
+ * shift_right
+ */
+static_assert(ftl::shift_right<16, std::uint8_t>({ 0x81, 0x42 }, 4)[0] == 0x28);
+static_assert(ftl::shift_right<16, std::uint8_t>({ 0x81, 0x42 }, 12)[0] == 0x04);
+static_assert((ftl::bigint<64, std::uint32_t>{ 0, 1 } >> 1)[0] == 0x80000000);
+static_assert((ftl::bigint<64, std::uint32_t>{ 1, 0 } << 63)[1] == 0x80000000);
+
+#endif//FTL_BIGINT_ARITHMETIC_SHIFT_HH
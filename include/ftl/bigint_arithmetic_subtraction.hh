@@ -3,9 +3,12 @@
 
 #include <ftl/identity.hh>
 #include <ftl/bigint_base.hh>
+#include <ftl/mpn.hh>
 
 #include <algorithm>
+#include <array>
 #include <cstdint>
+#include <limits>
 
 namespace ftl {
 namespace impl {
@@ -16,39 +19,64 @@ struct required_bits_subtraction : identity<std::size_t, std::max(A_BITS, B_BITS
 } //namespace impl
 
 /*
- * subtract
+ * subtract (Two's complement, the top limb all ones on a borrow)
  */
 template<typename T, std::size_t A_BITS, std::size_t B_BITS>
 constexpr auto subtract(bigint<A_BITS, T> a, bigint<B_BITS, T> b) {
-    bigint<impl::required_bits_subtraction<T, A_BITS, B_BITS>::value, T> result = { zero<T>::value };
-    T carry = {zero<T>::value };
-    for (std::size_t i = 0; i < result.count - 1; i++) {
-        T ai = i < a.count ? a[i] : zero<T>::value;
-        T bi = i < b.count ? b[i] : zero<T>::value;
-        auto current = ai - bi;
-        auto partial = current - carry;
-        carry = (current > ai) || (partial > current) ? one<T>::value : zero<T>::value;
-        result[i] = partial;
+    constexpr std::size_t BITS = impl::required_bits_subtraction<T, A_BITS, B_BITS>::value;
+    std::array<T, impl::required_elements<T, BITS>::value> result = {};
+    for (std::size_t i = 0; i < a.count; i++) {
+        result[i] = a[i];
     }
-    result[result.count - 1] = carry * static_cast<T>(-1);
-    return result;
+    mpn::sub(result.data(), result.data(), result.size(), b.data(), b.count);
+    return bigint<BITS, T>{ result };
 }
 
+/*
+ * subtract_in_place (Difference modulo 2^max(A_BITS, B_BITS))
+ */
 template<typename T, std::size_t A_BITS, std::size_t B_BITS>
 constexpr auto subtract_in_place(bigint<A_BITS, T> a, bigint<B_BITS, T> b) {
-    bigint<std::max(A_BITS, B_BITS), T> result = { zero<T>::value };
-    T carry = {zero<T>::value };
-    for (std::size_t i = 0; i < result.count; i++) {
-        T ai = i < a.count ? a[i] : zero<T>::value;
-        T bi = i < b.count ? b[i] : zero<T>::value;
-        auto current = ai - bi;
-        auto partial = current - carry;
-        carry = (current > ai) || (partial > current) ? one<T>::value : zero<T>::value;
-        result[i] = partial;
+    constexpr std::size_t BITS = std::max(A_BITS, B_BITS);
+    std::array<T, impl::required_elements<T, BITS>::value> result = {};
+    for (std::size_t i = 0; i < a.count; i++) {
+        result[i] = a[i];
     }
-    return result;
+    mpn::sub(result.data(), result.data(), result.size(), b.data(), b.count);
+    impl::mask_top_limb<BITS>(result);
+    return bigint<BITS, T>{ result };
+}
+
+/*
+ * '-' (Subtraction Operators)
+ */
+template<std::size_t BITS, typename T>
+constexpr auto operator-(bigint<BITS, T> a, T b) {
+    bigint<std::numeric_limits<T>::digits, T> bb = { b };
+    return subtract_in_place(a, bb);
+}
+
+template<std::size_t BITS, typename T>
+constexpr auto operator-(bigint<BITS, T> a, bigint<BITS, T> b) {
+    return subtract_in_place(a, b);
 }
 
 } //namespace ftl
 
+/*
+ * subtract
+ */
+static_assert(ftl::subtract<std::uint8_t, 16, 8>({0, 1}, {1})[0] == 255);
+static_assert(ftl::subtract<std::uint8_t, 16, 8>({0, 1}, {1})[1] == 0);
+static_assert(ftl::subtract<std::uint8_t, 16, 8>({0, 1}, {1})[2] == 0);
+static_assert(ftl::subtract<std::uint8_t, 8, 8>({1}, {2})[0] == 255);
+static_assert(ftl::subtract<std::uint8_t, 8, 8>({1}, {2})[1] == 255);
+
+/*
+ * subtract_in_place & '-'
+ */
+static_assert(ftl::subtract_in_place<std::uint8_t, 12, 12>({0, 0}, {1, 0})[1] == 0x0F);
+static_assert((ftl::bigint<64, std::uint32_t>{ 0, 1 } - std::uint32_t{ 1 })[0] == 0xFFFFFFFF);
+static_assert((ftl::bigint<64, std::uint32_t>{ 0, 1 } - ftl::bigint<64, std::uint32_t>{ 1, 1 })[1] == 0xFFFFFFFF);
+
 #endif//FTL_BIGINT_ARITHMETIC_SUBTRACTION_HH
\ No newline at end of file
@@ -4,7 +4,9 @@
 #include <ftl/arithmetic.hh>
 #include <ftl/identity.hh>
 
+#include <algorithm>
 #include <array>
+#include <cstddef>
 #include <cstdint>
 #include <limits>
 #include <type_traits>
@@ -32,6 +34,13 @@ struct bigint_datatype<std::uint32_t> {
     typedef std::uint64_t overflow_type;
 };
 
+#if defined(__SIZEOF_INT128__)
+template<>
+struct bigint_datatype<std::uint64_t> {
+    typedef unsigned __int128 overflow_type;
+};
+#endif
+
 template<typename T, std::size_t BITS>
 struct required_elements : identity<
     std::size_t,
@@ -41,6 +50,16 @@ struct required_elements : identity<
 template<typename T>
 struct default_bits : identity<T, 256> {};
 
+/*
+ * mask_top_limb (Clear the bits above BITS)
+ */
+template<std::size_t BITS, typename T, std::size_t N>
+constexpr void mask_top_limb(std::array<T, N>& limbs) {
+    if (BITS % std::numeric_limits<T>::digits != 0) {
+        limbs[N - 1] &= static_cast<T>((T{ 1 } << (BITS % std::numeric_limits<T>::digits)) - 1);
+    }
+}
+
 } //namespace impl
 
 /*
@@ -58,8 +77,8 @@ template<
 struct bigint :
     std::array<T, impl::required_elements<T, BITS>::value>
 {
-    const size_t bits = BITS;
-    const size_t count = impl::required_elements<T, BITS>::value;
+    static constexpr std::size_t bits = BITS;
+    static constexpr std::size_t count = impl::required_elements<T, BITS>::value;
 
     constexpr size_t highest_bit() const {
         size_t i = count - 1;
@@ -68,13 +87,26 @@ struct bigint :
         }
 
         size_t j = std::numeric_limits<T>::digits;
-        while (j > 0 && (this->at(i) & (0x01 << (j - 1))) == 0) {
+        while (j > 0 && (this->at(i) & (T{ 1 } << (j - 1))) == 0) {
             j--;
         }
         return i * std::numeric_limits<T>::digits + j;
     }
 };
 
+/*
+ * resize (Zero extend, or truncate to the low BITS bits)
+ */
+template<std::size_t BITS, std::size_t FROM_BITS, typename T>
+constexpr auto resize(bigint<FROM_BITS, T> value) {
+    std::array<T, impl::required_elements<T, BITS>::value> result = {};
+    for (std::size_t i = 0; i < result.size() && i < value.count; ++i) {
+        result[i] = value[i];
+    }
+    impl::mask_top_limb<BITS>(result);
+    return bigint<BITS, T>{ result };
+}
+
 /*
  * zero
  */
@@ -124,7 +156,7 @@ constexpr bool operator==(bigint<A_BITS, T> a, bigint<B_BITS, T> b) {
     for (size_t i = 0; i < count; ++i) {
         T ai = i < a.count ? a[i] : zero<T>::value;
         T bi = i < b.count ? b[i] : zero<T>::value;
-        if (is_not_equal(a[i], b[i])) {
+        if (is_not_equal(ai, bi)) {
             return false;
         }
     }
@@ -144,6 +176,47 @@ constexpr bool operator==(bigint<BITS, T> a, T b) {
     return true;
 }
 
+namespace impl {
+
+/*
+ * compare_values (-1, 0 or 1, by value across widths)
+ */
+template<typename T, size_t A_BITS, size_t B_BITS>
+constexpr int compare_values(const bigint<A_BITS, T>& a, const bigint<B_BITS, T>& b) {
+    constexpr auto count = std::max(bigint<A_BITS, T>::count, bigint<B_BITS, T>::count);
+    for (size_t i = count; i > 0; --i) {
+        T ai = i - 1 < a.count ? a[i - 1] : zero<T>::value;
+        T bi = i - 1 < b.count ? b[i - 1] : zero<T>::value;
+        if (is_not_equal(ai, bi)) {
+            return is_less(ai, bi) ? -1 : 1;
+        }
+    }
+    return 0;
+}
+
+} //namespace impl
+
+/*
+ * Comparison Operators (By value across widths)
+ *
+ * Declared next to '==' so that no includer falls back to the
+ * lexicographic ordering of the underlying 'std::array'.
+ */
+template<typename T, size_t A_BITS, size_t B_BITS>
+constexpr bool operator!=(const bigint<A_BITS, T>& a, const bigint<B_BITS, T>& b) { return impl::compare_values(a, b) != 0; }
+
+template<typename T, size_t A_BITS, size_t B_BITS>
+constexpr bool operator<(const bigint<A_BITS, T>& a, const bigint<B_BITS, T>& b) { return impl::compare_values(a, b) < 0; }
+
+template<typename T, size_t A_BITS, size_t B_BITS>
+constexpr bool operator<=(const bigint<A_BITS, T>& a, const bigint<B_BITS, T>& b) { return impl::compare_values(a, b) <= 0; }
+
+template<typename T, size_t A_BITS, size_t B_BITS>
+constexpr bool operator>(const bigint<A_BITS, T>& a, const bigint<B_BITS, T>& b) { return impl::compare_values(a, b) > 0; }
+
+template<typename T, size_t A_BITS, size_t B_BITS>
+constexpr bool operator>=(const bigint<A_BITS, T>& a, const bigint<B_BITS, T>& b) { return impl::compare_values(a, b) >= 0; }
+
 } //namespace ftl
 
 /*
@@ -164,6 +237,15 @@ static_assert(ftl::bigint<8, std::uint8_t>({}).size() == 1);
 static_assert(ftl::bigint<32, std::uint8_t>({}).size() == 4);
 static_assert(ftl::bigint<64, std::uint8_t>({}).size() == 8);
 
+/*
+ * resize
+ */
+static_assert(ftl::resize<16>(ftl::bigint<32, std::uint8_t>({ 1, 2, 3, 4 })).size() == 2);
+static_assert(ftl::resize<16>(ftl::bigint<32, std::uint8_t>({ 1, 2, 3, 4 }))[1] == 2);
+static_assert(ftl::resize<12>(ftl::bigint<32, std::uint8_t>({ 1, 0xFF, 3, 4 }))[1] == 0x0F);
+static_assert(ftl::resize<64>(ftl::bigint<16, std::uint8_t>({ 1, 2 })).size() == 8);
+static_assert(ftl::resize<64>(ftl::bigint<16, std::uint8_t>({ 1, 2 }))[7] == 0);
+
 /*
  * zero
  */
@@ -199,4 +281,13 @@ static_assert(ftl::ten<ftl::bigint<64, std::uint8_t>>::value.bits == 64);
 static_assert(ftl::ten<ftl::bigint<64, std::uint8_t>>::value.count == 8);
 static_assert(ftl::ten<ftl::bigint<64, std::uint8_t>>::value.highest_bit() == 4);
 
+/*
+ * Comparison Operators
+ */
+static_assert(ftl::bigint<16, std::uint8_t>{ 0xFF, 1 } < ftl::bigint<32, std::uint8_t>{ 0, 2, 0, 0 });
+static_assert(ftl::bigint<32, std::uint8_t>{ 0, 2, 0, 0 } > ftl::bigint<16, std::uint8_t>{ 0xFF, 1 });
+static_assert(ftl::bigint<16, std::uint8_t>{ 1, 2 } <= ftl::bigint<32, std::uint8_t>{ 1, 2, 0, 0 });
+static_assert(ftl::bigint<16, std::uint8_t>{ 1, 2 } >= ftl::bigint<32, std::uint8_t>{ 1, 2, 0, 0 });
+static_assert(ftl::bigint<16, std::uint8_t>{ 0, 2 } != ftl::bigint<8, std::uint8_t>{ 2 });
+
 #endif//FTL_BIGINT_BASE_HH
\ No newline at end of file
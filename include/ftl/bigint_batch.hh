@@ -0,0 +1,399 @@
+#ifndef FTL_BIGINT_BATCH_HH
+#define FTL_BIGINT_BATCH_HH
+
+#include <ftl/bigint_base.hh>
+#include <ftl/bigint_montgomery.hh>
+#include <ftl/identity.hh>
+#include <ftl/mpn.hh>
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+namespace ftl {
+
+/*
+ * bigint_batch (Structure of arrays)
+ *
+ * LANES values of BITS bits in 32 bit limbs, stored limb-major: limbs[i]
+ * holds limb i of every lane, so one vector load brings the same limb of
+ * 8 lanes. Every operation works lane by lane and gives, bit for bit, the
+ * limbs of the matching bigint function.
+ */
+template<std::size_t BITS, std::size_t LANES>
+struct bigint_batch {
+    using value_type = bigint<BITS, std::uint32_t>;
+    static constexpr std::size_t bits = BITS;
+    static constexpr std::size_t count = value_type::count;
+    static constexpr std::size_t lanes = LANES;
+
+    alignas(32) std::array<std::array<std::uint32_t, LANES>, count> limbs;
+
+    constexpr value_type get(std::size_t lane) const {
+        value_type value = { 0 };
+        for (std::size_t i = 0; i < count; ++i) {
+            value[i] = limbs[i][lane];
+        }
+        return value;
+    }
+
+    constexpr void set(std::size_t lane, const value_type& value) {
+        for (std::size_t i = 0; i < count; ++i) {
+            limbs[i][lane] = value[i];
+        }
+    }
+};
+
+namespace impl {
+
+/*
+ * batch_top_mask (Bits of the top limb below BITS)
+ */
+template<std::size_t BITS>
+struct batch_top_mask : identity<std::uint32_t, BITS % 32 == 0 ? 0xFFFFFFFFu : (1u << (BITS % 32)) - 1> {};
+
+/*
+ * gather_lane (Limbs of one lane, zero extended to 'n')
+ */
+template<std::size_t BITS, std::size_t LANES>
+constexpr void gather_lane(const bigint_batch<BITS, LANES>& batch, std::size_t lane, std::uint32_t* out, std::size_t n) {
+    for (std::size_t i = 0; i < n; ++i) {
+        out[i] = i < batch.count ? batch.limbs[i][lane] : 0;
+    }
+}
+
+/*
+ * scatter_lane (Low limbs of one lane, the top limb masked to BITS)
+ */
+template<std::size_t BITS, std::size_t LANES>
+constexpr void scatter_lane(bigint_batch<BITS, LANES>& batch, std::size_t lane, const std::uint32_t* in) {
+    std::array<std::uint32_t, bigint_batch<BITS, LANES>::count> limbs = {};
+    for (std::size_t i = 0; i < limbs.size(); ++i) {
+        limbs[i] = in[i];
+    }
+    mask_top_limb<BITS>(limbs);
+    for (std::size_t i = 0; i < limbs.size(); ++i) {
+        batch.limbs[i][lane] = limbs[i];
+    }
+}
+
+#if defined(__AVX2__)
+/*
+ * low_limbs_avx2 (Low 32 bits of four 64 bit lanes, packed)
+ */
+inline __m128i low_limbs_avx2(__m256i x) {
+    return _mm256_castsi256_si128(_mm256_permutevar8x32_epi32(x, _mm256_setr_epi32(0, 2, 4, 6, 1, 3, 5, 7)));
+}
+
+/*
+ * load_wide_avx2 (Limb i of four lanes, one per 64 bit lane)
+ */
+inline __m256i load_wide_avx2(const std::uint32_t* p) {
+    return _mm256_cvtepu32_epi64(_mm_loadu_si128(reinterpret_cast<const __m128i*>(p)));
+}
+
+/*
+ * multiply_avx2 (Schoolbook product of four lanes, 2n limbs in 'r')
+ *
+ * Each column step is a 32x32 to 64 bit 'mul_epu32' plus the partial
+ * limb and the carry, which cannot overflow 64 bits.
+ */
+template<std::size_t BITS, std::size_t LANES>
+inline void multiply_avx2(__m256i* r, const bigint_batch<BITS, LANES>& a, const bigint_batch<BITS, LANES>& b, std::size_t lane) {
+    constexpr std::size_t n = bigint_batch<BITS, LANES>::count;
+    const __m256i low = _mm256_set1_epi64x(0xFFFFFFFF);
+    __m256i ai[n] = {};
+    for (std::size_t i = 0; i < n; ++i) {
+        ai[i] = load_wide_avx2(&a.limbs[i][lane]);
+        r[i] = _mm256_setzero_si256();
+    }
+    for (std::size_t j = 0; j < n; ++j) {
+        const __m256i bj = load_wide_avx2(&b.limbs[j][lane]);
+        __m256i carry = _mm256_setzero_si256();
+        for (std::size_t i = 0; i < n; ++i) {
+            const __m256i x = _mm256_add_epi64(_mm256_add_epi64(_mm256_mul_epu32(ai[i], bj), r[i + j]), carry);
+            r[i + j] = _mm256_and_si256(x, low);
+            carry = _mm256_srli_epi64(x, 32);
+        }
+        r[j + n] = carry;
+    }
+}
+
+/*
+ * redc_avx2 (Montgomery reduction of four lanes, 'redc' step for step)
+ */
+template<std::size_t BITS>
+inline void redc_avx2(__m256i* out, __m256i* t, const montgomery<BITS, std::uint32_t>& m) {
+    constexpr std::size_t n = montgomery<BITS, std::uint32_t>::count;
+    const __m256i low = _mm256_set1_epi64x(0xFFFFFFFF);
+    const __m256i inverse = _mm256_set1_epi64x(m.inverse);
+    __m256i over = _mm256_setzero_si256();
+    for (std::size_t i = 0; i < n; ++i) {
+        const __m256i factor = _mm256_and_si256(_mm256_mul_epu32(t[i], inverse), low);
+        __m256i carry = _mm256_setzero_si256();
+        for (std::size_t j = 0; j < n; ++j) {
+            const __m256i nj = _mm256_set1_epi64x(m.modulus[j]);
+            const __m256i x = _mm256_add_epi64(_mm256_add_epi64(_mm256_mul_epu32(factor, nj), t[i + j]), carry);
+            t[i + j] = _mm256_and_si256(x, low);
+            carry = _mm256_srli_epi64(x, 32);
+        }
+        const __m256i x = _mm256_add_epi64(_mm256_add_epi64(t[i + n], carry), over);
+        t[i + n] = _mm256_and_si256(x, low);
+        over = _mm256_srli_epi64(x, 32);
+    }
+    __m256i borrow = _mm256_setzero_si256();
+    for (std::size_t j = 0; j < n; ++j) {
+        const __m256i x = _mm256_sub_epi64(_mm256_sub_epi64(t[n + j], _mm256_set1_epi64x(m.modulus[j])), borrow);
+        out[j] = _mm256_and_si256(x, low);
+        borrow = _mm256_srli_epi64(x, 63);
+    }
+    const __m256i keep = _mm256_cmpgt_epi64(borrow, over);
+    for (std::size_t j = 0; j < n; ++j) {
+        out[j] = _mm256_blendv_epi8(out[j], t[n + j], keep);
+    }
+}
+#endif
+
+} //namespace impl
+
+/*
+ * add (Lane-wise, modulo 2^BITS like 'add_in_place')
+ *
+ * With AVX2, eight lanes per step: a carry out of a limb is an unsigned
+ * 'sum < a', found with 'max_epu32', and is kept as an all-ones mask that
+ * the next limb subtracts to add one.
+ */
+template<std::size_t BITS, std::size_t LANES>
+constexpr auto add(const bigint_batch<BITS, LANES>& a, const bigint_batch<BITS, LANES>& b) {
+    constexpr std::size_t n = bigint_batch<BITS, LANES>::count;
+    bigint_batch<BITS, LANES> out = {};
+    std::size_t lane = 0;
+#if defined(__AVX2__)
+    if (!__builtin_is_constant_evaluated()) {
+        const __m256i ones = _mm256_set1_epi32(-1);
+        for (; lane + 8 <= LANES; lane += 8) {
+            __m256i carry = _mm256_setzero_si256();
+            for (std::size_t i = 0; i < n; ++i) {
+                const __m256i ai = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(&a.limbs[i][lane]));
+                const __m256i bi = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(&b.limbs[i][lane]));
+                const __m256i sum = _mm256_add_epi32(ai, bi);
+                const __m256i wrapped = _mm256_xor_si256(_mm256_cmpeq_epi32(_mm256_max_epu32(ai, sum), sum), ones);
+                const __m256i total = _mm256_sub_epi32(sum, carry);
+                carry = _mm256_or_si256(wrapped, _mm256_and_si256(carry, _mm256_cmpeq_epi32(total, _mm256_setzero_si256())));
+                _mm256_storeu_si256(reinterpret_cast<__m256i*>(&out.limbs[i][lane]), total);
+            }
+            const __m256i top = _mm256_set1_epi32(static_cast<int>(impl::batch_top_mask<BITS>::value));
+            __m256i* const last = reinterpret_cast<__m256i*>(&out.limbs[n - 1][lane]);
+            _mm256_storeu_si256(last, _mm256_and_si256(_mm256_loadu_si256(last), top));
+        }
+    }
+#endif
+    for (; lane < LANES; ++lane) {
+        std::array<std::uint32_t, n> x = {};
+        std::array<std::uint32_t, n> y = {};
+        impl::gather_lane(a, lane, x.data(), n);
+        impl::gather_lane(b, lane, y.data(), n);
+        mpn::add_n(x.data(), x.data(), y.data(), n);
+        impl::scatter_lane(out, lane, x.data());
+    }
+    return out;
+}
+
+/*
+ * subtract (Lane-wise, modulo 2^BITS like 'subtract_in_place')
+ */
+template<std::size_t BITS, std::size_t LANES>
+constexpr auto subtract(const bigint_batch<BITS, LANES>& a, const bigint_batch<BITS, LANES>& b) {
+    constexpr std::size_t n = bigint_batch<BITS, LANES>::count;
+    bigint_batch<BITS, LANES> out = {};
+    std::size_t lane = 0;
+#if defined(__AVX2__)
+    if (!__builtin_is_constant_evaluated()) {
+        const __m256i ones = _mm256_set1_epi32(-1);
+        for (; lane + 8 <= LANES; lane += 8) {
+            __m256i borrow = _mm256_setzero_si256();
+            for (std::size_t i = 0; i < n; ++i) {
+                const __m256i ai = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(&a.limbs[i][lane]));
+                const __m256i bi = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(&b.limbs[i][lane]));
+                const __m256i difference = _mm256_sub_epi32(ai, bi);
+                const __m256i wrapped = _mm256_xor_si256(_mm256_cmpeq_epi32(_mm256_max_epu32(ai, bi), ai), ones);
+                const __m256i total = _mm256_add_epi32(difference, borrow);
+                borrow = _mm256_or_si256(wrapped, _mm256_and_si256(borrow, _mm256_cmpeq_epi32(difference, _mm256_setzero_si256())));
+                _mm256_storeu_si256(reinterpret_cast<__m256i*>(&out.limbs[i][lane]), total);
+            }
+            const __m256i top = _mm256_set1_epi32(static_cast<int>(impl::batch_top_mask<BITS>::value));
+            __m256i* const last = reinterpret_cast<__m256i*>(&out.limbs[n - 1][lane]);
+            _mm256_storeu_si256(last, _mm256_and_si256(_mm256_loadu_si256(last), top));
+        }
+    }
+#endif
+    for (; lane < LANES; ++lane) {
+        std::array<std::uint32_t, n> x = {};
+        std::array<std::uint32_t, n> y = {};
+        impl::gather_lane(a, lane, x.data(), n);
+        impl::gather_lane(b, lane, y.data(), n);
+        mpn::sub_n(x.data(), x.data(), y.data(), n);
+        impl::scatter_lane(out, lane, x.data());
+    }
+    return out;
+}
+
+/*
+ * multiply (Lane-wise full product, like 'multiply')
+ *
+ * With AVX2, four lanes per step in 64 bit accumulators.
+ */
+template<std::size_t BITS, std::size_t LANES>
+constexpr auto multiply(const bigint_batch<BITS, LANES>& a, const bigint_batch<BITS, LANES>& b) {
+    constexpr std::size_t n = bigint_batch<BITS, LANES>::count;
+    bigint_batch<2 * BITS, LANES> out = {};
+    std::size_t lane = 0;
+#if defined(__AVX2__)
+    if (!__builtin_is_constant_evaluated()) {
+        for (; lane + 4 <= LANES; lane += 4) {
+            __m256i r[2 * n] = {};
+            impl::multiply_avx2(r, a, b, lane);
+            for (std::size_t k = 0; k < out.count; ++k) {
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(&out.limbs[k][lane]), impl::low_limbs_avx2(r[k]));
+            }
+        }
+    }
+#endif
+    for (; lane < LANES; ++lane) {
+        std::array<std::uint32_t, n> x = {};
+        std::array<std::uint32_t, n> y = {};
+        std::array<std::uint32_t, 2 * n> r = {};
+        impl::gather_lane(a, lane, x.data(), n);
+        impl::gather_lane(b, lane, y.data(), n);
+        mpn::mul(r.data(), x.data(), n, y.data(), n);
+        for (std::size_t k = 0; k < out.count; ++k) {
+            out.limbs[k][lane] = r[k];
+        }
+    }
+    return out;
+}
+
+/*
+ * montgomery_reduce (Lane-wise t / R mod modulus, like 'montgomery_reduce')
+ */
+template<std::size_t BITS, std::size_t T_BITS, std::size_t LANES>
+constexpr auto montgomery_reduce(const montgomery<BITS, std::uint32_t>& m, const bigint_batch<T_BITS, LANES>& t) {
+    constexpr std::size_t n = montgomery<BITS, std::uint32_t>::count;
+    bigint_batch<BITS, LANES> out = {};
+    std::size_t lane = 0;
+#if defined(__AVX2__)
+    if (!__builtin_is_constant_evaluated()) {
+        for (; lane + 4 <= LANES; lane += 4) {
+            __m256i wide[2 * n] = {};
+            for (std::size_t k = 0; k < 2 * n; ++k) {
+                wide[k] = k < t.count ? impl::load_wide_avx2(&t.limbs[k][lane]) : _mm256_setzero_si256();
+            }
+            __m256i r[n] = {};
+            impl::redc_avx2(r, wide, m);
+            for (std::size_t k = 0; k < n; ++k) {
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(&out.limbs[k][lane]), impl::low_limbs_avx2(r[k]));
+            }
+        }
+    }
+#endif
+    for (; lane < LANES; ++lane) {
+        std::array<std::uint32_t, 2 * n> wide = {};
+        std::array<std::uint32_t, n> r = {};
+        impl::gather_lane(t, lane, wide.data(), 2 * n);
+        impl::redc(r.data(), wide.data(), m.modulus.data(), n, m.inverse);
+        for (std::size_t k = 0; k < n; ++k) {
+            out.limbs[k][lane] = r[k];
+        }
+    }
+    return out;
+}
+
+/*
+ * montgomery_multiply (Lane-wise a * b / R mod modulus)
+ */
+template<std::size_t BITS, std::size_t LANES>
+constexpr auto montgomery_multiply(const montgomery<BITS, std::uint32_t>& m, const bigint_batch<BITS, LANES>& a, const bigint_batch<BITS, LANES>& b) {
+    constexpr std::size_t n = montgomery<BITS, std::uint32_t>::count;
+    bigint_batch<BITS, LANES> out = {};
+    std::size_t lane = 0;
+#if defined(__AVX2__)
+    if (!__builtin_is_constant_evaluated()) {
+        for (; lane + 4 <= LANES; lane += 4) {
+            __m256i wide[2 * n] = {};
+            impl::multiply_avx2(wide, a, b, lane);
+            __m256i r[n] = {};
+            impl::redc_avx2(r, wide, m);
+            for (std::size_t k = 0; k < n; ++k) {
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(&out.limbs[k][lane]), impl::low_limbs_avx2(r[k]));
+            }
+        }
+    }
+#endif
+    for (; lane < LANES; ++lane) {
+        std::array<std::uint32_t, n> x = {};
+        std::array<std::uint32_t, n> y = {};
+        std::array<std::uint32_t, 2 * n> wide = {};
+        std::array<std::uint32_t, n> r = {};
+        impl::gather_lane(a, lane, x.data(), n);
+        impl::gather_lane(b, lane, y.data(), n);
+        mpn::mul(wide.data(), x.data(), n, y.data(), n);
+        impl::redc(r.data(), wide.data(), m.modulus.data(), n, m.inverse);
+        for (std::size_t k = 0; k < n; ++k) {
+            out.limbs[k][lane] = r[k];
+        }
+    }
+    return out;
+}
+
+} //namespace ftl
+
+/*
+ * add & subtract
+ */
+static_assert([] {
+    ftl::bigint_batch<40, 3> a = {};
+    ftl::bigint_batch<40, 3> b = {};
+    a.set(0, { 0xFFFFFFFF, 0x01 });
+    b.set(0, { 1, 0 });
+    a.set(1, { 0xFFFFFFFF, 0xFF });
+    b.set(1, { 1, 0 });
+    b.set(2, { 1, 0 });
+    const auto sum = ftl::add(a, b);
+    const auto difference = ftl::subtract(a, b);
+    return sum.get(0) == ftl::bigint<40>{ 0, 2 } && sum.get(1) == ftl::bigint<40>{ 0, 0 }
+        && difference.get(0) == ftl::bigint<40>{ 0xFFFFFFFE, 1 } && difference.get(2) == ftl::bigint<40>{ 0xFFFFFFFF, 0xFF };
+}());
+
+/*
+ * multiply
+ */
+static_assert([] {
+    ftl::bigint_batch<64, 2> a = {};
+    a.set(0, { 0xFFFFFFFF, 0xFFFFFFFF });
+    a.set(1, { 3, 0 });
+    const auto product = ftl::multiply(a, a);
+    return product.get(0) == ftl::bigint<128>{ 1, 0, 0xFFFFFFFE, 0xFFFFFFFF } && product.get(1) == ftl::bigint<128>{ 9 };
+}());
+
+/*
+ * montgomery_multiply & montgomery_reduce
+ */
+static_assert([] {
+    constexpr ftl::montgomery<61> m(ftl::bigint<61>{ 0xFFFFFFFF, 0x1FFFFFFF });
+    ftl::bigint_batch<61, 2> a = {};
+    ftl::bigint_batch<61, 2> b = {};
+    a.set(0, ftl::to_montgomery(m, ftl::bigint<61>{ 1000003 }));
+    b.set(0, ftl::to_montgomery(m, ftl::bigint<61>{ 999983 }));
+    a.set(1, ftl::bigint<61>{ 5 });
+    b.set(1, ftl::bigint<61>{ 7 });
+    const auto product = ftl::montgomery_multiply(m, a, b);
+    const auto plain = ftl::montgomery_reduce(m, ftl::multiply(a, b));
+    return ftl::from_montgomery(m, product.get(0)) == ftl::bigint<61>{ 0xD3CF704D, 0xE8 }
+        && product.get(1) == plain.get(1);
+}());
+
+#endif//FTL_BIGINT_BATCH_HH
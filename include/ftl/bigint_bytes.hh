@@ -0,0 +1,171 @@
+#ifndef FTL_BIGINT_BYTES_HH
+#define FTL_BIGINT_BYTES_HH
+
+#include <ftl/bigint_base.hh>
+#include <ftl/endian.hh>
+#include <ftl/span.hh>
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+namespace ftl {
+namespace impl {
+
+/*
+ * reverse_bytes (out[k] = in[size - 1 - k])
+ */
+inline void reverse_bytes(const std::byte* in, std::size_t size, std::byte* out) {
+#if defined(__AVX2__)
+    const __m256i reverse = _mm256_setr_epi8(
+        15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1, 0,
+        15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1, 0);
+    for (; size >= 32; size -= 32, out += 32) {
+        const __m256i block = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(in + size - 32));
+        const __m256i reversed = _mm256_permute4x64_epi64(_mm256_shuffle_epi8(block, reverse), 0x4E);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(out), reversed);
+    }
+#endif
+    for (; size >= 8; size -= 8, out += 8) {
+        std::uint64_t word = 0;
+        std::memcpy(&word, in + size - 8, 8);
+        word = __builtin_bswap64(word);
+        std::memcpy(out, &word, 8);
+    }
+    while (size > 0) {
+        *out++ = in[--size];
+    }
+}
+
+} //namespace impl
+
+/*
+ * from_bytes
+ *
+ * Reads an unsigned byte string in the given order. Shorter strings are
+ * zero extended; longer ones are truncated to the low BITS bits, as with
+ * 'resize'. At runtime on a little-endian host the limbs are filled with a
+ * single copy, or a vectorized byte reversal for big-endian input.
+ */
+template<endian ENDIAN, std::size_t BITS = impl::default_bits<std::size_t>::value, typename T = std::uint32_t>
+constexpr bigint<BITS, T> from_bytes(span<const std::byte> bytes) {
+    static_assert(ENDIAN == endian::little || ENDIAN == endian::big, "mixed endian is unsupported");
+    std::array<T, impl::required_elements<T, BITS>::value> limbs = {};
+    const std::size_t size = std::min(bytes.size(), limbs.size() * sizeof(T));
+    const std::byte* const low = ENDIAN == endian::little ? bytes.data() : bytes.data() + bytes.size() - size;
+
+    if (__builtin_is_constant_evaluated() || endian::native != endian::little) {
+        for (std::size_t k = 0; k < size; ++k) {
+            const std::byte byte = ENDIAN == endian::little ? low[k] : low[size - 1 - k];
+            limbs[k / sizeof(T)] |= static_cast<T>(std::to_integer<T>(byte) << (8 * (k % sizeof(T))));
+        }
+    } else if (ENDIAN == endian::little) {
+        std::memcpy(limbs.data(), low, size);
+    } else {
+        impl::reverse_bytes(low, size, reinterpret_cast<std::byte*>(limbs.data()));
+    }
+    impl::mask_top_limb<BITS>(limbs);
+    return bigint<BITS, T>{ limbs };
+}
+
+/*
+ * to_bytes
+ *
+ * Fills all of 'out' in the given order: the value is zero padded, or its
+ * high bytes dropped if 'out' is too short, in which case false is
+ * returned unless every dropped byte was zero.
+ */
+template<endian ENDIAN, std::size_t BITS, typename T>
+constexpr bool to_bytes(const bigint<BITS, T>& value, span<std::byte> out) {
+    static_assert(ENDIAN == endian::little || ENDIAN == endian::big, "mixed endian is unsupported");
+    constexpr std::size_t capacity = impl::required_elements<T, BITS>::value * sizeof(T);
+    const std::size_t size = std::min(out.size(), capacity);
+    std::byte* const low = ENDIAN == endian::little ? out.data() : out.data() + out.size() - size;
+    std::byte* const padding = ENDIAN == endian::little ? out.data() + size : out.data();
+
+    if (__builtin_is_constant_evaluated() || endian::native != endian::little) {
+        for (std::size_t k = 0; k < size; ++k) {
+            const auto byte = static_cast<std::byte>(value[k / sizeof(T)] >> (8 * (k % sizeof(T))));
+            (ENDIAN == endian::little ? low[k] : low[size - 1 - k]) = byte;
+        }
+        for (std::size_t k = 0; k < out.size() - size; ++k) {
+            padding[k] = std::byte{ 0 };
+        }
+    } else {
+        const auto* image = reinterpret_cast<const std::byte*>(value.data());
+        if (ENDIAN == endian::little) {
+            std::memcpy(low, image, size);
+        } else {
+            impl::reverse_bytes(image, size, low);
+        }
+        std::memset(padding, 0, out.size() - size);
+    }
+
+    for (std::size_t k = size; k < capacity; ++k) {
+        if (static_cast<std::uint8_t>(value[k / sizeof(T)] >> (8 * (k % sizeof(T)))) != 0) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/*
+ * as_bytes (Limbs viewed in place, little endian on little-endian hosts)
+ */
+template<std::size_t BITS, typename T>
+span<const std::byte> as_bytes(const bigint<BITS, T>& value) {
+    return { reinterpret_cast<const std::byte*>(value.data()), value.size() * sizeof(T) };
+}
+
+}//namespace ftl
+
+/*
+ * from_bytes
+ */
+static_assert([] {
+    const std::array<std::byte, 5> bytes = { std::byte{ 0x01 }, std::byte{ 0x02 }, std::byte{ 0x03 }, std::byte{ 0x04 }, std::byte{ 0x05 } };
+    const auto big = ftl::from_bytes<ftl::endian::big, 64, std::uint32_t>(bytes);
+    const auto little = ftl::from_bytes<ftl::endian::little, 64, std::uint16_t>(bytes);
+    const auto narrow = ftl::from_bytes<ftl::endian::big, 12, std::uint8_t>(bytes);
+    return big[0] == 0x02030405 && big[1] == 0x01
+        && little[0] == 0x0201 && little[1] == 0x0403 && little[2] == 0x05 && little[3] == 0
+        && narrow[0] == 0x05 && narrow[1] == 0x04;
+}());
+#if defined(__SIZEOF_INT128__)
+static_assert([] {
+    const std::array<std::byte, 9> bytes = { std::byte{ 0xFF }, std::byte{ 1 }, std::byte{ 2 }, std::byte{ 3 }, std::byte{ 4 },
+        std::byte{ 5 }, std::byte{ 6 }, std::byte{ 7 }, std::byte{ 8 } };
+    const auto value = ftl::from_bytes<ftl::endian::big, 128, std::uint64_t>(bytes);
+    return value[0] == 0x0102030405060708 && value[1] == 0xFF && value.highest_bit() == 72;
+}());
+#endif
+
+/*
+ * to_bytes
+ */
+static_assert([] {
+    std::array<std::byte, 6> bytes = {};
+    const bool fits = ftl::to_bytes<ftl::endian::big>(ftl::bigint<32, std::uint16_t>{ 0x0304, 0x0102 }, bytes);
+    return fits && bytes[0] == std::byte{ 0 } && bytes[1] == std::byte{ 0 }
+        && bytes[2] == std::byte{ 1 } && bytes[5] == std::byte{ 4 };
+}());
+static_assert([] {
+    std::array<std::byte, 3> bytes = {};
+    const bool fits = ftl::to_bytes<ftl::endian::little>(ftl::bigint<64, std::uint32_t>{ 0x04030201, 0 }, bytes);
+    const bool dropped = ftl::to_bytes<ftl::endian::little>(ftl::bigint<64, std::uint32_t>{ 0, 1 }, bytes);
+    return !fits && !dropped && bytes[0] == std::byte{ 0 };
+}());
+static_assert([] {
+    std::array<std::byte, 4> bytes = {};
+    const bool fits = ftl::to_bytes<ftl::endian::little>(ftl::bigint<64, std::uint32_t>{ 0x04030201, 0 }, bytes);
+    return fits && bytes[0] == std::byte{ 1 } && bytes[3] == std::byte{ 4 };
+}());
+
+#endif//FTL_BIGINT_BYTES_HH
@@ -0,0 +1,444 @@
+#ifndef FTL_BIGINT_DYN_HH
+#define FTL_BIGINT_DYN_HH
+
+#include <ftl/bigint_base.hh>
+#include <ftl/bigint_parallel.hh>
+#include <ftl/bigint_view.hh>
+#include <ftl/charconv.hh>
+#include <ftl/mpn.hh>
+#include <ftl/radix.hh>
+#include <ftl/scratch.hh>
+
+#include <algorithm>
+#include <charconv>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <system_error>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace ftl {
+
+/*
+ * bigint_dyn (Runtime sized bigint)
+ *
+ * The same unsigned value and little-endian limbs as 'bigint', with as
+ * many limbs as the value needs: the size is kept normalized, so zero has
+ * no limbs. Up to 'inline_limbs' limbs are stored in the object itself
+ * and only larger values go to the heap. A move hands the heap block
+ * over, so a value that fits inline never allocates and a larger one only
+ * when it is copied or grows.
+ */
+template<typename T = std::uint32_t>
+class bigint_dyn {
+public:
+    using value_type = T;
+
+    static constexpr std::size_t inline_limbs = 4;
+
+    bigint_dyn() noexcept {}
+
+    explicit bigint_dyn(T value) noexcept {
+        local_[0] = value;
+        size_ = value == zero<T>::value ? 0 : 1;
+    }
+
+    explicit bigint_dyn(bigint_view<T> value) {
+        assign(value.data(), value.size());
+    }
+
+    template<std::size_t BITS>
+    explicit bigint_dyn(const bigint<BITS, T>& value) :
+        bigint_dyn(bigint_view<T>(value))
+    {}
+
+    bigint_dyn(const bigint_dyn& other) {
+        assign(other.data(), other.size());
+    }
+
+    bigint_dyn(bigint_dyn&& other) noexcept {
+        take(other);
+    }
+
+    bigint_dyn& operator=(const bigint_dyn& other) {
+        if (this != &other) {
+            assign(other.data(), other.size());
+        }
+        return *this;
+    }
+
+    bigint_dyn& operator=(bigint_dyn&& other) noexcept {
+        if (this != &other) {
+            release();
+            take(other);
+        }
+        return *this;
+    }
+
+    ~bigint_dyn() {
+        release();
+    }
+
+    T* data() { return on_heap() ? heap_ : local_; }
+    const T* data() const { return on_heap() ? heap_ : local_; }
+    std::size_t size() const { return size_; }
+    std::size_t capacity() const { return capacity_; }
+    T& operator[](std::size_t i) { return data()[i]; }
+    const T& operator[](std::size_t i) const { return data()[i]; }
+    T* begin() { return data(); }
+    T* end() { return data() + size_; }
+    const T* begin() const { return data(); }
+    const T* end() const { return data() + size_; }
+
+    operator bigint_view<T>() const {
+        return { data(), size_ };
+    }
+
+    std::size_t highest_bit() const {
+        return bigint_view<T>(*this).highest_bit();
+    }
+
+    /*
+     * assign (Copy of 'count' limbs, which must not be this value's own)
+     */
+    void assign(const T* limbs, std::size_t count) {
+        count = mpn::normalized_size(limbs, count);
+        size_ = 0;
+        reserve(count);
+        std::copy(limbs, limbs + count, data());
+        size_ = count;
+    }
+
+    /*
+     * resize (Limb count for kernels writing the limbs directly)
+     *
+     * Added limbs are zero; 'normalize' restores the invariant afterwards.
+     */
+    void resize(std::size_t count) {
+        reserve(count);
+        if (count > size_) {
+            std::fill(data() + size_, data() + count, zero<T>::value);
+        }
+        size_ = count;
+    }
+
+    /*
+     * reserve (At least doubles, so repeated growth is amortized)
+     */
+    void reserve(std::size_t count) {
+        if (count <= capacity_) {
+            return;
+        }
+        const std::size_t capacity = std::max(count, 2 * capacity_);
+        T* const heap = new T[capacity];
+        std::copy(data(), data() + size_, heap);
+        release();
+        heap_ = heap;
+        capacity_ = capacity;
+    }
+
+    void normalize() {
+        size_ = mpn::normalized_size(data(), size_);
+    }
+
+private:
+    bool on_heap() const {
+        return capacity_ > inline_limbs;
+    }
+
+    void release() {
+        if (on_heap()) {
+            delete[] heap_;
+            capacity_ = inline_limbs;
+        }
+    }
+
+    void take(bigint_dyn& other) noexcept {
+        if (other.on_heap()) {
+            heap_ = other.heap_;
+        } else {
+            std::copy(other.local_, other.local_ + other.size_, local_);
+        }
+        size_ = std::exchange(other.size_, 0);
+        capacity_ = std::exchange(other.capacity_, inline_limbs);
+    }
+
+    union {
+        T local_[inline_limbs];
+        T* heap_;
+    };
+    std::size_t size_ = 0;
+    std::size_t capacity_ = inline_limbs;
+};
+
+/*
+ * resize (Copy a bigint_dyn into a bigint, zero extended or truncated)
+ */
+template<std::size_t BITS, typename T>
+auto resize(const bigint_dyn<T>& value) {
+    return resize<BITS>(bigint_view<T>(value));
+}
+
+/*
+ * compare (-1, 0 or 1)
+ */
+template<typename T>
+int compare(const bigint_dyn<T>& a, const bigint_dyn<T>& b) {
+    if (a.size() != b.size()) {
+        return a.size() < b.size() ? -1 : 1;
+    }
+    return mpn::cmp(a.data(), b.data(), a.size());
+}
+
+template<typename T>
+bool operator==(const bigint_dyn<T>& a, const bigint_dyn<T>& b) { return compare(a, b) == 0; }
+
+template<typename T>
+bool operator!=(const bigint_dyn<T>& a, const bigint_dyn<T>& b) { return compare(a, b) != 0; }
+
+template<typename T>
+bool operator<(const bigint_dyn<T>& a, const bigint_dyn<T>& b) { return compare(a, b) < 0; }
+
+template<typename T>
+bool operator<=(const bigint_dyn<T>& a, const bigint_dyn<T>& b) { return compare(a, b) <= 0; }
+
+template<typename T>
+bool operator>(const bigint_dyn<T>& a, const bigint_dyn<T>& b) { return compare(a, b) > 0; }
+
+template<typename T>
+bool operator>=(const bigint_dyn<T>& a, const bigint_dyn<T>& b) { return compare(a, b) >= 0; }
+
+/*
+ * '+=' and '+'
+ */
+template<typename T>
+bigint_dyn<T>& operator+=(bigint_dyn<T>& a, const bigint_dyn<T>& b) {
+    const std::size_t n = std::max(a.size(), b.size()) + 1;
+    a.resize(n);
+    mpn::add(a.data(), a.data(), n, b.data(), b.size());
+    a.normalize();
+    return a;
+}
+
+template<typename T>
+bigint_dyn<T> operator+(bigint_dyn<T> a, const bigint_dyn<T>& b) {
+    a += b;
+    return a;
+}
+
+/*
+ * '-=' and '-' ('b' must not exceed 'a')
+ */
+template<typename T>
+bigint_dyn<T>& operator-=(bigint_dyn<T>& a, const bigint_dyn<T>& b) {
+    mpn::sub(a.data(), a.data(), a.size(), b.data(), b.size());
+    a.normalize();
+    return a;
+}
+
+template<typename T>
+bigint_dyn<T> operator-(bigint_dyn<T> a, const bigint_dyn<T>& b) {
+    a -= b;
+    return a;
+}
+
+/*
+ * '*' and '*='
+ */
+template<typename T>
+bigint_dyn<T> operator*(const bigint_dyn<T>& a, const bigint_dyn<T>& b) {
+    bigint_dyn<T> product;
+    if (a.size() == 0 || b.size() == 0) {
+        return product;
+    }
+    product.resize(a.size() + b.size());
+    if (a.size() >= b.size()) {
+        mpn::mul(product.data(), a.data(), a.size(), b.data(), b.size());
+    } else {
+        mpn::mul(product.data(), b.data(), b.size(), a.data(), a.size());
+    }
+    product.normalize();
+    return product;
+}
+
+template<typename T>
+bigint_dyn<T>& operator*=(bigint_dyn<T>& a, const bigint_dyn<T>& b) {
+    a = a * b;
+    return a;
+}
+
+/*
+ * divmod (A zero divisor gives a zero quotient and remainder, as for 'bigint')
+ *
+ * The normalized operands live in 'thread_scratch'.
+ */
+template<typename T>
+std::pair<bigint_dyn<T>, bigint_dyn<T>> divmod(const bigint_dyn<T>& a, const bigint_dyn<T>& b) {
+    if (b.size() == 0) {
+        return {};
+    }
+    if (a.size() < b.size()) {
+        return { bigint_dyn<T>(), a };
+    }
+    bigint_dyn<T> quotient;
+    bigint_dyn<T> remainder;
+    quotient.resize(a.size() - b.size() + 1);
+    remainder.resize(b.size());
+    scratch_buffer<T> scratch(a.size() + b.size() + 1);
+    mpn::divrem(quotient.data(), remainder.data(), a.data(), a.size(), b.data(), b.size(), scratch.data());
+    quotient.normalize();
+    remainder.normalize();
+    return { std::move(quotient), std::move(remainder) };
+}
+
+/*
+ * '/', '%', '/=' and '%='
+ */
+template<typename T>
+bigint_dyn<T> operator/(const bigint_dyn<T>& a, const bigint_dyn<T>& b) {
+    return divmod(a, b).first;
+}
+
+template<typename T>
+bigint_dyn<T> operator%(const bigint_dyn<T>& a, const bigint_dyn<T>& b) {
+    return divmod(a, b).second;
+}
+
+template<typename T>
+bigint_dyn<T>& operator/=(bigint_dyn<T>& a, const bigint_dyn<T>& b) {
+    a = divmod(a, b).first;
+    return a;
+}
+
+template<typename T>
+bigint_dyn<T>& operator%=(bigint_dyn<T>& a, const bigint_dyn<T>& b) {
+    a = divmod(a, b).second;
+    return a;
+}
+
+/*
+ * '<<=' and '<<'
+ */
+template<typename T>
+bigint_dyn<T>& operator<<=(bigint_dyn<T>& a, std::size_t shift) {
+    constexpr std::size_t digits = std::numeric_limits<T>::digits;
+    const std::size_t n = a.size();
+    const std::size_t limbs = shift / digits;
+    if (n == 0 || shift == 0) {
+        return a;
+    }
+    a.resize(n + limbs + 1);
+    T* const d = a.data();
+    if (shift % digits == 0) {
+        std::copy_backward(d, d + n, d + limbs + n);
+    } else {
+        d[n + limbs] = mpn::lshift(d + limbs, d, n, static_cast<unsigned>(shift % digits));
+    }
+    std::fill(d, d + limbs, zero<T>::value);
+    a.normalize();
+    return a;
+}
+
+template<typename T>
+bigint_dyn<T> operator<<(bigint_dyn<T> a, std::size_t shift) {
+    a <<= shift;
+    return a;
+}
+
+/*
+ * '>>=' and '>>'
+ */
+template<typename T>
+bigint_dyn<T>& operator>>=(bigint_dyn<T>& a, std::size_t shift) {
+    constexpr std::size_t digits = std::numeric_limits<T>::digits;
+    const std::size_t n = a.size();
+    const std::size_t limbs = shift / digits;
+    if (limbs >= n) {
+        a.resize(0);
+        return a;
+    }
+    T* const d = a.data();
+    if (shift % digits == 0) {
+        std::copy(d + limbs, d + n, d);
+    } else {
+        mpn::rshift(d, d + limbs, n - limbs, static_cast<unsigned>(shift % digits));
+    }
+    a.resize(n - limbs);
+    a.normalize();
+    return a;
+}
+
+template<typename T>
+bigint_dyn<T> operator>>(bigint_dyn<T> a, std::size_t shift) {
+    a >>= shift;
+    return a;
+}
+
+namespace impl {
+
+/*
+ * from_chars_dyn
+ *
+ * Long runs of digits take the divide-and-conquer split of
+ * 'from_chars_parallel' on one thread, short ones the chunked
+ * multiply-add.
+ */
+template<std::uint8_t RADIX, typename T>
+std::from_chars_result from_chars_dyn(const char* first, const char* last, bigint_dyn<T>& value) {
+    using chunk = radix_chunk<RADIX, T>;
+    const char* p = first;
+    while (p != last && is_digit<RADIX>(*p)) {
+        ++p;
+    }
+    if (p == first) {
+        return { first, std::errc::invalid_argument };
+    }
+    const std::size_t count = static_cast<std::size_t>(p - first);
+    std::vector<T> limbs;
+    if (radix_shift(RADIX) != 0 || count <= chunk::length * radix_base_limbs::value) {
+        limbs = limbs_serial<RADIX, T>(first, p);
+    } else {
+        const double bits = static_cast<double>(count) * std::log2(static_cast<double>(RADIX));
+        const std::size_t size = static_cast<std::size_t>(bits / std::numeric_limits<T>::digits) + 2;
+        limbs = limbs_parallel<RADIX, T>(first, p, radix_powers<RADIX, T>(size, 1), 1);
+    }
+    value.assign(limbs.data(), limbs.size());
+    return { p, std::errc{} };
+}
+
+} //namespace impl
+
+/*
+ * to_chars (bigint_dyn)
+ */
+template<typename T>
+std::to_chars_result to_chars(char* first, char* last, const bigint_dyn<T>& value, int radix = 10) {
+    return to_chars(first, last, bigint_view<T>(value), radix);
+}
+
+/*
+ * from_chars (bigint_dyn)
+ *
+ * As for 'bigint', except that every value fits.
+ */
+template<typename T>
+std::from_chars_result from_chars(const char* first, const char* last, bigint_dyn<T>& value, int radix = 10) {
+    return impl::with_radix(radix, std::from_chars_result{ first, std::errc::invalid_argument }, [&](auto r) {
+        return impl::from_chars_dyn<decltype(r)::value>(first, last, value);
+    });
+}
+
+}//namespace ftl
+
+/*
+ * bigint_dyn
+ */
+static_assert(std::is_nothrow_move_constructible<ftl::bigint_dyn<>>::value);
+static_assert(std::is_nothrow_move_assignable<ftl::bigint_dyn<>>::value);
+static_assert(sizeof(ftl::bigint_dyn<std::uint32_t>) == 4 * sizeof(std::uint32_t) + 2 * sizeof(std::size_t));
+static_assert(sizeof(ftl::bigint_dyn<std::uint64_t>) == 4 * sizeof(std::uint64_t) + 2 * sizeof(std::size_t));
+
+#endif//FTL_BIGINT_DYN_HH
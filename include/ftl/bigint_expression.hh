@@ -0,0 +1,397 @@
+#ifndef FTL_BIGINT_EXPRESSION_HH
+#define FTL_BIGINT_EXPRESSION_HH
+
+#include <ftl/bigint_arithmetic_addition.hh>
+#include <ftl/bigint_arithmetic_multiplication.hh>
+#include <ftl/bigint_arithmetic_subtraction.hh>
+#include <ftl/bigint_base.hh>
+#include <ftl/mpn.hh>
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+
+namespace ftl {
+
+/*
+ * bigint_expression (Deferred '+', '-' and '*' over bigints)
+ *
+ * 'lazy(a)' starts an expression; '+', '-' and '*' with another
+ * expression, a bigint or a limb extend it instead of computing. The
+ * width is taken from the whole tree, sums adding a bit and products the
+ * widths of both sides, and the tree is evaluated once, when converted to
+ * a bigint: every column of the result sums its leaf limbs and partial
+ * products into a single accumulator, so the whole expression has one
+ * carry chain and no temporaries. Operands of a product that are not
+ * leaves are evaluated on their own first.
+ *
+ * The result is the value modulo 2^bits, which is what the operators
+ * give whenever no difference inside the tree goes negative. Nodes refer
+ * to their bigint operands: convert before those go out of scope.
+ */
+template<typename E>
+struct bigint_expression {
+    template<std::size_t BITS, typename T>
+    constexpr operator bigint<BITS, T>() const;
+};
+
+namespace impl {
+
+/*
+ * expression_leaf (A bigint operand, by reference)
+ */
+template<std::size_t BITS, typename T>
+struct expression_leaf : bigint_expression<expression_leaf<BITS, T>> {
+    using limb_type = T;
+    static constexpr std::size_t bits = BITS;
+
+    constexpr explicit expression_leaf(const bigint<BITS, T>& value) :
+        value(value)
+    {}
+
+    constexpr const T* data() const { return value.data(); }
+    constexpr std::size_t size() const { return limbs; }
+
+    const bigint<BITS, T>& value;
+    std::size_t limbs = bigint<BITS, T>::count;
+};
+
+/*
+ * expression_value (An operand the expression owns: a limb or an evaluated subtree)
+ */
+template<std::size_t BITS, typename T>
+struct expression_value : bigint_expression<expression_value<BITS, T>> {
+    using limb_type = T;
+    static constexpr std::size_t bits = BITS;
+
+    constexpr explicit expression_value(const bigint<BITS, T>& value) :
+        value(value)
+    {}
+
+    constexpr const T* data() const { return value.data(); }
+    constexpr std::size_t size() const { return limbs; }
+
+    bigint<BITS, T> value;
+    std::size_t limbs = bigint<BITS, T>::count;
+};
+
+template<typename A, typename B>
+struct expression_sum : bigint_expression<expression_sum<A, B>> {
+    using limb_type = typename A::limb_type;
+    static constexpr std::size_t bits = std::max(A::bits, B::bits) + 1;
+
+    constexpr expression_sum(const A& a, const B& b) : a(a), b(b) {}
+
+    A a;
+    B b;
+};
+
+template<typename A, typename B>
+struct expression_difference : bigint_expression<expression_difference<A, B>> {
+    using limb_type = typename A::limb_type;
+    static constexpr std::size_t bits = std::max(A::bits, B::bits);
+
+    constexpr expression_difference(const A& a, const B& b) : a(a), b(b) {}
+
+    A a;
+    B b;
+};
+
+template<typename A, typename B>
+struct expression_product : bigint_expression<expression_product<A, B>> {
+    using limb_type = typename A::limb_type;
+    static constexpr std::size_t bits = A::bits + B::bits;
+
+    constexpr expression_product(const A& a, const B& b) : a(a), b(b) {}
+
+    A a;
+    B b;
+};
+
+template<typename E>
+struct is_expression_leaf : std::false_type {};
+
+template<std::size_t BITS, typename T>
+struct is_expression_leaf<expression_leaf<BITS, T>> : std::true_type {};
+
+template<std::size_t BITS, typename T>
+struct is_expression_leaf<expression_value<BITS, T>> : std::true_type {};
+
+/*
+ * expression_accumulator (Signed column sum: 'low' plus 'high' times 2^(2 * digits))
+ */
+template<typename T>
+struct expression_accumulator {
+    using W = mpn::impl::wide<T>;
+    static constexpr unsigned digits = std::numeric_limits<T>::digits;
+
+    constexpr void add(W x) {
+        low += x;
+        high += low < x;
+    }
+
+    constexpr void sub(W x) {
+        high -= low < x;
+        low -= x;
+    }
+
+    // The next result limb; the rest moves down one limb, rounding towards
+    // minus infinity so that a negative column borrows from the next
+    constexpr T shift() {
+        const T limb = static_cast<T>(low);
+        low = (low >> digits) | (static_cast<W>(static_cast<T>(high)) << digits);
+        if constexpr (digits >= 63) {
+            high = high < 0 ? -1 : 0;
+        } else {
+            high = high >= 0 ? high >> digits : ~(~high >> digits);
+        }
+        return limb;
+    }
+
+    W low = 0;
+    std::int64_t high = 0;
+};
+
+/*
+ * accumulate_product (Adds the partial products a[i] * b[k - i] of column k)
+ */
+template<typename T, typename A, typename B>
+constexpr void accumulate_product(expression_accumulator<T>& acc, const A& a, const B& b, std::size_t k, bool negate) {
+    using W = mpn::impl::wide<T>;
+    const std::size_t an = a.size();
+    const std::size_t bn = b.size();
+    if (an == 0 || bn == 0 || k > an + bn - 2) {
+        return;
+    }
+    const std::size_t first = k < bn ? 0 : k - (bn - 1);
+    const std::size_t last = std::min(k, an - 1);
+    for (std::size_t i = first; i <= last; ++i) {
+        const W product = static_cast<W>(a.data()[i]) * b.data()[k - i];
+        if (negate) {
+            acc.sub(product);
+        } else {
+            acc.add(product);
+        }
+    }
+}
+
+/*
+ * accumulate_column (Adds the tree's share of column k, negated under a difference)
+ */
+template<typename T, typename L>
+constexpr void accumulate_leaf(expression_accumulator<T>& acc, const L& leaf, std::size_t k, bool negate) {
+    if (k < leaf.size()) {
+        if (negate) {
+            acc.sub(leaf.data()[k]);
+        } else {
+            acc.add(leaf.data()[k]);
+        }
+    }
+}
+
+template<typename T, std::size_t BITS>
+constexpr void accumulate_column(expression_accumulator<T>& acc, const expression_leaf<BITS, T>& e, std::size_t k, bool negate) {
+    accumulate_leaf(acc, e, k, negate);
+}
+
+template<typename T, std::size_t BITS>
+constexpr void accumulate_column(expression_accumulator<T>& acc, const expression_value<BITS, T>& e, std::size_t k, bool negate) {
+    accumulate_leaf(acc, e, k, negate);
+}
+
+template<typename T, typename A, typename B>
+constexpr void accumulate_column(expression_accumulator<T>& acc, const expression_sum<A, B>& e, std::size_t k, bool negate) {
+    accumulate_column(acc, e.a, k, negate);
+    accumulate_column(acc, e.b, k, negate);
+}
+
+template<typename T, typename A, typename B>
+constexpr void accumulate_column(expression_accumulator<T>& acc, const expression_difference<A, B>& e, std::size_t k, bool negate) {
+    accumulate_column(acc, e.a, k, negate);
+    accumulate_column(acc, e.b, k, !negate);
+}
+
+template<typename T, typename A, typename B>
+constexpr void accumulate_column(expression_accumulator<T>& acc, const expression_product<A, B>& e, std::size_t k, bool negate) {
+    accumulate_product(acc, e.a, e.b, k, negate);
+}
+
+/*
+ * evaluate_limbs (The tree modulo 2^BITS)
+ */
+template<std::size_t BITS, typename E>
+constexpr auto evaluate_limbs(const E& e) {
+    using T = typename E::limb_type;
+    std::array<T, required_elements<T, BITS>::value> result = {};
+    expression_accumulator<T> acc;
+    for (std::size_t k = 0; k < result.size(); ++k) {
+        accumulate_column(acc, e, k, false);
+        result[k] = acc.shift();
+    }
+    mask_top_limb<BITS>(result);
+    return result;
+}
+
+/*
+ * prepare (The tree with the operands of every product reduced to leaves)
+ *
+ * Leaves also learn their significant limbs here, so columns past them
+ * cost nothing.
+ */
+template<typename E>
+constexpr auto prepare(const E& e);
+
+template<typename E>
+constexpr auto prepare_factor(const E& e) {
+    if constexpr (is_expression_leaf<E>::value) {
+        return prepare(e);
+    } else {
+        using T = typename E::limb_type;
+        return expression_value<E::bits, T>(bigint<E::bits, T>{ evaluate_limbs<E::bits>(prepare(e)) });
+    }
+}
+
+template<typename E>
+constexpr auto prepare(const E& e) {
+    if constexpr (is_expression_leaf<E>::value) {
+        E leaf = e;
+        leaf.limbs = mpn::normalized_size(e.value.data(), e.value.count);
+        return leaf;
+    } else if constexpr (std::is_same<E, expression_sum<decltype(e.a), decltype(e.b)>>::value) {
+        const auto a = prepare(e.a);
+        const auto b = prepare(e.b);
+        return expression_sum<std::remove_const_t<decltype(a)>, std::remove_const_t<decltype(b)>>(a, b);
+    } else if constexpr (std::is_same<E, expression_difference<decltype(e.a), decltype(e.b)>>::value) {
+        const auto a = prepare(e.a);
+        const auto b = prepare(e.b);
+        return expression_difference<std::remove_const_t<decltype(a)>, std::remove_const_t<decltype(b)>>(a, b);
+    } else {
+        const auto a = prepare_factor(e.a);
+        const auto b = prepare_factor(e.b);
+        return expression_product<std::remove_const_t<decltype(a)>, std::remove_const_t<decltype(b)>>(a, b);
+    }
+}
+
+/*
+ * as_expression (Operands of the expression operators)
+ */
+template<typename E>
+constexpr const E& as_expression(const bigint_expression<E>& e) {
+    return static_cast<const E&>(e);
+}
+
+template<std::size_t BITS, typename T>
+constexpr expression_leaf<BITS, T> as_expression(const bigint<BITS, T>& value) {
+    return expression_leaf<BITS, T>(value);
+}
+
+template<typename T, typename = std::enable_if_t<std::is_unsigned<T>::value>>
+constexpr expression_value<std::numeric_limits<T>::digits, T> as_expression(T value) {
+    return expression_value<std::numeric_limits<T>::digits, T>(bigint<std::numeric_limits<T>::digits, T>{ value });
+}
+
+template<typename A>
+using expression_node = std::remove_cv_t<std::remove_reference_t<decltype(as_expression(std::declval<const A&>()))>>;
+
+template<typename E>
+struct is_expression : std::is_base_of<bigint_expression<E>, E> {};
+
+/*
+ * expression_operands (At least one side is an expression, and the limbs agree)
+ */
+template<typename A, typename B, typename = void>
+struct expression_operands : std::false_type {};
+
+template<typename A, typename B>
+struct expression_operands<A, B, std::void_t<expression_node<A>, expression_node<B>>> :
+    std::integral_constant<bool, (is_expression<A>::value || is_expression<B>::value)
+        && std::is_same<typename expression_node<A>::limb_type, typename expression_node<B>::limb_type>::value> {};
+
+} //namespace impl
+
+/*
+ * lazy (A bigint as the leaf of an expression)
+ */
+template<std::size_t BITS, typename T>
+constexpr impl::expression_leaf<BITS, T> lazy(const bigint<BITS, T>& value) {
+    return impl::expression_leaf<BITS, T>(value);
+}
+
+/*
+ * evaluate (The expression at its full width)
+ */
+template<typename E>
+constexpr auto evaluate(const bigint_expression<E>& e) {
+    const E& tree = static_cast<const E&>(e);
+    return bigint<E::bits, typename E::limb_type>{ impl::evaluate_limbs<E::bits>(impl::prepare(tree)) };
+}
+
+/*
+ * Conversion (Evaluated modulo 2^min(BITS, width), then zero extended)
+ */
+template<typename E>
+template<std::size_t BITS, typename T>
+constexpr bigint_expression<E>::operator bigint<BITS, T>() const {
+    static_assert(std::is_same<T, typename E::limb_type>::value);
+    constexpr std::size_t WIDTH = std::min(BITS, E::bits);
+    const auto limbs = impl::evaluate_limbs<WIDTH>(impl::prepare(static_cast<const E&>(*this)));
+    bigint<BITS, T> result = {};
+    for (std::size_t i = 0; i < limbs.size(); ++i) {
+        result[i] = limbs[i];
+    }
+    return result;
+}
+
+/*
+ * '+', '-' and '*' (Expression Operators)
+ */
+template<typename A, typename B, typename = std::enable_if_t<impl::expression_operands<A, B>::value>>
+constexpr auto operator+(const A& a, const B& b) {
+    return impl::expression_sum<impl::expression_node<A>, impl::expression_node<B>>(impl::as_expression(a), impl::as_expression(b));
+}
+
+template<typename A, typename B, typename = std::enable_if_t<impl::expression_operands<A, B>::value>>
+constexpr auto operator-(const A& a, const B& b) {
+    return impl::expression_difference<impl::expression_node<A>, impl::expression_node<B>>(impl::as_expression(a), impl::as_expression(b));
+}
+
+template<typename A, typename B, typename = std::enable_if_t<impl::expression_operands<A, B>::value>>
+constexpr auto operator*(const A& a, const B& b) {
+    return impl::expression_product<impl::expression_node<A>, impl::expression_node<B>>(impl::as_expression(a), impl::as_expression(b));
+}
+
+} //namespace ftl
+
+/*
+ * bigint_expression
+ */
+static_assert(decltype(ftl::lazy(ftl::bigint<64, std::uint8_t>{}) * ftl::bigint<32, std::uint8_t>{}
+    + ftl::bigint<64, std::uint8_t>{})::bits == 97);
+static_assert([] {
+    const ftl::bigint<24, std::uint8_t> a = { 0xFF, 0xFF, 0xFF };
+    const ftl::bigint<16, std::uint8_t> b = { 0x34, 0x12 };
+    const ftl::bigint<16, std::uint8_t> c = { 0xFF, 0xFF };
+    const ftl::bigint<8, std::uint8_t> e = { 0x77 };
+    const auto fused = ftl::evaluate(ftl::lazy(a) * b + ftl::lazy(c) * c - e);
+    const auto eager = ftl::subtract_in_place(ftl::add(ftl::multiply(a, b), ftl::multiply(c, c)), e);
+    return fused == eager && fused.bits == eager.bits;
+}());
+static_assert([] {
+    // A non-leaf factor, a limb operand and a negative column
+    const ftl::bigint<32, std::uint8_t> a = { 1, 2, 3, 4 };
+    const ftl::bigint<32, std::uint8_t> b = { 0xFF, 0, 0, 0x80 };
+    const ftl::bigint<64, std::uint8_t> product = (ftl::lazy(a) + b) * a - ftl::lazy(b) * std::uint8_t{ 3 };
+    return product == ftl::subtract_in_place(ftl::multiply(ftl::add(a, b), a), ftl::multiply(b, ftl::bigint<8, std::uint8_t>{ 3 }));
+}());
+static_assert([] {
+    // Narrower targets truncate, and a negative result wraps at the tree's width
+    const ftl::bigint<64, std::uint32_t> a = { 0xFFFFFFFF, 0xFFFFFFFF };
+    const ftl::bigint<32, std::uint32_t> low = ftl::lazy(a) * a;
+    const ftl::bigint<96, std::uint32_t> wrapped = ftl::lazy(ftl::bigint<32, std::uint32_t>{ 1 }) - a;
+    return low == ftl::bigint<32, std::uint32_t>{ 1 } && wrapped == ftl::bigint<96, std::uint32_t>{ 2, 0, 0 };
+}());
+
+#endif//FTL_BIGINT_EXPRESSION_HH
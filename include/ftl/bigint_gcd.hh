@@ -0,0 +1,552 @@
+#ifndef FTL_BIGINT_GCD_HH
+#define FTL_BIGINT_GCD_HH
+
+#include <ftl/bigint_arithmetic_addition.hh>
+#include <ftl/bigint_arithmetic_division.hh>
+#include <ftl/bigint_arithmetic_multiplication.hh>
+#include <ftl/bigint_arithmetic_subtraction.hh>
+#include <ftl/bigint_base.hh>
+#include <ftl/bigint_dyn.hh>
+#include <ftl/mpn.hh>
+#include <ftl/scratch.hh>
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <utility>
+
+namespace ftl {
+namespace mpn {
+namespace impl {
+
+/*
+ * trailing_zeros (Of a non-zero limb)
+ */
+template<typename T>
+constexpr unsigned trailing_zeros(T x) {
+    return static_cast<unsigned>(__builtin_ctzll(x));
+}
+
+/*
+ * swap_values (std::swap is not constexpr before C++20)
+ */
+template<typename U>
+constexpr void swap_values(U& a, U& b) {
+    const U t = a;
+    a = b;
+    b = t;
+}
+
+/*
+ * gcd_1 (Binary GCD of two limbs)
+ */
+template<typename T>
+constexpr T gcd_1(T a, T b) {
+    if (a == 0 || b == 0) {
+        return static_cast<T>(a | b);
+    }
+    const unsigned shift = trailing_zeros(static_cast<T>(a | b));
+    a = static_cast<T>(a >> trailing_zeros(a));
+    while (b != 0) {
+        b = static_cast<T>(b >> trailing_zeros(b));
+        if (a > b) {
+            swap_values(a, b);
+        }
+        b = static_cast<T>(b - a);
+    }
+    return static_cast<T>(a << shift);
+}
+
+/*
+ * lehmer_matrix (Cofactor magnitudes after 'steps' quotients of the leading bits)
+ *
+ * (u0, v0) and (u1, v1) give the next pair: a' = |u0 a - v0 b| and
+ * b' = |u1 a - v1 b|, with signs alternating by the parity of 'steps'.
+ */
+template<typename T>
+struct lehmer_matrix {
+    T u0 = 1;
+    T v0 = 0;
+    T u1 = 0;
+    T v1 = 1;
+    std::size_t steps = 0;
+};
+
+/*
+ * lehmer (Euclid on the leading 2 * digits - 1 bits of a >= b)
+ *
+ * A quotient is taken only while Jebelean's condition holds for both
+ * cofactors, so the quotients are those of the full numbers, and only
+ * while the cofactors fit a limb.
+ */
+template<typename T>
+constexpr lehmer_matrix<T> lehmer(wide<T> r0, wide<T> r1) {
+    using W = wide<T>;
+    constexpr W limit = W{ 1 } << digits<T>::value;
+    lehmer_matrix<T> m;
+    W u0 = 1;
+    W v0 = 0;
+    W u1 = 0;
+    W v1 = 1;
+    while (r1 != 0) {
+        const W q = r0 / r1;
+        if (q >= limit) {
+            break;
+        }
+        const W r2 = r0 - q * r1;
+        const W u2 = u0 + q * u1;
+        const W v2 = v0 + q * v1;
+        if (u2 >= limit || v2 >= limit
+            || r2 < std::max(u2, v2) || r1 - r2 < std::max(u2 + u1, v2 + v1)) {
+            break;
+        }
+        r0 = r1;
+        r1 = r2;
+        u0 = u1;
+        u1 = u2;
+        v0 = v1;
+        v1 = v2;
+        ++m.steps;
+    }
+    m.u0 = static_cast<T>(u0);
+    m.v0 = static_cast<T>(v0);
+    m.u1 = static_cast<T>(u1);
+    m.v1 = static_cast<T>(v1);
+    return m;
+}
+
+/*
+ * leading_bits (Bits [shift, shift + 2 * digits - 1) of an n limb value)
+ */
+template<typename T>
+constexpr wide<T> leading_bits(const T* a, std::size_t n, std::size_t shift) {
+    using W = wide<T>;
+    constexpr unsigned d = digits<T>::value;
+    const std::size_t i = shift / d;
+    const unsigned offset = static_cast<unsigned>(shift % d);
+    const auto limb = [&](std::size_t k) { return k < n ? static_cast<W>(a[k]) : W{ 0 }; };
+    W bits = (limb(i) | (limb(i + 1) << d)) >> offset;
+    if (offset != 0) {
+        bits |= limb(i + 2) << (2 * d - offset);
+    }
+    return bits & ((W{ 1 } << (2 * d - 1)) - 1);
+}
+
+/*
+ * combine (dst = x * p - y * q over n limbs, plus a top limb; false if negative)
+ */
+template<typename T>
+constexpr bool combine(T* dst, const T* p, T x, const T* q, T y, std::size_t n) {
+    dst[n] = mul_1(dst, p, n, x);
+    const T borrow = submul_1(dst, q, n, y);
+    if (borrow > dst[n]) {
+        return false;
+    }
+    dst[n] = static_cast<T>(dst[n] - borrow);
+    return true;
+}
+
+/*
+ * cofactor_combine (dst = x * p + y * q, returning its size)
+ */
+template<typename T>
+constexpr std::size_t cofactor_combine(T* dst, const T* p, std::size_t pn, T x, const T* q, std::size_t qn, T y) {
+    const std::size_t n = std::max(pn, qn);
+    for (std::size_t i = 0; i <= n; ++i) {
+        dst[i] = 0;
+    }
+    dst[pn] = addmul_1(dst, p, pn, x);
+    const T carry = addmul_1(dst, q, qn, y);
+    add_1(dst + qn, dst + qn, n + 1 - qn, carry);
+    return normalized_size(dst, n + 1);
+}
+
+/*
+ * gcd_state (The pair being reduced, in scratch, and what a step needs)
+ *
+ * Buffers are exchanged rather than copied. With 'EXTENDED', 'sa' and
+ * 'sb' hold the magnitudes of the cofactors of the first input: a = sa * A
+ * mod B, and sa is negative when 'steps' is odd, sb the other way round.
+ */
+template<bool EXTENDED, typename T>
+struct gcd_state {
+    T* a;
+    T* b;
+    T* x;
+    T* y;
+    T* q;
+    T* r;
+    T* divide;
+    T* sa;
+    T* sb;
+    T* sx;
+    T* sy;
+    std::size_t an;
+    std::size_t bn;
+    std::size_t san;
+    std::size_t sbn;
+    std::size_t steps;
+};
+
+/*
+ * gcd_divide (a, b = b, a mod b)
+ */
+template<bool EXTENDED, typename T>
+constexpr void gcd_divide(gcd_state<EXTENDED, T>& s) {
+    for (std::size_t i = s.bn; i < s.an; ++i) {
+        s.b[i] = 0;
+    }
+    divrem(s.q, s.r, s.a, s.an, s.b, s.bn, s.divide);
+    const std::size_t qn = normalized_size(s.q, s.an - s.bn + 1);
+    T* const a = s.a;
+    s.a = s.b;
+    s.b = s.r;
+    s.r = a;
+    s.an = s.bn;
+    s.bn = normalized_size(s.b, s.bn);
+    if constexpr (EXTENDED) {
+        // sa, sb = sb, sa + q * sb: the signs alternate, so magnitudes add
+        std::size_t n = qn + s.sbn;
+        mul(s.sx, s.q, qn, s.sb, s.sbn);
+        for (std::size_t i = n; i <= std::max(n, s.san); ++i) {
+            s.sx[i] = 0;
+        }
+        n = std::max(n, s.san) + 1;
+        add(s.sx, s.sx, n, s.sa, s.san);
+        T* const sa = s.sa;
+        s.sa = s.sb;
+        s.san = s.sbn;
+        s.sb = s.sx;
+        s.sbn = normalized_size(s.sx, n);
+        s.sx = sa;
+    }
+    ++s.steps;
+}
+
+/*
+ * gcd_swap (a, b = b, a)
+ */
+template<bool EXTENDED, typename T>
+constexpr void gcd_swap(gcd_state<EXTENDED, T>& s) {
+    swap_values(s.a, s.b);
+    swap_values(s.an, s.bn);
+    if constexpr (EXTENDED) {
+        swap_values(s.sa, s.sb);
+        swap_values(s.san, s.sbn);
+    }
+    ++s.steps;
+}
+
+/*
+ * gcd_lehmer (One matrix of quotients from the leading bits; false if none applies)
+ */
+template<bool EXTENDED, typename T>
+constexpr bool gcd_lehmer(gcd_state<EXTENDED, T>& s) {
+    constexpr unsigned d = digits<T>::value;
+    const std::size_t n = s.an;
+    const std::size_t bits = n * d - leading_zeros(s.a[n - 1]);
+    const std::size_t shift = bits > 2 * d - 1 ? bits - (2 * d - 1) : 0;
+    const lehmer_matrix<T> m = lehmer<T>(leading_bits(s.a, n, shift), leading_bits(s.b, s.bn, shift));
+    if (m.steps == 0) {
+        return false;
+    }
+    for (std::size_t i = s.bn; i < n; ++i) {
+        s.b[i] = 0;
+    }
+    const bool even = m.steps % 2 == 0;
+    const bool valid = even
+        ? combine(s.x, s.a, m.u0, s.b, m.v0, n) && combine(s.y, s.b, m.v1, s.a, m.u1, n)
+        : combine(s.x, s.b, m.v0, s.a, m.u0, n) && combine(s.y, s.a, m.u1, s.b, m.v1, n);
+    if (!valid) {
+        return false;
+    }
+    swap_values(s.a, s.x);
+    swap_values(s.b, s.y);
+    s.an = normalized_size(s.a, n + 1);
+    s.bn = normalized_size(s.b, n + 1);
+    if constexpr (EXTENDED) {
+        const std::size_t xn = cofactor_combine(s.sx, s.sa, s.san, m.u0, s.sb, s.sbn, m.v0);
+        const std::size_t yn = cofactor_combine(s.sy, s.sa, s.san, m.u1, s.sb, s.sbn, m.v1);
+        swap_values(s.sa, s.sx);
+        swap_values(s.sb, s.sy);
+        s.san = xn;
+        s.sbn = yn;
+    }
+    s.steps += m.steps;
+    return true;
+}
+
+/*
+ * gcd_loop (Lehmer steps while both values are long, division steps otherwise)
+ */
+template<bool EXTENDED, typename T>
+constexpr void gcd_loop(gcd_state<EXTENDED, T>& s) {
+    while (s.bn != 0) {
+        if (!EXTENDED && s.bn == 1) {
+            const T r = divrem_1(s.q, s.a, s.an, s.b[0]);
+            s.a[0] = gcd_1(s.b[0], r);
+            s.an = 1;
+            s.bn = 0;
+            return;
+        }
+        if (s.an < s.bn || (s.an == s.bn && cmp(s.a, s.b, s.an) < 0)) {
+            gcd_swap(s);
+        } else if (s.an > s.bn + 1 || s.bn == 1 || !gcd_lehmer(s)) {
+            gcd_divide(s);
+        }
+    }
+}
+
+template<bool EXTENDED, typename T>
+constexpr gcd_state<EXTENDED, T> gcd_start(const T* a, std::size_t an, const T* b, std::size_t bn, T* scratch) {
+    const std::size_t n = std::max(an, bn) + 1;
+    gcd_state<EXTENDED, T> s = {};
+    s.a = scratch;
+    s.b = s.a + n;
+    s.x = s.b + n;
+    s.y = s.x + n;
+    s.q = s.y + n;
+    s.r = s.q + n;
+    s.divide = s.r + n;
+    s.sa = s.divide + 2 * n + 1;
+    s.sb = s.sa + 2 * n;
+    s.sx = s.sb + 2 * n;
+    s.sy = s.sx + 2 * n;
+    for (std::size_t i = 0; i < n; ++i) {
+        s.a[i] = i < an ? a[i] : T{ 0 };
+        s.b[i] = i < bn ? b[i] : T{ 0 };
+    }
+    s.an = normalized_size(s.a, n);
+    s.bn = normalized_size(s.b, n);
+    s.sa[0] = 1;
+    s.san = 1;
+    s.sbn = 0;
+    return s;
+}
+
+} //namespace impl
+
+/*
+ * gcd_scratch (Limbs of scratch for 'gcd' and 'gcdext')
+ */
+constexpr std::size_t gcd_scratch(std::size_t an, std::size_t bn) {
+    return 16 * (std::max(an, bn) + 1) + 1;
+}
+
+/*
+ * gcd (g = gcd(a, b), returning its size; g has room for max(an, bn) limbs)
+ *
+ * Lehmer's algorithm with double-digit steps: while the values are of
+ * about the same length, their leading 2 * digits - 1 bits give up to a
+ * limb's worth of quotients at once, applied to the full values in one
+ * 'mul_1' and 'submul_1' pass per value. The matrix is unimodular, so it
+ * keeps the GCD whatever the leading bits say; one that would take a
+ * value negative is dropped for a division step, as are values of very
+ * different lengths. The last limb ends in a binary GCD.
+ */
+template<typename T>
+constexpr std::size_t gcd(T* g, const T* a, std::size_t an, const T* b, std::size_t bn, T* scratch) {
+    impl::gcd_state<false, T> s = impl::gcd_start<false>(a, an, b, bn, scratch);
+    impl::gcd_loop(s);
+    for (std::size_t i = 0; i < s.an; ++i) {
+        g[i] = s.a[i];
+    }
+    return s.an;
+}
+
+/*
+ * gcdext (As 'gcd', also setting s with g = s * a + t * b for some t)
+ *
+ * 's' has room for max(an, bn) + 1 limbs and receives |s| in 'sn'
+ * limbs; 'negative' gives its sign, and may be set when s is zero. |s|
+ * is at most b / g.
+ */
+template<typename T>
+constexpr std::size_t gcdext(T* g, T* s, std::size_t& sn, bool& negative, const T* a, std::size_t an, const T* b, std::size_t bn, T* scratch) {
+    impl::gcd_state<true, T> state = impl::gcd_start<true>(a, an, b, bn, scratch);
+    impl::gcd_loop(state);
+    for (std::size_t i = 0; i < state.an; ++i) {
+        g[i] = state.a[i];
+    }
+    sn = state.san;
+    for (std::size_t i = 0; i < sn; ++i) {
+        s[i] = state.sa[i];
+    }
+    negative = state.steps % 2 == 1;
+    return state.an;
+}
+
+} //namespace mpn
+
+/*
+ * gcd
+ */
+template<typename T, std::size_t A_BITS, std::size_t B_BITS>
+constexpr auto gcd(const bigint<A_BITS, T>& a, const bigint<B_BITS, T>& b) {
+    constexpr std::size_t BITS = std::max(A_BITS, B_BITS);
+    std::array<T, mpn::gcd_scratch(bigint<A_BITS, T>::count, bigint<B_BITS, T>::count)> scratch = {};
+    bigint<BITS, T> g = {};
+    mpn::gcd(g.data(), a.data(), a.count, b.data(), b.count, scratch.data());
+    return g;
+}
+
+/*
+ * lcm (Zero if either value is zero)
+ */
+template<typename T, std::size_t A_BITS, std::size_t B_BITS>
+constexpr auto lcm(const bigint<A_BITS, T>& a, const bigint<B_BITS, T>& b) {
+    if (mpn::normalized_size(a.data(), a.count) == 0 || mpn::normalized_size(b.data(), b.count) == 0) {
+        return bigint<impl::required_bits_multiplication<T, A_BITS, B_BITS>::value, T>{};
+    }
+    return multiply(divide(a, resize<A_BITS>(gcd(a, b))), b);
+}
+
+/*
+ * gcd_extended_result (gcd = x * a - y * b, or y * b - x * a if 'negative')
+ */
+template<std::size_t BITS, typename T>
+struct gcd_extended_result {
+    bigint<BITS, T> gcd;
+    bigint<BITS, T> x;
+    bigint<BITS, T> y;
+    bool negative;
+};
+
+/*
+ * gcd_extended (Bezout coefficients, |x| <= b / gcd and |y| <= a / gcd)
+ */
+template<typename T, std::size_t A_BITS, std::size_t B_BITS>
+constexpr auto gcd_extended(const bigint<A_BITS, T>& a, const bigint<B_BITS, T>& b) {
+    constexpr std::size_t BITS = std::max(A_BITS, B_BITS);
+    std::array<T, mpn::gcd_scratch(bigint<A_BITS, T>::count, bigint<B_BITS, T>::count)> scratch = {};
+    std::array<T, bigint<BITS, T>::count + 1> s = {};
+    gcd_extended_result<BITS, T> result = {};
+    std::size_t sn = 0;
+    mpn::gcdext(result.gcd.data(), s.data(), sn, result.negative, a.data(), a.count, b.data(), b.count, scratch.data());
+    for (std::size_t i = 0; i < result.x.count; ++i) {
+        result.x[i] = s[i];
+    }
+    if (mpn::normalized_size(b.data(), b.count) != 0) {
+        // t = (g - s * a) / b, exact, of the sign opposite to s
+        const auto sa = multiply(result.x, a);
+        if (result.negative) {
+            result.y = resize<BITS>(divide(add(sa, result.gcd), b));
+        } else {
+            result.y = resize<BITS>(divide(subtract_in_place(sa, resize<decltype(sa)::bits>(result.gcd)), b));
+        }
+    }
+    return result;
+}
+
+/*
+ * mod_inverse (x with a * x = 1 mod m, in [0, m); zero if gcd(a, m) != 1)
+ */
+template<typename T, std::size_t A_BITS, std::size_t M_BITS>
+constexpr auto mod_inverse(const bigint<A_BITS, T>& a, const bigint<M_BITS, T>& m) {
+    constexpr std::size_t BITS = std::max(A_BITS, M_BITS);
+    std::array<T, mpn::gcd_scratch(bigint<A_BITS, T>::count, bigint<M_BITS, T>::count)> scratch = {};
+    std::array<T, bigint<BITS, T>::count + 1> s = {};
+    bigint<BITS, T> g = {};
+    std::size_t sn = 0;
+    bool negative = false;
+    const std::size_t gn = mpn::gcdext(g.data(), s.data(), sn, negative, a.data(), a.count, m.data(), m.count, scratch.data());
+    if (gn != 1 || g[0] != 1) {
+        return bigint<M_BITS, T>{};
+    }
+    bigint<BITS + std::numeric_limits<T>::digits, T> cofactor = {};
+    for (std::size_t i = 0; i < sn; ++i) {
+        cofactor[i] = s[i];
+    }
+    const bigint<M_BITS, T> inverse = modulo(cofactor, m);
+    if (negative && mpn::normalized_size(inverse.data(), inverse.count) != 0) {
+        return subtract_in_place(m, inverse);
+    }
+    return inverse;
+}
+
+/*
+ * gcd (bigint_dyn)
+ */
+template<typename T>
+bigint_dyn<T> gcd(const bigint_dyn<T>& a, const bigint_dyn<T>& b) {
+    scratch_buffer<T> scratch(mpn::gcd_scratch(a.size(), b.size()));
+    bigint_dyn<T> g;
+    g.resize(std::max(a.size(), b.size()));
+    g.resize(mpn::gcd(g.data(), a.data(), a.size(), b.data(), b.size(), scratch.data()));
+    return g;
+}
+
+/*
+ * lcm (bigint_dyn)
+ */
+template<typename T>
+bigint_dyn<T> lcm(const bigint_dyn<T>& a, const bigint_dyn<T>& b) {
+    const bigint_dyn<T> g = gcd(a, b);
+    if (g.size() == 0) {
+        return g;
+    }
+    return a / g * b;
+}
+
+/*
+ * mod_inverse (bigint_dyn)
+ */
+template<typename T>
+bigint_dyn<T> mod_inverse(const bigint_dyn<T>& a, const bigint_dyn<T>& m) {
+    scratch_buffer<T> scratch(mpn::gcd_scratch(a.size(), m.size()));
+    scratch_buffer<T> g(std::max(a.size(), m.size()) + 1);
+    bigint_dyn<T> inverse;
+    inverse.resize(std::max(a.size(), m.size()) + 1);
+    std::size_t sn = 0;
+    bool negative = false;
+    const std::size_t gn = mpn::gcdext(g.data(), inverse.data(), sn, negative, a.data(), a.size(), m.data(), m.size(), scratch.data());
+    inverse.resize(sn);
+    if (gn != 1 || g[0] != 1) {
+        return bigint_dyn<T>();
+    }
+    inverse = inverse % m;
+    if (negative && inverse.size() != 0) {
+        return m - inverse;
+    }
+    return inverse;
+}
+
+} //namespace ftl
+
+/*
+ * gcd_1
+ */
+static_assert(ftl::mpn::impl::gcd_1<std::uint32_t>(48, 180) == 12);
+static_assert(ftl::mpn::impl::gcd_1<std::uint8_t>(0, 7) == 7);
+
+/*
+ * gcd, lcm, gcd_extended & mod_inverse
+ */
+static_assert(ftl::gcd(ftl::bigint<64, std::uint8_t>{ 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x80 },
+    ftl::bigint<32, std::uint8_t>{ 0x00, 0x00, 0x01 }) == ftl::bigint<64, std::uint8_t>{ 0x00, 0x00, 0x01 });
+static_assert([] {
+    // 2^64 - 1 and 2^48 - 1 share 2^16 - 1; the Lehmer steps run on both
+    const ftl::bigint<64, std::uint16_t> a = { 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF };
+    const ftl::bigint<64, std::uint16_t> b = { 0xFFFF, 0xFFFF, 0xFFFF, 0x0000 };
+    return ftl::gcd(a, b) == ftl::bigint<64, std::uint16_t>{ 0xFFFF }
+        && ftl::lcm(a, b) == ftl::divide(ftl::multiply(a, b), ftl::bigint<16, std::uint16_t>{ 0xFFFF });
+}());
+static_assert([] {
+    const ftl::bigint<64, std::uint8_t> a = { 0x15, 0xCD, 0x5B, 0x07 };
+    const ftl::bigint<64, std::uint8_t> b = { 0xB1, 0x68, 0xDE, 0x3A };
+    const auto r = ftl::gcd_extended(a, b);
+    const auto xa = ftl::multiply(r.x, a);
+    const auto yb = ftl::multiply(r.y, b);
+    return r.negative ? ftl::subtract_in_place(yb, xa) == ftl::resize<128>(r.gcd) : ftl::subtract_in_place(xa, yb) == ftl::resize<128>(r.gcd);
+}());
+static_assert([] {
+    const ftl::bigint<32, std::uint32_t> a = { 3 };
+    const ftl::bigint<32, std::uint32_t> m = { 0xFFFFFFFB };
+    const auto inverse = ftl::mod_inverse(a, m);
+    return ftl::modulo(ftl::multiply(a, inverse), m) == ftl::bigint<32, std::uint32_t>{ 1 }
+        && ftl::mod_inverse(ftl::bigint<32, std::uint32_t>{ 6 }, ftl::bigint<32, std::uint32_t>{ 9 }) == ftl::bigint<32, std::uint32_t>{};
+}());
+
+#endif//FTL_BIGINT_GCD_HH
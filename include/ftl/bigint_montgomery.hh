@@ -0,0 +1,152 @@
+#ifndef FTL_BIGINT_MONTGOMERY_HH
+#define FTL_BIGINT_MONTGOMERY_HH
+
+#include <ftl/bigint_arithmetic_division.hh>
+#include <ftl/bigint_base.hh>
+#include <ftl/mpn.hh>
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+
+namespace ftl {
+namespace impl {
+
+/*
+ * negative_inverse (-n^-1 mod 2^digits, for odd n)
+ *
+ * n is its own inverse modulo 8, and every Newton step doubles the bits.
+ */
+template<typename T>
+constexpr T negative_inverse(T n) {
+    using U = std::common_type_t<T, unsigned int>;
+    T x = n;
+    for (int i = 0; i < 5; ++i) {
+        x = static_cast<T>(static_cast<U>(x) * static_cast<T>(U{ 2 } - static_cast<U>(n) * x));
+    }
+    return static_cast<T>(U{ 0 } - x);
+}
+
+/*
+ * redc (out = t / R mod modulus, for t of 2n limbs below modulus * R)
+ *
+ * One row per limb adds the multiple of the modulus that clears it; the
+ * carry out of each row is held back in 'over' and added with the next
+ * row's, so no carry chain runs to the top. 't' is used as scratch.
+ */
+template<typename T>
+constexpr void redc(T* out, T* t, const T* modulus, std::size_t n, T inverse) {
+    using W = typename bigint_datatype<T>::overflow_type;
+    T over = zero<T>::value;
+    for (std::size_t i = 0; i < n; ++i) {
+        const T m = static_cast<T>(static_cast<W>(t[i]) * inverse);
+        const T carry = mpn::addmul_1(t + i, modulus, n, m);
+        const W sum = static_cast<W>(t[i + n]) + carry + over;
+        t[i + n] = static_cast<T>(sum);
+        over = static_cast<T>(sum >> std::numeric_limits<T>::digits);
+    }
+    const T borrow = mpn::sub_n(out, t + n, modulus, n);
+    if (over == zero<T>::value && borrow != zero<T>::value) {
+        for (std::size_t i = 0; i < n; ++i) {
+            out[i] = t[n + i];
+        }
+    }
+}
+
+} //namespace impl
+
+/*
+ * montgomery (Odd modulus and its reduction constants, R = 2^(limb bits * count))
+ */
+template<std::size_t BITS, typename T = std::uint32_t>
+struct montgomery {
+    using value_type = bigint<BITS, T>;
+    static constexpr std::size_t count = value_type::count;
+
+    value_type modulus;
+    T inverse;
+    value_type r2;
+
+    constexpr explicit montgomery(const value_type& n) :
+        modulus(n),
+        inverse(impl::negative_inverse(n[0])),
+        r2(square_of_r(n))
+    {}
+
+private:
+    static constexpr value_type square_of_r(const value_type& n) {
+        bigint<2 * count * std::numeric_limits<T>::digits + 1, T> r = { zero<T>::value };
+        r[2 * count] = one<T>::value;
+        return modulo(r, n);
+    }
+};
+
+/*
+ * montgomery_reduce (t / R mod modulus)
+ */
+template<std::size_t BITS, typename T, std::size_t T_BITS>
+constexpr auto montgomery_reduce(const montgomery<BITS, T>& m, const bigint<T_BITS, T>& t) {
+    constexpr std::size_t n = montgomery<BITS, T>::count;
+    std::array<T, 2 * n> wide = {};
+    for (std::size_t i = 0; i < t.count && i < 2 * n; ++i) {
+        wide[i] = t[i];
+    }
+    std::array<T, n> result = {};
+    impl::redc(result.data(), wide.data(), m.modulus.data(), n, m.inverse);
+    return bigint<BITS, T>{ result };
+}
+
+/*
+ * montgomery_multiply (a * b / R mod modulus)
+ */
+template<std::size_t BITS, typename T>
+constexpr auto montgomery_multiply(const montgomery<BITS, T>& m, const bigint<BITS, T>& a, const bigint<BITS, T>& b) {
+    constexpr std::size_t n = montgomery<BITS, T>::count;
+    std::array<T, 2 * n> wide = {};
+    mpn::mul(wide.data(), a.data(), n, b.data(), n);
+    std::array<T, n> result = {};
+    impl::redc(result.data(), wide.data(), m.modulus.data(), n, m.inverse);
+    return bigint<BITS, T>{ result };
+}
+
+/*
+ * to_montgomery (a * R mod modulus, for a below the modulus)
+ */
+template<std::size_t BITS, typename T>
+constexpr auto to_montgomery(const montgomery<BITS, T>& m, const bigint<BITS, T>& a) {
+    return montgomery_multiply(m, a, m.r2);
+}
+
+/*
+ * from_montgomery
+ */
+template<std::size_t BITS, typename T>
+constexpr auto from_montgomery(const montgomery<BITS, T>& m, const bigint<BITS, T>& a) {
+    return montgomery_reduce(m, a);
+}
+
+} //namespace ftl
+
+/*
+ * negative_inverse
+ */
+static_assert(static_cast<std::uint8_t>(ftl::impl::negative_inverse<std::uint8_t>(0xF1) * 0xF1) == 0xFF);
+static_assert(static_cast<std::uint16_t>(ftl::impl::negative_inverse<std::uint16_t>(0xFFFB) * 0xFFFBu) == 0xFFFF);
+static_assert(ftl::impl::negative_inverse<std::uint32_t>(0xFFFFFFFB) * 0xFFFFFFFBu == 0xFFFFFFFF);
+static_assert(ftl::impl::negative_inverse<std::uint64_t>(0xFFFFFFFFFFFFFFC5) * 0xFFFFFFFFFFFFFFC5u == 0xFFFFFFFFFFFFFFFF);
+
+/*
+ * montgomery_multiply
+ */
+static_assert([] {
+    // 1000003 * 999983 mod (2^61 - 1), by way of the Montgomery domain
+    constexpr ftl::montgomery<61> m(ftl::bigint<61>{ 0xFFFFFFFF, 0x1FFFFFFF });
+    const auto a = ftl::to_montgomery(m, ftl::bigint<61>{ 1000003 });
+    const auto b = ftl::to_montgomery(m, ftl::bigint<61>{ 999983 });
+    const auto product = ftl::from_montgomery(m, ftl::montgomery_multiply(m, a, b));
+    return product == ftl::bigint<61>{ 0xD3CF704D, 0xE8 };
+}());
+
+#endif//FTL_BIGINT_MONTGOMERY_HH
@@ -0,0 +1,364 @@
+#ifndef FTL_BIGINT_PARALLEL_HH
+#define FTL_BIGINT_PARALLEL_HH
+
+#include <ftl/bigint_arithmetic_multiplication.hh>
+#include <ftl/bigint_base.hh>
+#include <ftl/bigint_view.hh>
+#include <ftl/charconv.hh>
+#include <ftl/identity.hh>
+#include <ftl/mpn.hh>
+#include <ftl/parallel.hh>
+#include <ftl/radix.hh>
+#include <ftl/scratch.hh>
+
+#include <algorithm>
+#include <charconv>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <system_error>
+#include <utility>
+#include <vector>
+
+namespace ftl {
+namespace mpn {
+namespace impl {
+
+/*
+ * parallel_threshold (Limb products below which one thread is faster)
+ */
+struct parallel_threshold : identity<std::size_t, std::size_t{ 1 } << 20> {};
+
+} //namespace impl
+
+/*
+ * mul_parallel (dst = a * b, an + bn limbs, on up to 'threads' workers)
+ *
+ * The longer operand is cut into one contiguous slice per worker. Worker 0
+ * multiplies its slice straight into 'dst', the others into scratch of
+ * their own, and the partial products are then added at their offsets in
+ * slice order. The arithmetic is exact, so the limbs are the ones 'mul'
+ * gives for any thread count; small products stay on the calling thread,
+ * as 'parallel_invoke' starts the workers anew for every product.
+ */
+template<typename T>
+void mul_parallel(T* dst, const T* a, std::size_t an, const T* b, std::size_t bn, std::size_t threads) {
+    if (an < bn) {
+        std::swap(a, b);
+        std::swap(an, bn);
+    }
+    const std::size_t slices = std::min(threads, an);
+    if (slices <= 1 || an * bn < impl::parallel_threshold::value) {
+        mul(dst, a, an, b, bn);
+        return;
+    }
+
+    // Slice k's partial product starts at limb lo + (k - 1) * bn of the
+    // scratch, which the calling thread draws from its arena in one piece
+    const auto bound = [&](std::size_t k) { return an * k / slices; };
+    scratch_buffer<T> partial(an - bound(1) + (slices - 1) * bn);
+    const auto offset = [&](std::size_t k) { return bound(k) - bound(1) + (k - 1) * bn; };
+    parallel_invoke(slices, [&](std::size_t k) {
+        const std::size_t lo = bound(k);
+        const std::size_t hi = bound(k + 1);
+        if (k == 0) {
+            mul(dst, a, hi, b, bn);
+            std::fill(dst + hi + bn, dst + an + bn, T{ 0 });
+        } else {
+            mul(partial.data() + offset(k), a + lo, hi - lo, b, bn);
+        }
+    });
+    for (std::size_t k = 1; k < slices; ++k) {
+        const std::size_t lo = bound(k);
+        add(dst + lo, dst + lo, an + bn - lo, partial.data() + offset(k), bound(k + 1) - lo + bn);
+    }
+}
+
+} //namespace mpn
+
+/*
+ * multiply_parallel
+ *
+ * Same product as 'multiply', computed with 'mpn::mul_parallel' over the
+ * significant limbs of both operands.
+ */
+template<typename T, std::size_t A_BITS, std::size_t B_BITS>
+auto multiply_parallel(const bigint<A_BITS, T>& a, const bigint<B_BITS, T>& b, std::size_t threads) {
+    bigint<impl::required_bits_multiplication<T, A_BITS, B_BITS>::value, T> result = { zero<T>::value };
+    const std::size_t an = mpn::normalized_size(a.data(), a.count);
+    const std::size_t bn = mpn::normalized_size(b.data(), b.count);
+    if (an + bn <= result.count) {
+        mpn::mul_parallel(result.data(), a.data(), an, b.data(), bn, threads);
+    } else {
+        scratch_buffer<T> product(an + bn);
+        mpn::mul_parallel(product.data(), a.data(), an, b.data(), bn, threads);
+        std::copy(product.begin(), product.begin() + result.count, result.begin());
+    }
+    return result;
+}
+
+namespace impl {
+
+/*
+ * radix_base_limbs (Values up to this many limbs are converted serially)
+ */
+struct radix_base_limbs : identity<std::size_t, 64> {};
+
+/*
+ * radix_powers (P[k] = chunk^(2^k), while the next square fits 'limbs')
+ *
+ * P[k] is the radix raised to the length of a level k slice of digits,
+ * 'radix_chunk::length << k'.
+ */
+template<std::uint8_t RADIX, typename T>
+std::vector<std::vector<T>> radix_powers(std::size_t limbs, std::size_t threads) {
+    std::vector<std::vector<T>> powers;
+    powers.push_back({ static_cast<T>(radix_chunk<RADIX, T>::value) });
+    while (2 * powers.back().size() - 1 <= limbs) {
+        const std::vector<T>& power = powers.back();
+        std::vector<T> square(2 * power.size());
+        mpn::mul_parallel(square.data(), power.data(), power.size(), power.data(), power.size(), threads);
+        square.resize(mpn::normalized_size(square.data(), square.size()));
+        powers.push_back(std::move(square));
+    }
+    return powers;
+}
+
+/*
+ * divrem_vector (x = x / d, returning x % d; both normalized)
+ */
+template<typename T>
+std::vector<T> divrem_vector(std::vector<T>& x, const std::vector<T>& d) {
+    if (x.size() < d.size() || (x.size() == d.size() && mpn::cmp(x.data(), d.data(), x.size()) < 0)) {
+        std::vector<T> remainder = std::move(x);
+        x.clear();
+        return remainder;
+    }
+    std::vector<T> quotient(x.size() - d.size() + 1);
+    std::vector<T> remainder(d.size());
+    scratch_buffer<T> scratch(x.size() + d.size() + 1);
+    mpn::divrem(quotient.data(), remainder.data(), x.data(), x.size(), d.data(), d.size(), scratch.data());
+    quotient.resize(mpn::normalized_size(quotient.data(), quotient.size()));
+    remainder.resize(mpn::normalized_size(remainder.data(), remainder.size()));
+    x = std::move(quotient);
+    return remainder;
+}
+
+/*
+ * digits_fixed (Exactly 'radix_chunk::length << level' digits of x < P[level], ending at 'last')
+ *
+ * x = q * P[level - 1] + r with q and r both below P[level - 1], so the
+ * two halves of the slice are independent; they are filled on separate
+ * threads while the budget lasts.
+ */
+template<std::uint8_t RADIX, typename T>
+void digits_fixed(std::vector<T> x, const std::vector<std::vector<T>>& powers, std::size_t level, char* last, std::size_t threads) {
+    using chunk = radix_chunk<RADIX, T>;
+    if (level == 0 || x.size() <= radix_base_limbs::value) {
+        char* const first = last - (chunk::length << level);
+        std::size_t size = x.size();
+        while (size > 0) {
+            const T remainder = mpn::divrem_1(x.data(), x.data(), size, static_cast<T>(chunk::value));
+            size = mpn::normalized_size(x.data(), size);
+            last = compose_backward_fixed<RADIX>(last, remainder, chunk::length);
+        }
+        std::fill(first, last, compose_digit<RADIX>(0));
+        return;
+    }
+
+    std::vector<T> low = divrem_vector(x, powers[level - 1]);
+    char* const middle = last - (chunk::length << (level - 1));
+    if (threads > 1) {
+        parallel_invoke(2, [&](std::size_t worker) {
+            if (worker == 0) {
+                digits_fixed<RADIX>(std::move(low), powers, level - 1, last, threads / 2);
+            } else {
+                digits_fixed<RADIX>(std::move(x), powers, level - 1, middle, threads - threads / 2);
+            }
+        });
+    } else {
+        digits_fixed<RADIX>(std::move(low), powers, level - 1, last, 1);
+        digits_fixed<RADIX>(std::move(x), powers, level - 1, middle, 1);
+    }
+}
+
+/*
+ * to_chars_parallel
+ *
+ * The quotients of the value by the largest powers it reaches are peeled
+ * off first, which fixes the digit count and where every remainder's
+ * slice starts; each remainder is then written in place by 'digits_fixed'.
+ */
+template<std::uint8_t RADIX, typename T>
+std::to_chars_result to_chars_parallel(char* first, char* last, bigint_view<T> value, std::size_t threads) {
+    using chunk = radix_chunk<RADIX, T>;
+    const std::size_t size = value.significant();
+    if (radix_shift(RADIX) != 0 || size <= radix_base_limbs::value) {
+        return to_chars_view<RADIX>(first, last, value);
+    }
+
+    const std::vector<std::vector<T>> powers = radix_powers<RADIX, T>(size, threads);
+    std::vector<T> x(value.begin(), value.begin() + size);
+    std::vector<std::pair<std::vector<T>, std::size_t>> slices;
+    std::size_t length = 0;
+    for (std::size_t level = powers.size(); level > 0; --level) {
+        const std::vector<T>& power = powers[level - 1];
+        while (x.size() > power.size() || (x.size() == power.size() && mpn::cmp(x.data(), power.data(), x.size()) >= 0)) {
+            slices.emplace_back(divrem_vector(x, power), level - 1);
+            length += chunk::length << (level - 1);
+        }
+    }
+
+    char head[1 + required_digits_radix<RADIX, T>::value] = {};
+    char* const head_end = head + sizeof(head);
+    const char* const head_begin = compose_backward<RADIX>(head_end, x.empty() ? T{ 0 } : x[0]);
+    const std::size_t head_length = static_cast<std::size_t>(head_end - head_begin);
+    if (static_cast<std::size_t>(last - first) < head_length + length) {
+        return { last, std::errc::value_too_large };
+    }
+
+    char* p = std::copy(head_begin, static_cast<const char*>(head_end), first);
+    for (std::size_t i = slices.size(); i > 0; --i) {
+        p += chunk::length << slices[i - 1].second;
+        digits_fixed<RADIX>(std::move(slices[i - 1].first), powers, slices[i - 1].second, p, threads);
+    }
+    return { p, std::errc{} };
+}
+
+/*
+ * limbs_serial (Value of a run of digits, one multiply-add per chunk)
+ */
+template<std::uint8_t RADIX, typename T>
+std::vector<T> limbs_serial(const char* first, const char* last) {
+    using chunk = radix_chunk<RADIX, T>;
+    std::vector<T> limbs(static_cast<std::size_t>(last - first) / chunk::length + 1);
+    std::size_t size = 0;
+    while (first != last) {
+        T scale = one<T>::value;
+        T part = zero<T>::value;
+        for (std::size_t j = 0; j < chunk::length && first != last; ++j, ++first) {
+            scale = static_cast<T>(scale * RADIX);
+            part = static_cast<T>(part * RADIX + parse_digit<RADIX>(*first));
+        }
+        const T carry = static_cast<T>(mpn::mul_1(limbs.data(), limbs.data(), size, scale)
+            + mpn::add_1(limbs.data(), limbs.data(), size, part));
+        if (carry != zero<T>::value) {
+            limbs[size++] = carry;
+        }
+    }
+    limbs.resize(size);
+    return limbs;
+}
+
+/*
+ * limbs_parallel (Value of a run of digits)
+ *
+ * The low 'radix_chunk::length << k' digits and the rest are parsed on
+ * separate threads and joined as high * P[k] + low.
+ */
+template<std::uint8_t RADIX, typename T>
+std::vector<T> limbs_parallel(const char* first, const char* last, const std::vector<std::vector<T>>& powers, std::size_t threads) {
+    using chunk = radix_chunk<RADIX, T>;
+    const std::size_t count = static_cast<std::size_t>(last - first);
+    std::size_t level = powers.size();
+    while (level > 0 && (chunk::length << (level - 1)) >= count) {
+        --level;
+    }
+    if (level == 0 || count <= chunk::length * radix_base_limbs::value) {
+        return limbs_serial<RADIX, T>(first, last);
+    }
+
+    const char* const middle = last - (chunk::length << (level - 1));
+    std::vector<T> high;
+    std::vector<T> low;
+    if (threads > 1) {
+        parallel_invoke(2, [&](std::size_t worker) {
+            if (worker == 0) {
+                low = limbs_parallel<RADIX, T>(middle, last, powers, threads / 2);
+            } else {
+                high = limbs_parallel<RADIX, T>(first, middle, powers, threads - threads / 2);
+            }
+        });
+    } else {
+        low = limbs_parallel<RADIX, T>(middle, last, powers, 1);
+        high = limbs_parallel<RADIX, T>(first, middle, powers, 1);
+    }
+
+    const std::vector<T>& power = powers[level - 1];
+    std::vector<T> result(high.size() + power.size());
+    mpn::mul_parallel(result.data(), high.data(), high.size(), power.data(), power.size(), threads);
+    mpn::add(result.data(), result.data(), result.size(), low.data(), low.size());
+    result.resize(mpn::normalized_size(result.data(), result.size()));
+    return result;
+}
+
+/*
+ * from_chars_parallel
+ */
+template<std::uint8_t RADIX, std::size_t BITS, typename T>
+std::from_chars_result from_chars_parallel(const char* first, const char* last, bigint<BITS, T>& value, std::size_t threads) {
+    using chunk = radix_chunk<RADIX, T>;
+    const char* p = first;
+    while (p != last && is_digit<RADIX>(*p)) {
+        ++p;
+    }
+    const std::size_t count = static_cast<std::size_t>(p - first);
+    if (radix_shift(RADIX) != 0 || count <= chunk::length * radix_base_limbs::value) {
+        return from_chars_bigint<RADIX>(first, last, value);
+    }
+
+    const double bits = static_cast<double>(count) * std::log2(static_cast<double>(RADIX));
+    const std::size_t limbs = static_cast<std::size_t>(bits / std::numeric_limits<T>::digits) + 2;
+    const std::vector<std::vector<T>> powers = radix_powers<RADIX, T>(limbs, threads);
+    std::vector<T> result = limbs_parallel<RADIX, T>(first, p, powers, threads);
+
+    constexpr std::size_t top_bits = BITS % std::numeric_limits<T>::digits;
+    if (result.size() > value.count
+        || (top_bits != 0 && result.size() == value.count && (result.back() >> top_bits) != zero<T>::value)) {
+        return { p, std::errc::result_out_of_range };
+    }
+    std::copy(result.begin(), result.end(), value.begin());
+    std::fill(value.begin() + static_cast<std::ptrdiff_t>(result.size()), value.end(), zero<T>::value);
+    return { p, std::errc{} };
+}
+
+} //namespace impl
+
+/*
+ * to_chars_parallel
+ *
+ * Same text as 'to_chars', built with the divide-and-conquer split tree:
+ * every subtree writes its own slice of [first, last) on the thread that
+ * owns it, so nothing is concatenated. With one thread the tree still
+ * beats 'to_chars' on large values; power of two radices and small values
+ * take the serial path.
+ */
+template<typename T>
+std::to_chars_result to_chars_parallel(char* first, char* last, bigint_view<T> value, int radix, std::size_t threads) {
+    return impl::with_radix(radix, std::to_chars_result{ last, std::errc::invalid_argument }, [&](auto r) {
+        return impl::to_chars_parallel<decltype(r)::value>(first, last, value, threads);
+    });
+}
+
+template<std::size_t BITS, typename T>
+std::to_chars_result to_chars_parallel(char* first, char* last, const bigint<BITS, T>& value, int radix, std::size_t threads) {
+    return to_chars_parallel(first, last, bigint_view<T>(value), radix, threads);
+}
+
+/*
+ * from_chars_parallel
+ *
+ * Same result as 'from_chars'; the digits are split the same way and the
+ * halves parsed on separate threads.
+ */
+template<std::size_t BITS, typename T>
+std::from_chars_result from_chars_parallel(const char* first, const char* last, bigint<BITS, T>& value, int radix, std::size_t threads) {
+    return impl::with_radix(radix, std::from_chars_result{ first, std::errc::invalid_argument }, [&](auto r) {
+        return impl::from_chars_parallel<decltype(r)::value>(first, last, value, threads);
+    });
+}
+
+}//namespace ftl
+
+#endif//FTL_BIGINT_PARALLEL_HH
@@ -0,0 +1,451 @@
+#ifndef FTL_BIGINT_PRIME_HH
+#define FTL_BIGINT_PRIME_HH
+
+#include <ftl/bigint_arithmetic_addition.hh>
+#include <ftl/bigint_arithmetic_shift.hh>
+#include <ftl/bigint_arithmetic_subtraction.hh>
+#include <ftl/bigint_base.hh>
+#include <ftl/bigint_montgomery.hh>
+#include <ftl/bigint_root.hh>
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+
+namespace ftl {
+namespace impl {
+
+inline constexpr std::uint32_t small_prime_limit = 2048;
+
+/*
+ * small_prime_sieve (Sieve of Eratosthenes below 'small_prime_limit')
+ */
+constexpr std::array<bool, small_prime_limit> small_prime_sieve() {
+    std::array<bool, small_prime_limit> composite = {};
+    composite[0] = composite[1] = true;
+    for (std::uint32_t p = 2; p * p < small_prime_limit; ++p) {
+        for (std::uint32_t q = p * p; !composite[p] && q < small_prime_limit; q += p) {
+            composite[q] = true;
+        }
+    }
+    return composite;
+}
+
+constexpr std::size_t small_prime_count() {
+    std::size_t count = 0;
+    for (const bool composite : small_prime_sieve()) {
+        count += !composite;
+    }
+    return count;
+}
+
+template<std::size_t N>
+constexpr std::array<std::uint32_t, N> make_small_primes() {
+    const std::array<bool, small_prime_limit> composite = small_prime_sieve();
+    std::array<std::uint32_t, N> primes = {};
+    for (std::uint32_t i = 0, k = 0; i < small_prime_limit; ++i) {
+        if (!composite[i]) {
+            primes[k++] = i;
+        }
+    }
+    return primes;
+}
+
+/*
+ * small_primes (The primes below 'small_prime_limit')
+ */
+inline constexpr std::array<std::uint32_t, small_prime_count()> small_primes = make_small_primes<small_prime_count()>();
+
+/*
+ * small_prime_group (Run of small primes whose product stays below 2^32)
+ *
+ * One single-limb division by the product leaves a remainder that every
+ * prime of the run then divides as a machine word. The first run is the
+ * wheel 2 * 3 * 5 * ... * 23 = 223092870.
+ */
+struct small_prime_group {
+    std::uint32_t product;
+    std::size_t first;
+    std::size_t last;
+};
+
+constexpr std::size_t small_prime_group_count() {
+    std::size_t count = 0;
+    std::uint64_t product = 1;
+    for (const std::uint32_t p : small_primes) {
+        if (product * p > 0xFFFFFFFF) {
+            ++count;
+            product = 1;
+        }
+        product *= p;
+    }
+    return count + 1;
+}
+
+template<std::size_t N>
+constexpr std::array<small_prime_group, N> make_small_prime_groups() {
+    std::array<small_prime_group, N> groups = {};
+    std::uint64_t product = 1;
+    std::size_t k = 0;
+    for (std::size_t i = 0; i < small_primes.size(); ++i) {
+        const std::uint32_t p = small_primes[i];
+        if (product * p > 0xFFFFFFFF) {
+            groups[k].product = static_cast<std::uint32_t>(product);
+            groups[k++].last = i;
+            groups[k].first = i;
+            product = 1;
+        }
+        product *= p;
+    }
+    groups[k].product = static_cast<std::uint32_t>(product);
+    groups[k].last = small_primes.size();
+    return groups;
+}
+
+inline constexpr std::array<small_prime_group, small_prime_group_count()> small_prime_groups
+    = make_small_prime_groups<small_prime_group_count()>();
+
+/*
+ * low_word (The lowest 64 bits)
+ */
+template<std::size_t BITS, typename T>
+constexpr std::uint64_t low_word(const bigint<BITS, T>& n) {
+    constexpr unsigned digits = std::numeric_limits<T>::digits;
+    std::uint64_t value = 0;
+    for (std::size_t i = 0; i < n.count && i * digits < 64; ++i) {
+        value |= static_cast<std::uint64_t>(n[i]) << (i * digits);
+    }
+    return value;
+}
+
+/*
+ * small_factor (Whether a prime below 'small_prime_limit' divides n)
+ */
+template<std::size_t BITS, typename T>
+constexpr bool small_factor(const bigint<BITS, T>& n) {
+    for (const small_prime_group& g : small_prime_groups) {
+        const std::uint64_t r = modulo_small(n, g.product);
+        for (std::size_t i = g.first; i < g.last; ++i) {
+            if (r % small_primes[i] == 0) {
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+/*
+ * jacobi (Jacobi symbol (a / n), for odd n)
+ *
+ * Sign and factors of two come from n mod 8; reciprocity then swaps to
+ * (n mod |a| / |a|), which is all machine words.
+ */
+template<std::size_t BITS, typename T>
+constexpr int jacobi(std::int64_t a, const bigint<BITS, T>& n) {
+    const std::uint64_t n8 = n[0] & 7;
+    int result = 1;
+    std::uint64_t b = a < 0 ? 0 - static_cast<std::uint64_t>(a) : static_cast<std::uint64_t>(a);
+    if (a < 0 && n8 % 4 == 3) {
+        result = -result;
+    }
+    while (b != 0 && b % 2 == 0) {
+        b /= 2;
+        if (n8 == 3 || n8 == 5) {
+            result = -result;
+        }
+    }
+    if (b == 0) {
+        return n == bigint<BITS, T>{ one<T>::value } ? 1 : 0;
+    }
+    if (b % 4 == 3 && n8 % 4 == 3) {
+        result = -result;
+    }
+    std::uint64_t x = modulo_small(n, b);
+    while (x != 0) {
+        while (x % 2 == 0) {
+            x /= 2;
+            if (b % 8 == 3 || b % 8 == 5) {
+                result = -result;
+            }
+        }
+        const std::uint64_t t = x;
+        x = b;
+        b = t;
+        if (x % 4 == 3 && b % 4 == 3) {
+            result = -result;
+        }
+        x %= b;
+    }
+    return b == 1 ? result : 0;
+}
+
+/*
+ * montgomery_add, montgomery_subtract & montgomery_half (Modulo the modulus)
+ *
+ * All three are linear, so they act on Montgomery residues unchanged.
+ */
+template<std::size_t BITS, typename T>
+constexpr bigint<BITS, T> montgomery_add(const montgomery<BITS, T>& m, const bigint<BITS, T>& a, const bigint<BITS, T>& b) {
+    const auto sum = add(a, b);
+    return resize<BITS>(sum < m.modulus ? sum : subtract_in_place(sum, m.modulus));
+}
+
+template<std::size_t BITS, typename T>
+constexpr bigint<BITS, T> montgomery_subtract(const montgomery<BITS, T>& m, const bigint<BITS, T>& a, const bigint<BITS, T>& b) {
+    return b < a || b == a ? subtract_in_place(a, b) : resize<BITS>(subtract_in_place(add(a, m.modulus), b));
+}
+
+template<std::size_t BITS, typename T>
+constexpr bigint<BITS, T> montgomery_half(const montgomery<BITS, T>& m, const bigint<BITS, T>& a) {
+    return (a[0] & one<T>::value) ? resize<BITS>(add(a, m.modulus) >> 1) : a >> 1;
+}
+
+/*
+ * montgomery_small (Residue of a small signed value, below the modulus in magnitude)
+ */
+template<std::size_t BITS, typename T>
+constexpr bigint<BITS, T> montgomery_small(const montgomery<BITS, T>& m, std::int64_t value) {
+    const std::uint64_t magnitude = value < 0 ? 0 - static_cast<std::uint64_t>(value) : static_cast<std::uint64_t>(value);
+    bigint<BITS, T> a = {};
+    for (std::size_t i = 0; i < a.count && i * std::numeric_limits<T>::digits < 64; ++i) {
+        a[i] = static_cast<T>(magnitude >> (i * std::numeric_limits<T>::digits));
+    }
+    a = to_montgomery(m, a);
+    return value < 0 && !(a == bigint<BITS, T>{}) ? subtract_in_place(m.modulus, a) : a;
+}
+
+template<std::size_t BITS, typename T>
+constexpr bool test_bit(const bigint<BITS, T>& a, std::size_t i) {
+    return (a[i / std::numeric_limits<T>::digits] >> (i % std::numeric_limits<T>::digits)) & one<T>::value;
+}
+
+/*
+ * strong_probable_prime (Miller-Rabin to 'base', for odd n > 'base')
+ *
+ * n - 1 = d * 2^s; n passes if base^d is 1, or base^(d * 2^r) is n - 1
+ * for some r < s. Every product is a Montgomery multiplication; to base
+ * 2, the multiplications by the base are doublings.
+ */
+template<std::size_t BITS, typename T>
+constexpr bool strong_probable_prime(const montgomery<BITS, T>& m, std::uint32_t base) {
+    const bigint<BITS, T> n_less = subtract_in_place(m.modulus, bigint<BITS, T>{ one<T>::value });
+    std::size_t s = 0;
+    while (!test_bit(n_less, s)) {
+        ++s;
+    }
+    const bigint<BITS, T> d = n_less >> s;
+    const bigint<BITS, T> unit = montgomery_small(m, 1);
+    const bigint<BITS, T> minus_unit = subtract_in_place(m.modulus, unit);
+    const bigint<BITS, T> a = montgomery_small(m, base);
+    bigint<BITS, T> x = a;
+    for (std::size_t i = d.highest_bit() - 1; i > 0; --i) {
+        x = montgomery_multiply(m, x, x);
+        if (test_bit(d, i - 1)) {
+            x = base == 2 ? montgomery_add(m, x, x) : montgomery_multiply(m, x, a);
+        }
+    }
+    if (x == unit || x == minus_unit) {
+        return true;
+    }
+    for (std::size_t r = 1; r < s; ++r) {
+        x = montgomery_multiply(m, x, x);
+        if (x == minus_unit) {
+            return true;
+        }
+        if (x == unit) {
+            return false;
+        }
+    }
+    return false;
+}
+
+/*
+ * strong_lucas_probable_prime (Lucas test with Selfridge's parameters, for odd non-square n)
+ *
+ * D is the first of 5, -7, 9, -11, ... with (D / n) = -1, P = 1 and
+ * Q = (1 - D) / 4. n + 1 = d * 2^s; n passes if U_d = 0, or V_(d * 2^r)
+ * = 0 for some r < s. The ladder doubles U, V and Q^k per bit of d.
+ */
+template<std::size_t BITS, typename T>
+constexpr bool strong_lucas_probable_prime(const montgomery<BITS, T>& m) {
+    std::int64_t D = 5;
+    for (;;) {
+        const int j = jacobi(D, m.modulus);
+        if (j == -1) {
+            break;
+        }
+        if (j == 0) {
+            return false;
+        }
+        D = D < 0 ? 2 - D : -2 - D;
+    }
+    const bigint<BITS, T> d_m = montgomery_small(m, D);
+    const bigint<BITS, T> q_m = montgomery_small(m, (1 - D) / 4);
+
+    const auto n_more = add(m.modulus, bigint<BITS, T>{ one<T>::value });
+    std::size_t s = 0;
+    while (!test_bit(n_more, s)) {
+        ++s;
+    }
+    const bigint<BITS, T> d = resize<BITS>(n_more >> s);
+
+    bigint<BITS, T> u = montgomery_small(m, 1);
+    bigint<BITS, T> v = u;
+    bigint<BITS, T> qk = q_m;
+    for (std::size_t i = d.highest_bit() - 1; i > 0; --i) {
+        u = montgomery_multiply(m, u, v);
+        v = montgomery_subtract(m, montgomery_multiply(m, v, v), montgomery_add(m, qk, qk));
+        qk = montgomery_multiply(m, qk, qk);
+        if (test_bit(d, i - 1)) {
+            const bigint<BITS, T> du = montgomery_multiply(m, d_m, u);
+            u = montgomery_half(m, montgomery_add(m, u, v));
+            v = montgomery_half(m, montgomery_add(m, du, v));
+            qk = montgomery_multiply(m, qk, q_m);
+        }
+    }
+    const bigint<BITS, T> zero_m = {};
+    if (u == zero_m || v == zero_m) {
+        return true;
+    }
+    for (std::size_t r = 1; r < s; ++r) {
+        v = montgomery_subtract(m, montgomery_multiply(m, v, v), montgomery_add(m, qk, qk));
+        if (v == zero_m) {
+            return true;
+        }
+        qk = montgomery_multiply(m, qk, qk);
+    }
+    return false;
+}
+
+/*
+ * bpsw (Baillie-PSW, for odd n above the small primes' limit)
+ */
+template<std::size_t BITS, typename T>
+constexpr bool bpsw(const bigint<BITS, T>& n) {
+    const montgomery<BITS, T> m(n);
+    return strong_probable_prime(m, 2) && !is_perfect_square(n) && strong_lucas_probable_prime(m);
+}
+
+} //namespace impl
+
+/*
+ * is_probable_prime (Baillie-PSW after trial division)
+ *
+ * Trial division by the primes below 2048 runs as one single-limb
+ * division per run of primes whose product fits 32 bits, the first run
+ * being the wheel up to 23. What survives, and is not small enough to be
+ * proven prime by that, takes a base-2 Miller-Rabin and a strong Lucas
+ * test on Montgomery arithmetic. No composite is known to pass both, and
+ * none exists below 2^64.
+ */
+template<std::size_t BITS, typename T>
+constexpr bool is_probable_prime(const bigint<BITS, T>& n) {
+    if (n.highest_bit() <= 32) {
+        const std::uint64_t value = impl::low_word(n);
+        if (value < impl::small_prime_limit) {
+            for (const std::uint32_t p : impl::small_primes) {
+                if (p == value) {
+                    return true;
+                }
+            }
+            return false;
+        }
+        if (impl::small_factor(n)) {
+            return false;
+        }
+        if (value < std::uint64_t{ impl::small_prime_limit } * impl::small_prime_limit) {
+            return true;
+        }
+        return impl::bpsw(n);
+    }
+    return !impl::small_factor(n) && impl::bpsw(n);
+}
+
+/*
+ * next_prime (The least probable prime above n; zero if none fits in BITS)
+ *
+ * Odd candidates are sieved a window at a time: one remainder per small
+ * prime marks all its multiples in the window, and only the survivors
+ * reach the Baillie-PSW test.
+ */
+template<std::size_t BITS, typename T>
+constexpr bigint<BITS, T> next_prime(const bigint<BITS, T>& n) {
+    constexpr std::size_t window = 1024;
+    if (n.highest_bit() <= 32 && impl::low_word(n) + 1 < impl::small_prime_limit) {
+        const std::uint64_t value = impl::low_word(n);
+        for (const std::uint32_t p : impl::small_primes) {
+            if (p > value) {
+                bigint<BITS, T> result = {};
+                for (std::size_t i = 0; i < result.count && i * std::numeric_limits<T>::digits < 32; ++i) {
+                    result[i] = static_cast<T>(p >> (i * std::numeric_limits<T>::digits));
+                }
+                return impl::low_word(result) == p ? result : bigint<BITS, T>{};
+            }
+        }
+    }
+    auto start = add(n, bigint<BITS, T>{ static_cast<T>((n[0] & one<T>::value) ? 2 : 1) });
+    for (;;) {
+        std::array<bool, window> composite = {};
+        for (const impl::small_prime_group& g : impl::small_prime_groups) {
+            const std::uint64_t r = impl::modulo_small(start, g.product);
+            for (std::size_t k = g.first; k < g.last; ++k) {
+                const std::uint64_t p = impl::small_primes[k];
+                if (p == 2) {
+                    continue;
+                }
+                // start + 2 i = 0 (mod p) at i = -r / 2 = (p - r) (p + 1) / 2
+                for (std::uint64_t i = (p - r % p) % p * ((p + 1) / 2) % p; i < window; i += p) {
+                    composite[i] = true;
+                }
+            }
+        }
+        for (std::size_t i = 0; i < window; ++i) {
+            if (composite[i]) {
+                continue;
+            }
+            const auto candidate = add(start, impl::bigint_from_size<T>(2 * i));
+            if (!(resize<BITS>(candidate) == candidate)) {
+                return {};
+            }
+            if (impl::bpsw(resize<BITS>(candidate))) {
+                return resize<BITS>(candidate);
+            }
+        }
+        start = resize<BITS + 1>(add(start, impl::bigint_from_size<T>(2 * window)));
+        if (!(resize<BITS>(start) == start)) {
+            return {};
+        }
+    }
+}
+
+} //namespace ftl
+
+/*
+ * small_primes
+ */
+static_assert(ftl::impl::small_primes.size() == 309 && ftl::impl::small_primes[308] == 2039);
+static_assert(ftl::impl::small_prime_groups[0].product == 223092870);
+
+/*
+ * jacobi
+ */
+static_assert(ftl::impl::jacobi(5, ftl::bigint<32>{ 7 }) == -1 && ftl::impl::jacobi(-7, ftl::bigint<32>{ 11 }) == 1);
+static_assert(ftl::impl::jacobi(9, ftl::bigint<32>{ 15 }) == 0 && ftl::impl::jacobi(1001, ftl::bigint<32>{ 9907 }) == -1);
+
+/*
+ * is_probable_prime
+ */
+static_assert(ftl::is_probable_prime(ftl::bigint<8, std::uint8_t>{ 251 }));
+static_assert(!ftl::is_probable_prime(ftl::bigint<16, std::uint8_t>{ 0xD7, 0x07 }));
+static_assert(ftl::is_probable_prime(ftl::bigint<61>{ 0xFFFFFFFF, 0x1FFFFFFF }));
+// 3825123056546413051, a strong pseudoprime to every base up to 37
+static_assert(!ftl::is_probable_prime(ftl::bigint<64, std::uint16_t>{ 0xF9FB, 0x4F9A, 0x9127, 0x3515 }));
+
+/*
+ * next_prime
+ */
+static_assert(ftl::next_prime(ftl::bigint<16, std::uint8_t>{ 0xF0, 0x07 }) == ftl::bigint<16, std::uint8_t>{ 0xF7, 0x07 });
+static_assert(ftl::next_prime(ftl::bigint<8, std::uint8_t>{ 251 }) == ftl::bigint<8, std::uint8_t>{});
+
+#endif//FTL_BIGINT_PRIME_HH
@@ -3,93 +3,95 @@
 
 #include <ftl/identity.hh>
 #include <ftl/radix.hh>
+#include <ftl/bigint_base.hh>
+#include <ftl/bigint_arithmetic_division.hh>
+#include <ftl/bigint_arithmetic_multiplication.hh>
 
+#include <array>
 #include <cstdint>
 
 namespace ftl {
 namespace impl {
 
 /*
- * required_bits_radix (Generic)
+ * required_bits_radix
+ *
+ * Exact bits of the largest DIGITS digit number.
  */
 template<std::size_t RADIX, std::size_t DIGITS>
 struct required_bits_radix :
-    identity<std::size_t, 0>
+    identity<std::size_t, radix_power_bits<RADIX, DIGITS>()>
 {};
 
 /*
- * required_bits_radix (Base 8)
- */
-template<std::size_t DIGITS>
-struct required_bits_radix<8, DIGITS> :
-    identity<std::size_t, DIGITS * 3>
-{};
-
-/*
- * required_bits_radix (Base 10)
+ * literal_bits (Exact bits of a literal's value, at least one)
  */
-template<std::size_t DIGITS>
-struct required_bits_radix<10, DIGITS> :
-    identity<
-        std::size_t,
-        1 + static_cast<std::size_t>(
-            static_cast<double>(DIGITS) *
-            3.32192809488736234787
-        )
-    >
-{};
-
-/*
- * required_bits_radix (Base 16)
- */
-template<std::size_t DIGITS>
-struct required_bits_radix<16, DIGITS> :
-    identity<std::size_t, DIGITS * 4>
-{};
-
-/*
- * required_bits_radix (Base 64)
- */
-template<std::size_t DIGITS>
-struct required_bits_radix<64, DIGITS> :
-    identity<std::size_t, DIGITS * 6>
-{};
+template<typename V>
+constexpr std::size_t literal_bits(const V& value) {
+    return std::max<std::size_t>(value.highest_bit(), 1);
+}
 
 } //namespace impl
 
 /*
  * from_digits
+ *
+ * Digits are gathered into limb-sized chunks of 'radix_chunk' digits, so
+ * the whole number is scaled once per chunk rather than once per digit.
  */
 template<typename T, std::uint8_t RADIX = 10, typename DIGIT = std::uint8_t, size_t INPUT_LENGTH>
 constexpr auto from_digits(const std::array<DIGIT, INPUT_LENGTH> digits) {
-    using OverflowType = typename impl::bigint_datatype<T>::overflow_type;
+    using chunk = impl::radix_chunk<RADIX, T>;
     constexpr auto BITS = impl::required_bits_radix<RADIX, INPUT_LENGTH>::value;
 
     std::array<T, impl::required_elements<T, BITS>::value> result = {};
-    for (size_t i = 0; i < INPUT_LENGTH; ++i) {
-        OverflowType carry = zero<OverflowType>::value;
-        for (size_t j = 0; j < result.size(); ++j) {
-            OverflowType product = add(multiply(static_cast<OverflowType>(result[j]), static_cast<OverflowType>(RADIX)),
-                                       carry);
-            OverflowType low = product & std::numeric_limits<T>::max();
-            carry = product >> std::numeric_limits<T>::digits;
-            result[j] = low;
-        }
-        carry = digits[i];
-        for (size_t j = 0; j < result.size(); ++j) {
-            OverflowType sum = add(static_cast<OverflowType>(result[j]), carry);
-            OverflowType low = sum & std::numeric_limits<T>::max();
-            carry = sum >> std::numeric_limits<T>::digits;
-            result[j] = low;
+    std::size_t size = 0;
+    for (std::size_t i = 0; i < INPUT_LENGTH; i += chunk::length) {
+        const std::size_t end = std::min(i + chunk::length, INPUT_LENGTH);
+        T scale = one<T>::value;
+        T value = zero<T>::value;
+        for (std::size_t j = i; j < end; ++j) {
+            scale = static_cast<T>(scale * RADIX);
+            value = static_cast<T>(value * RADIX + digits[j]);
         }
+        impl::multiply_add_in_place(result, size, scale, value);
     }
     return bigint<BITS, T>{ result };
 }
 
 /*
  * to_digits
+ *
+ * Least significant digit first, unused digits are zero. The number is
+ * divided by the largest power of RADIX that fits in a limb, so each pass
+ * over the limbs yields 'radix_chunk' digits.
  */
-// TODO
+template<
+    std::uint8_t RADIX = 10,
+    std::size_t BITS,
+    typename T,
+    std::size_t DIGITS = impl::required_digits_bits<RADIX, BITS>::value
+>
+constexpr auto to_digits(const bigint<BITS, T> value) {
+    using chunk = impl::radix_chunk<RADIX, T>;
+
+    std::array<char, DIGITS> digits = {};
+    std::array<T, impl::required_elements<T, BITS>::value> limbs = value;
+    std::size_t size = limbs.size();
+    while (size > 0 && limbs[size - 1] == zero<T>::value) {
+        --size;
+    }
+
+    std::size_t i = 0;
+    while (size > 0) {
+        T remainder = impl::divide_in_place(limbs, size, chunk::value);
+        for (std::size_t j = 0; j < chunk::length && (size > 0 || remainder > 0); ++j) {
+            digits[i++] = compose_digit<RADIX>(static_cast<T>(remainder % RADIX));
+            remainder = static_cast<T>(remainder / RADIX);
+        }
+    }
+    return digits;
+}
 
 namespace _ {
 
@@ -98,7 +100,8 @@ namespace _ {
  */
 template<char... DIGITS>
 constexpr auto operator "" _10() {
-    return from_digits<std::uint32_t>(parse_digits_base10<DIGITS...>());
+    constexpr auto value = from_digits<std::uint32_t>(parse_digits_base10<DIGITS...>());
+    return resize<impl::literal_bits(value)>(value);
 }
 
 /*
@@ -106,7 +109,8 @@ constexpr auto operator "" _10() {
  */
 template<char... DIGITS>
 constexpr auto operator "" _16() {
-    return from_digits<std::uint32_t, 16>(parse_digits_base16<DIGITS...>());
+    constexpr auto value = from_digits<std::uint32_t, 16>(parse_digits_base16<DIGITS...>());
+    return resize<impl::literal_bits(value)>(value);
 }
 
 }//namespace _
@@ -133,6 +137,31 @@ static_assert(ftl::impl::required_bits_radix<16, 2>::value == 8);
 static_assert(ftl::impl::required_bits_radix<16, 8>::value == 32);
 static_assert(ftl::impl::required_bits_radix<16, 32>::value == 128);
 
+/*
+ * required_bits_radix (Base 32)
+ */
+static_assert(ftl::impl::required_bits_radix<32, 2>::value == 10);
+
+/*
+ * required_bits_radix (Base 36)
+ */
+static_assert(ftl::impl::required_bits_radix<36, 2>::value == 11);
+
+/*
+ * required_bits_radix (Base 58)
+ */
+static_assert(ftl::impl::required_bits_radix<58, 2>::value == 12);
+static_assert(ftl::impl::required_bits_radix<58, 32>::value == 188);
+
+/*
+ * required_bits_radix (Base 10, exact at the digit count boundaries)
+ */
+static_assert(ftl::impl::required_bits_radix<10, 1>::value == 4);
+static_assert(ftl::impl::required_bits_radix<10, 3>::value == 10);
+static_assert(ftl::impl::required_bits_radix<10, 39>::value == 130);
+static_assert(ftl::impl::required_bits_radix<10, 78>::value == 260);
+static_assert(ftl::impl::required_bits_radix<10, 200>::value == 665);
+
 /*
  * required_bits_radix (Base 64)
  */
@@ -168,9 +197,9 @@ static_assert(340282366920938463463374607431768211455_10[0] == 0xFFFFFFFF);
 static_assert(340282366920938463463374607431768211455_10[1] == 0xFFFFFFFF);
 static_assert(340282366920938463463374607431768211455_10[2] == 0xFFFFFFFF);
 static_assert(340282366920938463463374607431768211455_10[3] == 0xFFFFFFFF);
-static_assert((340282366920938463463374607431768211455_10).size() == 5);
-static_assert((340282366920938463463374607431768211455_10).bits == 130);
-static_assert((340282366920938463463374607431768211455_10).count == 5);
+static_assert((340282366920938463463374607431768211455_10).size() == 4);
+static_assert((340282366920938463463374607431768211455_10).bits == 128);
+static_assert((340282366920938463463374607431768211455_10).count == 4);
 static_assert((340282366920938463463374607431768211455_10).highest_bit() == 128);
 
 // 256 bit max
@@ -182,9 +211,9 @@ static_assert(115792089237316195423570985008687907853269984665640564039457584007
 static_assert(115792089237316195423570985008687907853269984665640564039457584007913129639935_10[5] == 0xFFFFFFFF);
 static_assert(115792089237316195423570985008687907853269984665640564039457584007913129639935_10[6] == 0xFFFFFFFF);
 static_assert(115792089237316195423570985008687907853269984665640564039457584007913129639935_10[7] == 0xFFFFFFFF);
-static_assert((115792089237316195423570985008687907853269984665640564039457584007913129639935_10).size() == 9);
-static_assert((115792089237316195423570985008687907853269984665640564039457584007913129639935_10).bits == 260);
-static_assert((115792089237316195423570985008687907853269984665640564039457584007913129639935_10).count == 9);
+static_assert((115792089237316195423570985008687907853269984665640564039457584007913129639935_10).size() == 8);
+static_assert((115792089237316195423570985008687907853269984665640564039457584007913129639935_10).bits == 256);
+static_assert((115792089237316195423570985008687907853269984665640564039457584007913129639935_10).count == 8);
 static_assert((115792089237316195423570985008687907853269984665640564039457584007913129639935_10).highest_bit() == 256);
 
 /*
@@ -192,10 +221,48 @@ static_assert((11579208923731619542357098500868790785326998466564056403945758400
  */
 static_assert(0xFFAADF_16[0] == 0x00FFAADF);
 static_assert((0xFFAADF_16).size() == 1);
+static_assert((0xFFAADF_16).bits == 24);
+static_assert((0x0001_16).bits == 1);
+static_assert((0_10).bits == 1);
+static_assert((0_10).highest_bit() == 0);
+static_assert((4294967296_10).bits == 33);
+static_assert((4294967296_10).count == 2);
 static_assert(0x1234567890ABCDEF1234567890abcdef_16[0] == 0x90ABCDEF);
 static_assert(0x1234567890ABCDEF1234567890abcdef_16[1] == 0x12345678);
 static_assert(0x1234567890ABCDEF1234567890abcdef_16[2] == 0x90ABCDEF);
 static_assert(0x1234567890ABCDEF1234567890abcdef_16[3] == 0x12345678);
 static_assert((0x1234567890ABCDEF1234567890abcdef_16).size() == 4);
 
+/*
+ * to_digits
+ */
+static_assert(ftl::to_digits(ftl::bigint<8, std::uint8_t>{ 0 })[0] == 0);
+static_assert(ftl::to_digits(ftl::bigint<16, std::uint8_t>{ 0x39, 0x30 })[0] == '5');
+static_assert(ftl::to_digits(ftl::bigint<16, std::uint8_t>{ 0x39, 0x30 })[4] == '1');
+static_assert([] {
+    constexpr auto digits = ftl::to_digits(340282366920938463463374607431768211455_10);
+    const char expected[] = "554112867134706473364364839029663282043";
+    for (std::size_t i = 0; i < digits.size(); ++i) {
+        if (digits[i] != (i + 1 < sizeof(expected) ? expected[i] : 0)) {
+            return false;
+        }
+    }
+    return digits.size() == 39;
+}());
+static_assert([] {
+    constexpr auto digits = ftl::to_digits<58>(0x010966776006953D5567439E5E39F86A0D273BEED61967F6_16);
+    const char expected[] = "MvjtMw7QBmHfoKvUBqPfQ3csiR9LLwU6";
+    for (std::size_t i = 0; i < digits.size(); ++i) {
+        if (digits[i] != (i + 1 < sizeof(expected) ? expected[i] : 0)) {
+            return false;
+        }
+    }
+    return true;
+}());
+static_assert([] {
+    constexpr auto value = ftl::from_digits<std::uint32_t, 58>(ftl::parse_digits<58>("6UwLL9Risc3QfPqBUvKofHmBQ7wMtjvM"));
+    return value[0] == 0xD61967F6 && value[1] == 0x0D273BEE && value[5] == 0x01096677;
+}());
+static_assert(ftl::to_digits<36>(ftl::from_digits<std::uint8_t, 36>(ftl::parse_digits<36>("ftl0zz")))[3] == 'L');
+
 #endif//FTL_BIGINT_RADIX_HH
\ No newline at end of file
@@ -0,0 +1,259 @@
+#ifndef FTL_BIGINT_ROOT_HH
+#define FTL_BIGINT_ROOT_HH
+
+#include <ftl/bigint_arithmetic_addition.hh>
+#include <ftl/bigint_arithmetic_division.hh>
+#include <ftl/bigint_arithmetic_multiplication.hh>
+#include <ftl/bigint_arithmetic_shift.hh>
+#include <ftl/bigint_base.hh>
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <utility>
+
+namespace ftl {
+namespace impl {
+
+/*
+ * isqrt_wide (Square root of a double limb, rounded down)
+ */
+template<typename W>
+constexpr W isqrt_wide(W n) {
+    if (n < 2) {
+        return n;
+    }
+    unsigned bits = 0;
+    for (W m = n; m != 0; m >>= 1) {
+        ++bits;
+    }
+    W x = W{ 1 } << ((bits + 1) / 2);
+    for (;;) {
+        const W y = (x + n / x) / 2;
+        if (y >= x) {
+            return x;
+        }
+        x = y;
+    }
+}
+
+/*
+ * bigint_from_size
+ */
+template<typename T>
+constexpr auto bigint_from_size(std::size_t value) {
+    bigint<std::numeric_limits<std::size_t>::digits, T> result = {};
+    for (std::size_t i = 0; i < result.count; ++i) {
+        result[i] = static_cast<T>(value);
+        if constexpr (std::numeric_limits<T>::digits < std::numeric_limits<std::size_t>::digits) {
+            value >>= std::numeric_limits<T>::digits;
+        }
+    }
+    return result;
+}
+
+/*
+ * power_capped (x^e, and whether it reached 2^BITS)
+ *
+ * Square-and-multiply from the top bit of 'e'; x >= 1 keeps the partial
+ * powers increasing, so the first that overflows decides.
+ */
+template<std::size_t BITS, typename T>
+constexpr std::pair<bigint<BITS, T>, bool> power_capped(const bigint<BITS, T>& x, std::size_t e) {
+    bigint<BITS, T> result = { one<T>::value };
+    const auto fits = [](const auto& wide) { return resize<BITS>(wide) == wide; };
+    for (std::size_t bit = std::numeric_limits<std::size_t>::digits; bit > 0; --bit) {
+        if ((e >> (bit - 1)) == 0) {
+            continue;
+        }
+        const auto square = multiply(result, result);
+        if (!fits(square)) {
+            return { result, true };
+        }
+        result = resize<BITS>(square);
+        if ((e >> (bit - 1)) & 1) {
+            const auto product = multiply(result, x);
+            if (!fits(product)) {
+                return { result, true };
+            }
+            result = resize<BITS>(product);
+        }
+    }
+    return { result, false };
+}
+
+/*
+ * square_residues (Which residues modulo M are squares)
+ */
+template<std::uint32_t M>
+struct square_residues {
+    static constexpr std::array<bool, M> make() {
+        std::array<bool, M> squares = {};
+        for (std::uint64_t i = 0; i < M; ++i) {
+            squares[i * i % M] = true;
+        }
+        return squares;
+    }
+
+    static constexpr std::array<bool, M> value = make();
+};
+
+/*
+ * modulo_small (n mod m, for m below 2^32)
+ */
+template<std::size_t BITS, typename T>
+constexpr std::uint64_t modulo_small(const bigint<BITS, T>& n, std::uint64_t m) {
+    constexpr unsigned digits = std::numeric_limits<T>::digits;
+    std::uint64_t r = 0;
+    for (std::size_t i = n.count; i > 0; --i) {
+        const std::uint64_t limb = n[i - 1];
+        if constexpr (digits > 32) {
+            r = ((r << 32) | (limb >> 32)) % m;
+            r = ((r << 32) | (limb & 0xFFFFFFFF)) % m;
+        } else {
+            r = ((r << digits) | limb) % m;
+        }
+    }
+    return r;
+}
+
+} //namespace impl
+
+/*
+ * isqrt (Square root, rounded down)
+ *
+ * Newton's iteration x' = (x + n / x) / 2 from above. The seed is the
+ * root of the leading 2 * digits - 2 bits, at the position 'highest_bit'
+ * gives, plus one; it starts with a limb of correct bits, and every
+ * step doubles them.
+ */
+template<std::size_t BITS, typename T>
+constexpr bigint<BITS, T> isqrt(const bigint<BITS, T>& n) {
+    using W = typename impl::bigint_datatype<T>::overflow_type;
+    constexpr std::size_t digits = std::numeric_limits<T>::digits;
+    const std::size_t bits = n.highest_bit();
+    if (bits <= 1) {
+        return n;
+    }
+    const std::size_t shift = bits > 2 * digits - 2 ? (bits - (2 * digits - 2) + 1) / 2 : 0;
+    const bigint<BITS, T> leading = n >> (2 * shift);
+    W m = leading[0];
+    if constexpr (bigint<BITS, T>::count > 1) {
+        m |= static_cast<W>(leading[1]) << digits;
+    }
+    const W root = impl::isqrt_wide(m) + 1;
+    bigint<BITS, T> x = resize<BITS>(bigint<2 * digits, T>{ static_cast<T>(root), static_cast<T>(root >> digits) }) << shift;
+    for (;;) {
+        const bigint<BITS, T> y = resize<BITS>(add(x, divide(n, x)) >> 1);
+        if (!(y < x)) {
+            return x;
+        }
+        x = y;
+    }
+}
+
+/*
+ * iroot (k-th root, rounded down; k >= 1)
+ *
+ * Newton's iteration x' = ((k - 1) x + n / x^(k - 1)) / k from
+ * 2^ceil(highest_bit / k), which is above the root. Powers past 2^BITS
+ * are never formed: the quotient is zero there.
+ */
+template<std::size_t BITS, typename T>
+constexpr bigint<BITS, T> iroot(const bigint<BITS, T>& n, std::size_t k) {
+    const std::size_t bits = n.highest_bit();
+    if (k == 1 || bits == 0) {
+        return n;
+    }
+    if (k == 2) {
+        return isqrt(n);
+    }
+    if (k >= bits) {
+        return bigint<BITS, T>{ one<T>::value };
+    }
+    const auto k_big = impl::bigint_from_size<T>(k);
+    const auto k_less = impl::bigint_from_size<T>(k - 1);
+    bigint<BITS, T> x = bigint<BITS, T>{ one<T>::value } << ((bits + k - 1) / k);
+    for (;;) {
+        const auto power = impl::power_capped(x, k - 1);
+        const bigint<BITS, T> quotient = power.second ? bigint<BITS, T>{} : divide(n, power.first);
+        const bigint<BITS, T> y = resize<BITS>(divide(add(multiply(x, k_less), quotient), k_big));
+        if (!(y < x)) {
+            return x;
+        }
+        x = y;
+    }
+}
+
+/*
+ * is_perfect_square
+ *
+ * Squares are 44 of the 256 residues modulo 256, and modulo
+ * 2^24 - 1 = 63 * 65 * 17 * 241 the factors leave few more; about one
+ * non-square in 400 gets past both to the root.
+ */
+template<std::size_t BITS, typename T>
+constexpr bool is_perfect_square(const bigint<BITS, T>& n) {
+    if (!impl::square_residues<256>::value[n[0] & 0xFF]) {
+        return false;
+    }
+    const std::uint64_t r = impl::modulo_small(n, 0xFFFFFF);
+    if (!impl::square_residues<63>::value[r % 63] || !impl::square_residues<65>::value[r % 65]
+        || !impl::square_residues<17>::value[r % 17] || !impl::square_residues<241>::value[r % 241]) {
+        return false;
+    }
+    const bigint<BITS, T> root = isqrt(n);
+    return multiply(root, root) == n;
+}
+
+/*
+ * is_perfect_power (n = m^k for some k >= 2; true for 0 and 1)
+ *
+ * Only prime exponents need trying, up to 'highest_bit'; the square
+ * test filters by residues first.
+ */
+template<std::size_t BITS, typename T>
+constexpr bool is_perfect_power(const bigint<BITS, T>& n) {
+    const std::size_t bits = n.highest_bit();
+    if (bits <= 1 || is_perfect_square(n)) {
+        return true;
+    }
+    for (std::size_t k = 3; k < bits; k += 2) {
+        bool prime = true;
+        for (std::size_t d = 3; d * d <= k && prime; d += 2) {
+            prime = k % d != 0;
+        }
+        if (!prime) {
+            continue;
+        }
+        const auto power = impl::power_capped(iroot(n, k), k);
+        if (!power.second && power.first == n) {
+            return true;
+        }
+    }
+    return false;
+}
+
+} //namespace ftl
+
+/*
+ * isqrt & iroot
+ */
+static_assert(ftl::isqrt(ftl::bigint<8, std::uint8_t>{ 255 }) == ftl::bigint<8, std::uint8_t>{ 15 });
+static_assert(ftl::isqrt(ftl::bigint<64, std::uint8_t>{ 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF })
+    == ftl::bigint<64, std::uint8_t>{ 0xFF, 0xFF, 0xFF, 0xFF });
+static_assert(ftl::isqrt(ftl::bigint<128, std::uint32_t>{ 0, 0, 0, 1 }) == ftl::bigint<128, std::uint32_t>{ 0, 0x10000 });
+static_assert(ftl::iroot(ftl::bigint<64, std::uint16_t>{ 0x0000, 0x0000, 0x0000, 0x8000 }, 3) == ftl::bigint<64, std::uint16_t>{ 0x0000, 0x0020 });
+static_assert(ftl::iroot(ftl::bigint<64, std::uint16_t>{ 0xFFFF, 0xFFFF, 0xFFFF, 0x7FFF }, 3) == ftl::bigint<64, std::uint16_t>{ 0xFFFF, 0x001F });
+static_assert(ftl::iroot(ftl::bigint<32, std::uint8_t>{ 1, 2, 3, 4 }, 40) == ftl::bigint<32, std::uint8_t>{ 1 });
+
+/*
+ * is_perfect_square & is_perfect_power
+ */
+static_assert(!ftl::is_perfect_square(ftl::bigint<64, std::uint32_t>{ 0xFFFFFFFE, 0x00000001 }));
+static_assert(ftl::is_perfect_square(ftl::bigint<64, std::uint32_t>{ 0x00000001, 0xFFFFFFFE }));
+static_assert(ftl::is_perfect_power(ftl::bigint<64, std::uint8_t>{ 0xCF, 0x4F, 0xD0, 0x00 }));
+static_assert(!ftl::is_perfect_power(ftl::bigint<64, std::uint8_t>{ 0xD0, 0x4F, 0xD0, 0x00 }));
+
+#endif//FTL_BIGINT_ROOT_HH
@@ -0,0 +1,566 @@
+#ifndef FTL_BIGINT_SORT_HH
+#define FTL_BIGINT_SORT_HH
+
+#include <ftl/bigint_base.hh>
+#include <ftl/identity.hh>
+#include <ftl/mpn.hh>
+#include <ftl/parallel.hh>
+#include <ftl/span.hh>
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace ftl {
+namespace impl {
+
+/*
+ * equal
+ *
+ * No early exit: the limbs are folded with XOR and OR, which compiles to
+ * a few vector instructions and no branch until the end.
+ */
+template<std::size_t BITS, typename T>
+constexpr bool equal(const bigint<BITS, T>& a, const bigint<BITS, T>& b) {
+    T diff = 0;
+    for (std::size_t i = 0; i < a.size(); ++i) {
+        diff |= a[i] ^ b[i];
+    }
+    return diff == 0;
+}
+
+/*
+ * no_payload (Payload type of a plain key sort)
+ */
+struct no_payload {};
+
+/*
+ * sort_columns (Byte digits of a BITS bit key)
+ */
+template<std::size_t BITS>
+struct sort_columns : identity<std::size_t, (BITS + 7) / 8> {};
+
+/*
+ * sort_radix (Buckets of a byte digit)
+ */
+struct sort_radix : identity<std::size_t, 256> {};
+
+/*
+ * sort_lsd_columns (Most varying columns sorted bottom-up)
+ *
+ * Every bottom-up pass moves every key, while a top-down pass only splits
+ * runs that are still long, so keys varying in more bytes than this are
+ * sorted from the top.
+ */
+struct sort_lsd_columns : identity<std::size_t, 4> {};
+
+/*
+ * sort_insertion_threshold (Runs short enough for insertion sort)
+ */
+struct sort_insertion_threshold : identity<std::size_t, 32> {};
+
+/*
+ * sort_parallel_threshold (Keys per worker below which a pass is not split)
+ */
+struct sort_parallel_threshold : identity<std::size_t, std::size_t{ 1 } << 16> {};
+
+using sort_histogram = std::array<std::size_t, sort_radix::value>;
+
+/*
+ * sort_digit (Byte 'column' of 'value', least significant first)
+ */
+template<std::size_t BITS, typename T>
+constexpr std::size_t sort_digit(const bigint<BITS, T>& value, std::size_t column) {
+    return static_cast<std::uint8_t>(value[column / sizeof(T)] >> (8 * (column % sizeof(T))));
+}
+
+/*
+ * advance (Payload pointer 'k' items on; a 'no_payload' pointer stays null)
+ */
+template<typename P>
+constexpr P* advance(P* payload, std::size_t k) {
+    if constexpr (std::is_same<P, no_payload>::value) {
+        return payload;
+    } else {
+        return payload + k;
+    }
+}
+
+/*
+ * move_item (Key and payload 'from' to 'to')
+ */
+template<std::size_t BITS, typename T, typename P>
+constexpr void move_item(bigint<BITS, T>* keys_to, P* payload_to, std::size_t to, const bigint<BITS, T>* keys_from, P* payload_from, std::size_t from) {
+    keys_to[to] = keys_from[from];
+    if constexpr (!std::is_same<P, no_payload>::value) {
+        payload_to[to] = std::move(payload_from[from]);
+    }
+}
+
+/*
+ * count_digits
+ */
+template<std::size_t BITS, typename T>
+constexpr void count_digits(const bigint<BITS, T>* values, std::size_t n, std::size_t column, sort_histogram& counts) {
+    for (std::size_t i = 0; i < n; ++i) {
+        ++counts[sort_digit(values[i], column)];
+    }
+}
+
+/*
+ * single_bucket (Every key of the run has the same digit)
+ */
+constexpr bool single_bucket(const sort_histogram& counts, std::size_t n) {
+    for (const std::size_t count : counts) {
+        if (count == n) {
+            return true;
+        }
+    }
+    return false;
+}
+
+/*
+ * exclusive_sum (Counts to the offset each bucket starts at)
+ */
+constexpr void exclusive_sum(sort_histogram& counts) {
+    std::size_t sum = 0;
+    for (std::size_t& count : counts) {
+        const std::size_t c = count;
+        count = sum;
+        sum += c;
+    }
+}
+
+/*
+ * varying_bits (Bits that differ from the first key in some key)
+ *
+ * A zero byte is a column every key agrees on; one read finds them all,
+ * so the passes over constant columns are skipped without counting them.
+ */
+template<std::size_t BITS, typename T>
+constexpr bigint<BITS, T> varying_bits(const bigint<BITS, T>* values, std::size_t first, std::size_t last) {
+    bigint<BITS, T> bits = {};
+    for (std::size_t i = first; i < last; ++i) {
+        for (std::size_t k = 0; k < bits.size(); ++k) {
+            bits[k] |= values[i][k] ^ values[0][k];
+        }
+    }
+    return bits;
+}
+
+/*
+ * next_column (First varying column from 'column' on, or 'sort_columns')
+ */
+template<std::size_t BITS, typename T>
+constexpr std::size_t next_column(const bigint<BITS, T>& varying, std::size_t column) {
+    while (column < sort_columns<BITS>::value && sort_digit(varying, column) == 0) {
+        ++column;
+    }
+    return column;
+}
+
+/*
+ * varying_columns
+ */
+template<std::size_t BITS, typename T>
+constexpr std::size_t varying_columns(const bigint<BITS, T>& varying) {
+    std::size_t count = 0;
+    for (std::size_t column = 0; column < sort_columns<BITS>::value; ++column) {
+        count += sort_digit(varying, column) != 0 ? 1 : 0;
+    }
+    return count;
+}
+
+/*
+ * insertion_sort (Stable)
+ */
+template<std::size_t BITS, typename T, typename P>
+constexpr void insertion_sort(bigint<BITS, T>* keys, P* payload, std::size_t n) {
+    for (std::size_t i = 1; i < n; ++i) {
+        if (mpn::cmp(keys[i].data(), keys[i - 1].data(), keys[i].size()) >= 0) {
+            continue;
+        }
+        const bigint<BITS, T> key = keys[i];
+        P value = {};
+        if constexpr (!std::is_same<P, no_payload>::value) {
+            value = std::move(payload[i]);
+        }
+        std::size_t j = i;
+        for (; j > 0 && mpn::cmp(key.data(), keys[j - 1].data(), key.size()) < 0; --j) {
+            move_item(keys, payload, j, keys, payload, j - 1);
+        }
+        move_item(keys, payload, j, &key, &value, 0);
+    }
+}
+
+/*
+ * lsd_sort (Bottom-up, one pass per varying column)
+ *
+ * The histogram of the next varying column is counted while the current
+ * one is scattered, so each pass reads the keys once.
+ */
+template<std::size_t BITS, typename T, typename P>
+constexpr void lsd_sort(bigint<BITS, T>* keys, bigint<BITS, T>* key_scratch, P* payload, P* payload_scratch, std::size_t n, const bigint<BITS, T>& varying) {
+    constexpr std::size_t columns = sort_columns<BITS>::value;
+    bigint<BITS, T>* src = keys;
+    bigint<BITS, T>* dst = key_scratch;
+    P* payload_src = payload;
+    P* payload_dst = payload_scratch;
+    sort_histogram counts = {};
+    std::size_t column = next_column(varying, 0);
+    if (column < columns) {
+        count_digits(src, n, column, counts);
+    }
+    while (column < columns) {
+        const std::size_t next = next_column(varying, column + 1);
+        sort_histogram offsets = counts;
+        exclusive_sum(offsets);
+        counts = {};
+        for (std::size_t i = 0; i < n; ++i) {
+            move_item(dst, payload_dst, offsets[sort_digit(src[i], column)]++, src, payload_src, i);
+            if (next < columns) {
+                ++counts[sort_digit(src[i], next)];
+            }
+        }
+        bigint<BITS, T>* const keys_sorted = dst;
+        dst = src;
+        src = keys_sorted;
+        P* const payload_sorted = payload_dst;
+        payload_dst = payload_src;
+        payload_src = payload_sorted;
+        column = next;
+    }
+    if (src != keys) {
+        for (std::size_t i = 0; i < n; ++i) {
+            move_item(keys, payload, i, src, payload_src, i);
+        }
+    }
+}
+
+/*
+ * msd_sort (Top-down below 'column')
+ *
+ * The run in 'a' is scattered to 'b' by its highest byte that is not the
+ * same in every key, and each bucket is sorted on the bytes below with the
+ * two buffers swapped, so no pass copies back; 'into_b' tells which buffer
+ * ends up with the sorted run. Short runs are insertion sorted.
+ */
+template<std::size_t BITS, typename T, typename P>
+constexpr void msd_sort(bigint<BITS, T>* a, bigint<BITS, T>* b, P* payload_a, P* payload_b, std::size_t n, std::size_t column, const bigint<BITS, T>& varying, bool into_b) {
+    while (n > sort_insertion_threshold::value && column != 0) {
+        --column;
+        if (sort_digit(varying, column) == 0) {
+            continue;
+        }
+        sort_histogram offsets = {};
+        count_digits(a, n, column, offsets);
+        if (single_bucket(offsets, n)) {
+            continue;
+        }
+        exclusive_sum(offsets);
+        for (std::size_t i = 0; i < n; ++i) {
+            move_item(b, payload_b, offsets[sort_digit(a[i], column)]++, a, payload_a, i);
+        }
+        std::size_t begin = 0;
+        for (const std::size_t end : offsets) {
+            msd_sort(b + begin, a + begin, advance(payload_b, begin), advance(payload_a, begin), end - begin, column, varying, !into_b);
+            begin = end;
+        }
+        return;
+    }
+    insertion_sort(a, payload_a, n);
+    if (into_b) {
+        for (std::size_t i = 0; i < n; ++i) {
+            move_item(b, payload_b, i, a, payload_a, i);
+        }
+    }
+}
+
+/*
+ * radix_sort (Serial)
+ */
+template<std::size_t BITS, typename T, typename P>
+constexpr void radix_sort(bigint<BITS, T>* keys, bigint<BITS, T>* key_scratch, P* payload, P* payload_scratch, std::size_t n) {
+    if (n < 2) {
+        return;
+    }
+    const bigint<BITS, T> varying = varying_bits(keys, 1, n);
+    if (varying_columns(varying) <= sort_lsd_columns::value) {
+        lsd_sort(keys, key_scratch, payload, payload_scratch, n, varying);
+    } else {
+        msd_sort(keys, key_scratch, payload, payload_scratch, n, sort_columns<BITS>::value, varying, false);
+    }
+}
+
+/*
+ * scatter_parallel (One stable pass of 'column' from 'src' to 'dst')
+ *
+ * Each worker counts and then scatters a contiguous run of the keys. The
+ * run of worker w starts digit d after every key with a smaller digit and
+ * after the d keys of workers before w. Returns where each bucket ends.
+ */
+template<std::size_t BITS, typename T, typename P>
+sort_histogram scatter_parallel(const bigint<BITS, T>* src, bigint<BITS, T>* dst, P* payload_src, P* payload_dst, std::size_t n, std::size_t column, std::vector<sort_histogram>& counts) {
+    const std::size_t threads = counts.size();
+    const auto begin = [n, threads](std::size_t worker) { return n * worker / threads; };
+    parallel_invoke(threads, [&](std::size_t worker) {
+        counts[worker] = {};
+        count_digits(src + begin(worker), begin(worker + 1) - begin(worker), column, counts[worker]);
+    });
+    std::size_t sum = 0;
+    for (std::size_t digit = 0; digit < sort_radix::value; ++digit) {
+        for (auto& worker_counts : counts) {
+            const std::size_t count = worker_counts[digit];
+            worker_counts[digit] = sum;
+            sum += count;
+        }
+    }
+    parallel_invoke(threads, [&](std::size_t worker) {
+        sort_histogram& offsets = counts[worker];
+        for (std::size_t i = begin(worker); i < begin(worker + 1); ++i) {
+            move_item(dst, payload_dst, offsets[sort_digit(src[i], column)]++, src, payload_src, i);
+        }
+    });
+    return counts.back();
+}
+
+/*
+ * radix_sort_parallel
+ *
+ * Bottom-up, every pass is split over the workers. Top-down, the first
+ * pass is, and the buckets it leaves are then sorted serially and handed
+ * out by work stealing.
+ */
+template<std::size_t BITS, typename T, typename P>
+void radix_sort_parallel(bigint<BITS, T>* keys, bigint<BITS, T>* key_scratch, P* payload, P* payload_scratch, std::size_t n, std::size_t threads) {
+    constexpr std::size_t columns = sort_columns<BITS>::value;
+    threads = std::min(threads, n / sort_parallel_threshold::value);
+    if (threads <= 1) {
+        radix_sort(keys, key_scratch, payload, payload_scratch, n);
+        return;
+    }
+    std::vector<bigint<BITS, T>> worker_varying(threads);
+    parallel_invoke(threads, [&](std::size_t worker) {
+        worker_varying[worker] = varying_bits(keys, n * worker / threads, n * (worker + 1) / threads);
+    });
+    bigint<BITS, T> varying = {};
+    for (const auto& bits : worker_varying) {
+        for (std::size_t k = 0; k < varying.size(); ++k) {
+            varying[k] |= bits[k];
+        }
+    }
+    std::vector<sort_histogram> counts(threads);
+    if (varying_columns(varying) > sort_lsd_columns::value) {
+        std::size_t column = columns - 1;
+        while (sort_digit(varying, column) == 0) {
+            --column;
+        }
+        const sort_histogram ends = scatter_parallel(keys, key_scratch, payload, payload_scratch, n, column, counts);
+        parallel_for(sort_radix::value, 1, threads, [&](std::size_t first, std::size_t last) {
+            for (std::size_t digit = first; digit < last; ++digit) {
+                const std::size_t begin = digit == 0 ? 0 : ends[digit - 1];
+                msd_sort(key_scratch + begin, keys + begin, advance(payload_scratch, begin), advance(payload, begin),
+                    ends[digit] - begin, column, varying, true);
+            }
+        });
+        return;
+    }
+    bigint<BITS, T>* src = keys;
+    bigint<BITS, T>* dst = key_scratch;
+    P* payload_src = payload;
+    P* payload_dst = payload_scratch;
+    for (std::size_t column = next_column(varying, 0); column < columns; column = next_column(varying, column + 1)) {
+        scatter_parallel(src, dst, payload_src, payload_dst, n, column, counts);
+        std::swap(src, dst);
+        std::swap(payload_src, payload_dst);
+    }
+    if (src != keys) {
+        parallel_invoke(threads, [&](std::size_t worker) {
+            for (std::size_t i = n * worker / threads; i < n * (worker + 1) / threads; ++i) {
+                move_item(keys, payload, i, src, payload_src, i);
+            }
+        });
+    }
+}
+
+} //namespace impl
+
+/*
+ * sort (Radix Sort)
+ *
+ * Stable byte passes between 'values' and 'scratch'. One read first finds
+ * the bytes that are the same in every key, and those are never sorted
+ * on. Keys that differ in a few bytes, such as small values or values
+ * sharing a prefix, take one bottom-up pass per differing byte; keys that
+ * differ in more are split top-down, byte by byte, until the runs are
+ * short. 'scratch' holds at least as many keys as 'values'; the sorted
+ * keys end up in 'values'.
+ */
+template<std::size_t BITS, typename T>
+constexpr void sort(span<bigint<BITS, T>> values, span<bigint<BITS, T>> scratch) {
+    impl::radix_sort<BITS, T, impl::no_payload>(values.data(), scratch.data(), nullptr, nullptr, values.size());
+}
+
+template<std::size_t BITS, typename T>
+void sort(span<bigint<BITS, T>> values) {
+    std::vector<bigint<BITS, T>> scratch(values.size());
+    impl::radix_sort<BITS, T, impl::no_payload>(values.data(), scratch.data(), nullptr, nullptr, values.size());
+}
+
+/*
+ * sort (Parallel)
+ */
+template<std::size_t BITS, typename T>
+void sort(span<bigint<BITS, T>> values, std::size_t threads) {
+    std::vector<bigint<BITS, T>> scratch(values.size());
+    impl::radix_sort_parallel<BITS, T, impl::no_payload>(values.data(), scratch.data(), nullptr, nullptr, values.size(), threads);
+}
+
+/*
+ * sort_by_key (Payload i moves with key i)
+ *
+ * Stable, so the payloads of equal keys keep their order.
+ */
+template<std::size_t BITS, typename T, typename P>
+constexpr void sort_by_key(span<bigint<BITS, T>> keys, span<P> payload, span<bigint<BITS, T>> key_scratch, span<P> payload_scratch) {
+    impl::radix_sort(keys.data(), key_scratch.data(), payload.data(), payload_scratch.data(), keys.size());
+}
+
+template<std::size_t BITS, typename T, typename P>
+void sort_by_key(span<bigint<BITS, T>> keys, span<P> payload) {
+    std::vector<bigint<BITS, T>> key_scratch(keys.size());
+    std::vector<P> payload_scratch(keys.size());
+    impl::radix_sort(keys.data(), key_scratch.data(), payload.data(), payload_scratch.data(), keys.size());
+}
+
+template<std::size_t BITS, typename T, typename P>
+void sort_by_key(span<bigint<BITS, T>> keys, span<P> payload, std::size_t threads) {
+    std::vector<bigint<BITS, T>> key_scratch(keys.size());
+    std::vector<P> payload_scratch(keys.size());
+    impl::radix_sort_parallel(keys.data(), key_scratch.data(), payload.data(), payload_scratch.data(), keys.size(), threads);
+}
+
+/*
+ * unique (Keeps the first of each run of equal keys, returns how many are kept)
+ *
+ * Nothing is written before the first duplicate, and every key is checked
+ * against its original neighbour rather than the last one kept, so a load
+ * never waits on the store just before it.
+ */
+template<std::size_t BITS, typename T>
+constexpr std::size_t unique(span<bigint<BITS, T>> values) {
+    std::size_t i = 1;
+    while (i < values.size() && !impl::equal(values[i], values[i - 1])) {
+        ++i;
+    }
+    if (i >= values.size()) {
+        return values.size();
+    }
+    std::size_t kept = i;
+    for (++i; i < values.size(); ++i) {
+        if (!impl::equal(values[i], values[i - 1])) {
+            values[kept++] = values[i];
+        }
+    }
+    return kept;
+}
+
+/*
+ * lower_bound (Index of the first key not less than 'key' in sorted 'values')
+ *
+ * Branch-free halving: the comparison picks the next base with a
+ * conditional move instead of a mispredicted jump, and at run time both
+ * possible next probes are prefetched.
+ */
+template<std::size_t BITS, typename T>
+constexpr std::size_t lower_bound(span<const bigint<BITS, T>> values, const bigint<BITS, T>& key) {
+    if (values.empty()) {
+        return 0;
+    }
+    const bigint<BITS, T>* base = values.data();
+    std::size_t n = values.size();
+    while (n > 1) {
+        const std::size_t half = n / 2;
+        if (!__builtin_is_constant_evaluated()) {
+            __builtin_prefetch(base + half / 2);
+            __builtin_prefetch(base + half + half / 2);
+        }
+        base = mpn::cmp(base[half].data(), key.data(), key.size()) < 0 ? base + half : base;
+        n -= half;
+    }
+    return static_cast<std::size_t>(base - values.data()) + (mpn::cmp(base->data(), key.data(), key.size()) < 0 ? 1 : 0);
+}
+
+}//namespace ftl
+
+/*
+ * sort
+ */
+static_assert([] {
+    std::array<ftl::bigint<40, std::uint16_t>, 6> values = { {
+        { 0x0003, 0x0000, 0x01 }, { 0x0100, 0x0000, 0x00 }, { 0xFFFF, 0xFFFF, 0x00 },
+        { 0x0001, 0x0000, 0x01 }, { 0x0000, 0x0000, 0x00 }, { 0x0002, 0x0000, 0x00 },
+    } };
+    std::array<ftl::bigint<40, std::uint16_t>, 6> scratch = {};
+    ftl::sort<40, std::uint16_t>(values, scratch);
+    return values[0][0] == 0 && values[1][0] == 2 && values[2][0] == 0x100 && values[3][1] == 0xFFFF
+        && values[4][0] == 1 && values[4][2] == 1 && values[5][0] == 3;
+}());
+static_assert([] {
+    std::array<ftl::bigint<64, std::uint64_t>, 4> values = { { { 7 }, { 5 }, { 7 }, { 1 } } };
+    std::array<ftl::bigint<64, std::uint64_t>, 4> scratch = {};
+    ftl::sort<64, std::uint64_t>(values, scratch);
+    return values[0][0] == 1 && values[1][0] == 5 && values[2][0] == 7 && values[3][0] == 7;
+}());
+static_assert([] {
+    std::array<ftl::bigint<64, std::uint32_t>, 40> values = {};
+    for (std::uint32_t i = 0; i < values.size(); ++i) {
+        values[i] = { (i * 0x9E3779B9u) ^ 0x5A5A5A5Au, (i * 0x85EBCA6Bu) % 7 };
+    }
+    std::array<ftl::bigint<64, std::uint32_t>, 40> scratch = {};
+    ftl::sort<64, std::uint32_t>(values, scratch);
+    for (std::size_t i = 1; i < values.size(); ++i) {
+        if (ftl::mpn::cmp(values[i - 1].data(), values[i].data(), 2) > 0) {
+            return false;
+        }
+    }
+    return true;
+}());
+
+/*
+ * sort_by_key
+ */
+static_assert([] {
+    std::array<ftl::bigint<16, std::uint8_t>, 5> keys = { { { 2, 1 }, { 0, 1 }, { 2, 1 }, { 9, 0 }, { 0, 1 } } };
+    std::array<int, 5> payload = { 0, 1, 2, 3, 4 };
+    std::array<ftl::bigint<16, std::uint8_t>, 5> key_scratch = {};
+    std::array<int, 5> payload_scratch = {};
+    ftl::sort_by_key<16, std::uint8_t, int>(keys, payload, key_scratch, payload_scratch);
+    return payload[0] == 3 && payload[1] == 1 && payload[2] == 4 && payload[3] == 0 && payload[4] == 2
+        && keys[0][0] == 9 && keys[4][0] == 2;
+}());
+
+/*
+ * unique
+ */
+static_assert([] {
+    std::array<ftl::bigint<64>, 6> values = { { { 1 }, { 1 }, { 2, 1 }, { 2, 1 }, { 2, 1 }, { 3, 1 } } };
+    return ftl::unique<64, std::uint32_t>(values) == 3 && values[1][1] == 1 && values[2][0] == 3;
+}());
+
+/*
+ * lower_bound
+ */
+static_assert([] {
+    const std::array<ftl::bigint<64>, 5> values = { { { 1 }, { 3 }, { 3 }, { 0, 1 }, { 5, 1 } } };
+    const ftl::span<const ftl::bigint<64>> sorted(values);
+    return ftl::lower_bound(sorted, ftl::bigint<64>{ 0 }) == 0 && ftl::lower_bound(sorted, ftl::bigint<64>{ 3 }) == 1
+        && ftl::lower_bound(sorted, ftl::bigint<64>{ 4 }) == 3 && ftl::lower_bound(sorted, ftl::bigint<64>{ 5, 1 }) == 4
+        && ftl::lower_bound(sorted, ftl::bigint<64>{ 6, 1 }) == 5;
+}());
+
+#endif//FTL_BIGINT_SORT_HH
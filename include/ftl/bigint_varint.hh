@@ -0,0 +1,324 @@
+#ifndef FTL_BIGINT_VARINT_HH
+#define FTL_BIGINT_VARINT_HH
+
+#include <ftl/bigint_base.hh>
+#include <ftl/identity.hh>
+#include <ftl/span.hh>
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <system_error>
+
+#if defined(__AVX2__) || defined(__BMI2__)
+#include <immintrin.h>
+#endif
+
+namespace ftl {
+
+/*
+ * varint_result (End of the input read, values decoded and status)
+ */
+struct varint_result {
+    const std::byte* ptr;
+    std::size_t count;
+    std::errc ec;
+};
+
+namespace impl {
+
+/*
+ * max_varint_size (Bytes of the longest encoding)
+ */
+template<std::size_t BITS, typename T>
+struct max_varint_size : identity<
+    std::size_t,
+    (required_elements<T, BITS>::value * std::numeric_limits<T>::digits + 6) / 7
+> {};
+
+/*
+ * varint_groups (Low 7 bits of each byte, 0x7F7F...)
+ */
+struct varint_groups : identity<std::uint64_t, 0x7F7F7F7F7F7F7F7FULL> {};
+
+/*
+ * load_bits (At least 57 bits starting at 'pos', zero past the end)
+ */
+template<typename T, std::size_t N>
+constexpr std::uint64_t load_bits(const std::array<T, N>& limbs, std::size_t pos) {
+    constexpr std::size_t digits = std::numeric_limits<T>::digits;
+    std::size_t i = pos / digits;
+    if (i >= N) {
+        return 0;
+    }
+    std::uint64_t bits = static_cast<std::uint64_t>(limbs[i] >> (pos % digits));
+    for (std::size_t shift = digits - pos % digits; shift < 64 && ++i < N; shift += digits) {
+        bits |= static_cast<std::uint64_t>(limbs[i]) << shift;
+    }
+    return bits;
+}
+
+/*
+ * store_bits (OR 'bits' in at 'pos'; false if any falls past the limbs)
+ */
+template<typename T, std::size_t N>
+constexpr bool store_bits(std::array<T, N>& limbs, std::size_t pos, std::uint64_t bits) {
+    constexpr std::size_t digits = std::numeric_limits<T>::digits;
+    while (bits != 0) {
+        const std::size_t i = pos / digits;
+        if (i >= N) {
+            return false;
+        }
+        limbs[i] |= static_cast<T>(bits << (pos % digits));
+        const std::size_t taken = digits - pos % digits;
+        bits = taken >= 64 ? 0 : bits >> taken;
+        pos += taken;
+    }
+    return true;
+}
+
+/*
+ * load_bytes (Little-endian word of up to 8 bytes)
+ */
+constexpr std::uint64_t load_bytes(const std::byte* p, std::size_t count) {
+    std::uint64_t word = 0;
+    for (std::size_t k = 0; k < count && k < 8; ++k) {
+        word |= std::to_integer<std::uint64_t>(p[k]) << (8 * k);
+    }
+    return word;
+}
+
+/*
+ * store_bytes
+ */
+constexpr void store_bytes(std::byte* p, std::uint64_t word, std::size_t count) {
+    for (std::size_t k = 0; k < count; ++k) {
+        p[k] = static_cast<std::byte>(word >> (8 * k));
+    }
+}
+
+/*
+ * spread_groups (56 bits into the low 7 bits of 8 bytes)
+ */
+constexpr std::uint64_t spread_groups(std::uint64_t bits) {
+#if defined(__BMI2__)
+    if (!__builtin_is_constant_evaluated()) {
+        return _pdep_u64(bits, varint_groups::value);
+    }
+#endif
+    std::uint64_t word = 0;
+    for (std::size_t k = 0; k < 8; ++k) {
+        word |= ((bits >> (7 * k)) & 0x7F) << (8 * k);
+    }
+    return word;
+}
+
+/*
+ * gather_groups (Inverse of 'spread_groups')
+ */
+constexpr std::uint64_t gather_groups(std::uint64_t word) {
+#if defined(__BMI2__)
+    if (!__builtin_is_constant_evaluated()) {
+        return _pext_u64(word, varint_groups::value);
+    }
+#endif
+    std::uint64_t bits = 0;
+    for (std::size_t k = 0; k < 8; ++k) {
+        bits |= ((word >> (8 * k)) & 0x7F) << (7 * k);
+    }
+    return bits;
+}
+
+/*
+ * assemble_varint (Value of the 'size' bytes of one encoding)
+ */
+template<std::size_t BITS, typename T>
+constexpr bool assemble_varint(const std::byte* p, std::size_t size, bigint<BITS, T>& out) {
+    std::array<T, required_elements<T, BITS>::value> limbs = {};
+    for (std::size_t g = 0; 8 * g < size; ++g) {
+        const std::size_t count = std::min<std::size_t>(8, size - 8 * g);
+        if (!store_bits(limbs, 56 * g, gather_groups(load_bytes(p + 8 * g, count)))) {
+            return false;
+        }
+    }
+    if (BITS % std::numeric_limits<T>::digits != 0
+        && (limbs[limbs.size() - 1] >> (BITS % std::numeric_limits<T>::digits)) != 0) {
+        return false;
+    }
+    for (std::size_t i = 0; i < limbs.size(); ++i) {
+        out[i] = limbs[i];
+    }
+    return true;
+}
+
+} //namespace impl
+
+/*
+ * varint_size (Bytes of the encoding of 'value')
+ */
+template<std::size_t BITS, typename T>
+constexpr std::size_t varint_size(const bigint<BITS, T>& value) {
+    const std::size_t bits = value.highest_bit();
+    return bits == 0 ? 1 : (bits + 6) / 7;
+}
+
+/*
+ * encode_varint (Unsigned LEB128)
+ *
+ * Seven bits per byte, least significant first, the high bit set on all
+ * but the last byte; leading zero limbs cost nothing, so small values take
+ * one or two bytes whatever BITS is. 'out' needs 'varint_size' bytes.
+ */
+template<std::size_t BITS, typename T>
+constexpr std::byte* encode_varint(const bigint<BITS, T>& value, std::byte* out) {
+    const std::size_t size = varint_size(value);
+    for (std::size_t g = 0; 8 * g < size; ++g) {
+        const std::size_t count = std::min<std::size_t>(8, size - 8 * g);
+        std::uint64_t word = impl::spread_groups(impl::load_bits(value, 56 * g)) | ~impl::varint_groups::value;
+        if (8 * g + count == size) {
+            word &= ~(std::uint64_t{ 0x80 } << (8 * (count - 1)));
+        }
+        impl::store_bytes(out + 8 * g, word, count);
+    }
+    return out + size;
+}
+
+/*
+ * decode_varint
+ *
+ * 'invalid_argument' if the input ends inside an encoding, and
+ * 'result_out_of_range' if the value does not fit in BITS bits; 'out' is
+ * only written on success.
+ */
+template<std::size_t BITS, typename T>
+constexpr varint_result decode_varint(const std::byte* first, const std::byte* last, bigint<BITS, T>& out) {
+    const std::byte* p = first;
+    while (p != last && (std::to_integer<std::uint8_t>(*p) & 0x80) != 0) {
+        ++p;
+    }
+    if (p == last) {
+        return { first, 0, std::errc::invalid_argument };
+    }
+    ++p;
+    if (!impl::assemble_varint(first, static_cast<std::size_t>(p - first), out)) {
+        return { p, 0, std::errc::result_out_of_range };
+    }
+    return { p, 1, std::errc{} };
+}
+
+/*
+ * encode_varints (Batch)
+ *
+ * 'out' needs the sum of the values' 'varint_size', at most
+ * 'max_varint_size' bytes each. Encodes value by value: with BMI2 each
+ * 56 bits are one 'pdep', and lengths that differ per value leave vector
+ * lanes nothing to share, so only decoding has a SIMD path.
+ */
+template<std::size_t BITS, typename T>
+constexpr std::byte* encode_varints(span<const bigint<BITS, T>> values, std::byte* out) {
+    for (const auto& value : values) {
+        out = encode_varint(value, out);
+    }
+    return out;
+}
+
+/*
+ * decode_varints (Batch)
+ *
+ * Decodes until 'out' is full or the input ends. With AVX2, 64 bytes are
+ * classified at a time: the sign bits give the continuation mask, and the
+ * end of every encoding in the block falls out of its complement without
+ * a per-byte branch.
+ */
+template<std::size_t BITS, typename T>
+varint_result decode_varints(span<const std::byte> in, span<bigint<BITS, T>> out) {
+    const std::byte* p = in.data();
+    const std::byte* const last = in.data() + in.size();
+    std::size_t count = 0;
+    while (count < out.size() && p != last) {
+#if defined(__AVX2__)
+        if (last - p >= 64) {
+            const __m256i lo = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p));
+            const __m256i hi = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p + 32));
+            std::uint64_t ends = ~(static_cast<std::uint32_t>(_mm256_movemask_epi8(lo))
+                | (static_cast<std::uint64_t>(static_cast<std::uint32_t>(_mm256_movemask_epi8(hi))) << 32));
+            std::size_t start = 0;
+            while (ends != 0 && count < out.size()) {
+                const std::size_t end = static_cast<std::size_t>(__builtin_ctzll(ends)) + 1;
+                if (!impl::assemble_varint(p + start, end - start, out[count])) {
+                    return { p + end, count, std::errc::result_out_of_range };
+                }
+                ++count;
+                start = end;
+                ends &= ends - 1;
+            }
+            if (start != 0) {
+                p += start;
+                continue;
+            }
+        }
+#endif
+        const varint_result result = decode_varint(p, last, out[count]);
+        if (result.ec != std::errc{}) {
+            return { result.ptr, count, result.ec };
+        }
+        p = result.ptr;
+        ++count;
+    }
+    return { p, count, std::errc{} };
+}
+
+}//namespace ftl
+
+/*
+ * max_varint_size
+ */
+static_assert(ftl::impl::max_varint_size<256, std::uint32_t>::value == 37);
+static_assert(ftl::impl::max_varint_size<7, std::uint8_t>::value == 2);
+
+/*
+ * spread_groups & gather_groups
+ */
+static_assert(ftl::impl::spread_groups(0x3FFF) == 0x7F7F);
+static_assert(ftl::impl::gather_groups(ftl::impl::spread_groups(0x00ABCDEF01234567)) == 0x00ABCDEF01234567);
+
+/*
+ * encode_varint & decode_varint
+ */
+static_assert([] {
+    std::array<std::byte, 8> bytes = {};
+    const auto end = ftl::encode_varint(ftl::bigint<64, std::uint8_t>{ 0x65, 0x87, 0x09 }, bytes.data());
+    return end == bytes.data() + 3
+        && bytes[0] == std::byte{ 0xE5 } && bytes[1] == std::byte{ 0x8E } && bytes[2] == std::byte{ 0x26 };
+}());
+static_assert([] {
+    std::array<std::byte, 8> bytes = {};
+    const auto end = ftl::encode_varint(ftl::bigint<256>{}, bytes.data());
+    return end == bytes.data() + 1 && bytes[0] == std::byte{ 0 };
+}());
+static_assert([] {
+    const std::array<std::byte, 3> bytes = { std::byte{ 0xE5 }, std::byte{ 0x8E }, std::byte{ 0x26 } };
+    ftl::bigint<32, std::uint16_t> value = {};
+    const auto result = ftl::decode_varint(bytes.data(), bytes.data() + bytes.size(), value);
+    return result.ec == std::errc{} && result.ptr == bytes.data() + 3 && value[0] == 0x8765 && value[1] == 0x9;
+}());
+static_assert([] {
+    const std::array<std::byte, 3> bytes = { std::byte{ 0xE5 }, std::byte{ 0x8E }, std::byte{ 0x26 } };
+    ftl::bigint<16, std::uint16_t> narrow = {};
+    ftl::bigint<64> wide = {};
+    return ftl::decode_varint(bytes.data(), bytes.data() + 3, narrow).ec == std::errc::result_out_of_range
+        && ftl::decode_varint(bytes.data(), bytes.data() + 2, wide).ec == std::errc::invalid_argument;
+}());
+static_assert([] {
+    const ftl::bigint<256, std::uint32_t> value = { 0x89ABCDEF, 0x01234567, 0, 0, 0, 0, 0, 0x80000000 };
+    std::array<std::byte, ftl::impl::max_varint_size<256, std::uint32_t>::value> bytes = {};
+    const auto end = ftl::encode_varint(value, bytes.data());
+    ftl::bigint<256, std::uint32_t> back = {};
+    const auto result = ftl::decode_varint(bytes.data(), end, back);
+    return end == bytes.data() + 37 && result.ptr == end
+        && back[0] == value[0] && back[1] == value[1] && back[7] == value[7];
+}());
+
+#endif//FTL_BIGINT_VARINT_HH
@@ -0,0 +1,482 @@
+#ifndef FTL_BIGINT_VIEW_HH
+#define FTL_BIGINT_VIEW_HH
+
+#include <ftl/bigint_base.hh>
+#include <ftl/charconv.hh>
+#include <ftl/endian.hh>
+#include <ftl/mpn.hh>
+#include <ftl/radix.hh>
+#include <ftl/span.hh>
+
+#include <algorithm>
+#include <array>
+#include <charconv>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <system_error>
+#include <utility>
+#include <vector>
+
+namespace ftl {
+
+/*
+ * bigint_view (Non-owning, read-only limbs, least significant first)
+ */
+template<typename T>
+class bigint_view {
+public:
+    using value_type = T;
+
+    constexpr bigint_view() = default;
+
+    constexpr bigint_view(const T* limbs, std::size_t count) :
+        limbs_(limbs), count_(count)
+    {}
+
+    template<std::size_t BITS>
+    constexpr bigint_view(const bigint<BITS, T>& value) :
+        limbs_(value.data()), count_(value.size())
+    {}
+
+    constexpr const T* data() const { return limbs_; }
+    constexpr std::size_t size() const { return count_; }
+    constexpr const T& operator[](std::size_t i) const { return limbs_[i]; }
+    constexpr const T* begin() const { return limbs_; }
+    constexpr const T* end() const { return limbs_ + count_; }
+
+    /*
+     * significant (Limb count without leading zero limbs)
+     */
+    constexpr std::size_t significant() const {
+        std::size_t n = count_;
+        while (n > 0 && limbs_[n - 1] == zero<T>::value) {
+            --n;
+        }
+        return n;
+    }
+
+    constexpr std::size_t highest_bit() const {
+        const std::size_t n = significant();
+        if (n == 0) {
+            return 0;
+        }
+        std::size_t j = std::numeric_limits<T>::digits;
+        while ((limbs_[n - 1] & (T{ 1 } << (j - 1))) == 0) {
+            --j;
+        }
+        return (n - 1) * std::numeric_limits<T>::digits + j;
+    }
+
+private:
+    const T* limbs_ = nullptr;
+    std::size_t count_ = 0;
+};
+
+/*
+ * compare (-1, 0 or 1; views of different lengths compare by value)
+ */
+template<typename T>
+constexpr int compare(bigint_view<T> a, bigint_view<T> b) {
+    const std::size_t n = a.significant();
+    const std::size_t m = b.significant();
+    if (n != m) {
+        return n < m ? -1 : 1;
+    }
+    return mpn::cmp(a.data(), b.data(), n);
+}
+
+/*
+ * Comparison Operators (bigint_view)
+ */
+template<typename T>
+constexpr bool operator==(bigint_view<T> a, bigint_view<T> b) { return compare(a, b) == 0; }
+
+template<typename T>
+constexpr bool operator!=(bigint_view<T> a, bigint_view<T> b) { return compare(a, b) != 0; }
+
+template<typename T>
+constexpr bool operator<(bigint_view<T> a, bigint_view<T> b) { return compare(a, b) < 0; }
+
+template<typename T>
+constexpr bool operator<=(bigint_view<T> a, bigint_view<T> b) { return compare(a, b) <= 0; }
+
+template<typename T>
+constexpr bool operator>(bigint_view<T> a, bigint_view<T> b) { return compare(a, b) > 0; }
+
+template<typename T>
+constexpr bool operator>=(bigint_view<T> a, bigint_view<T> b) { return compare(a, b) >= 0; }
+
+/*
+ * modulo (Single limb divisor, without forming the quotient)
+ */
+template<typename T>
+constexpr T modulo(bigint_view<T> a, T b) {
+    using OverflowType = typename impl::bigint_datatype<T>::overflow_type;
+    OverflowType remainder = zero<OverflowType>::value;
+    for (std::size_t i = a.size(); i > 0; --i) {
+        remainder = ((remainder << std::numeric_limits<T>::digits) | a[i - 1]) % b;
+    }
+    return static_cast<T>(remainder);
+}
+
+/*
+ * resize (Copy a view into a bigint, zero extended or truncated)
+ */
+template<std::size_t BITS, typename T>
+constexpr auto resize(bigint_view<T> value) {
+    std::array<T, impl::required_elements<T, BITS>::value> result = {};
+    for (std::size_t i = 0; i < result.size() && i < value.size(); ++i) {
+        result[i] = value[i];
+    }
+    if (BITS % std::numeric_limits<T>::digits != 0) {
+        result[result.size() - 1] &= static_cast<T>((T{ 1 } << (BITS % std::numeric_limits<T>::digits)) - 1);
+    }
+    return bigint<BITS, T>{ result };
+}
+
+/*
+ * add, multiply & divmod (bigint_view)
+ *
+ * Arithmetic that reads views in place and writes an owning bigint of
+ * BITS bits. Sums and products are taken modulo 2^BITS, as with
+ * 'add_in_place', so only the low limbs of the inputs are read; 'divmod'
+ * needs a dividend below 2^BITS, and like the bigint 'divmod' gives zero
+ * for both results when the divisor is zero.
+ */
+template<std::size_t BITS, typename T>
+constexpr bigint<BITS, T> add(bigint_view<T> a, bigint_view<T> b) {
+    constexpr std::size_t n = impl::required_elements<T, BITS>::value;
+    std::array<T, n> result = {};
+    for (std::size_t i = 0; i < n && i < a.size(); ++i) {
+        result[i] = a[i];
+    }
+    const std::size_t bn = std::min(b.significant(), n);
+    const T carry = mpn::add_n(result.data(), result.data(), b.data(), bn);
+    mpn::add_1(result.data() + bn, result.data() + bn, n - bn, carry);
+    impl::mask_top_limb<BITS>(result);
+    return bigint<BITS, T>{ result };
+}
+
+template<std::size_t BITS, typename T>
+constexpr bigint<BITS, T> multiply(bigint_view<T> a, bigint_view<T> b) {
+    constexpr std::size_t n = impl::required_elements<T, BITS>::value;
+    std::array<T, n> result = {};
+    const std::size_t an = std::min(a.significant(), n);
+    const std::size_t bn = std::min(b.significant(), n);
+    // Schoolbook rows, each cut off at limb n
+    for (std::size_t j = 0; j < bn; ++j) {
+        const std::size_t length = std::min(an, n - j);
+        const T carry = mpn::addmul_1(result.data() + j, a.data(), length, b[j]);
+        if (j + length < n) {
+            result[j + length] = carry;
+        }
+    }
+    impl::mask_top_limb<BITS>(result);
+    return bigint<BITS, T>{ result };
+}
+
+template<std::size_t BITS, typename T>
+constexpr std::pair<bigint<BITS, T>, bigint<BITS, T>> divmod(bigint_view<T> a, bigint_view<T> b) {
+    constexpr std::size_t n = impl::required_elements<T, BITS>::value;
+    std::array<T, n> quotient = {};
+    std::array<T, n> remainder = {};
+    const std::size_t an = std::min(a.significant(), n);
+    const std::size_t dn = b.significant();
+    if (dn == 0) {
+        return { bigint<BITS, T>{ quotient }, bigint<BITS, T>{ remainder } };
+    }
+    if (dn > an) {
+        for (std::size_t i = 0; i < an; ++i) {
+            remainder[i] = a[i];
+        }
+    } else {
+        std::array<T, 2 * n + 1> scratch = {};
+        mpn::divrem(quotient.data(), remainder.data(), a.data(), an, b.data(), dn, scratch.data());
+    }
+    return { bigint<BITS, T>{ quotient }, bigint<BITS, T>{ remainder } };
+}
+
+namespace impl {
+
+/*
+ * to_chars_view
+ *
+ * Digits are produced backward from 'last' and then moved to 'first'; the
+ * limbs are divided in a scratch copy, the view itself is never written.
+ */
+template<std::uint8_t RADIX, typename T>
+std::to_chars_result to_chars_view(char* first, char* last, bigint_view<T> value) {
+    using chunk = radix_chunk<RADIX, T>;
+
+    std::size_t size = value.significant();
+    std::vector<T> limbs(value.begin(), value.begin() + size);
+    char* begin = last;
+    if (size == 0) {
+        if (begin == first) {
+            return { last, std::errc::value_too_large };
+        }
+        *--begin = compose_digit<RADIX>(0);
+    }
+    while (size > 0) {
+        const T remainder = mpn::divrem_1(limbs.data(), limbs.data(), size, static_cast<T>(chunk::value));
+        size = mpn::normalized_size(limbs.data(), size);
+        char digits[1 + required_digits_radix<RADIX, T>::value] = {};
+        char* const digits_end = digits + sizeof(digits);
+        char* const digits_begin = size > 0
+            ? compose_backward_fixed<RADIX>(digits_end, static_cast<T>(remainder), chunk::length)
+            : compose_backward<RADIX>(digits_end, static_cast<T>(remainder));
+        if (begin - first < digits_end - digits_begin) {
+            return { last, std::errc::value_too_large };
+        }
+        begin = std::copy_backward(digits_begin, digits_end, begin);
+    }
+    return { std::copy(begin, last, first), std::errc{} };
+}
+
+} //namespace impl
+
+/*
+ * to_chars (bigint_view)
+ */
+template<typename T>
+std::to_chars_result to_chars(char* first, char* last, bigint_view<T> value, int radix = 10) {
+    return impl::with_radix(radix, std::to_chars_result{ last, std::errc::invalid_argument }, [&](auto r) {
+        return impl::to_chars_view<decltype(r)::value>(first, last, value);
+    });
+}
+
+/*
+ * bigint_table_header
+ *
+ * On-disk layout of a table of fixed-width numbers, every field little
+ * endian:
+ *
+ *   offset  size  field
+ *        0     8  magic "FTLBIGNT"
+ *        8     2  version (1)
+ *       10     1  limb size in bytes (1, 2, 4 or 8)
+ *       11     1  limb byte order (0 little, 1 big)
+ *       12     4  alignment of the limb data in bytes (power of two)
+ *       16     8  limbs per value
+ *       24     8  number of values
+ *       32     8  offset of the limb data, a multiple of the alignment
+ *       40    24  reserved, zero
+ *
+ * The limb data holds the values back to back, each least significant
+ * limb first, so a mapped file is read in place when its limb size and
+ * byte order match the host.
+ */
+struct bigint_table_header {
+    static constexpr std::size_t size = 64;
+    static constexpr std::array<char, 8> magic = { 'F', 'T', 'L', 'B', 'I', 'G', 'N', 'T' };
+    static constexpr std::uint16_t current_version = 1;
+
+    std::uint16_t version = current_version;
+    std::uint8_t limb_bytes = 0;
+    std::uint8_t byte_order = 0;
+    std::uint32_t alignment = 64;
+    std::uint64_t limbs = 0;
+    std::uint64_t values = 0;
+    std::uint64_t data_offset = size;
+};
+
+namespace impl {
+
+template<typename V>
+constexpr V load_le(const std::byte* p) {
+    V value = 0;
+    for (std::size_t k = 0; k < sizeof(V); ++k) {
+        value |= static_cast<V>(std::to_integer<V>(p[k]) << (8 * k));
+    }
+    return value;
+}
+
+template<typename V>
+constexpr void store_le(std::byte* p, V value) {
+    for (std::size_t k = 0; k < sizeof(V); ++k) {
+        p[k] = static_cast<std::byte>(value >> (8 * k));
+    }
+}
+
+} //namespace impl
+
+/*
+ * make_table_header (Header for values of type T on this host)
+ */
+template<typename T>
+constexpr bigint_table_header make_table_header(std::uint64_t limbs, std::uint64_t values) {
+    bigint_table_header header;
+    header.limb_bytes = sizeof(T);
+    header.byte_order = endian::native == endian::little ? 0 : 1;
+    header.limbs = limbs;
+    header.values = values;
+    return header;
+}
+
+/*
+ * write_table_header
+ */
+constexpr void write_table_header(const bigint_table_header& header, span<std::byte> out) {
+    for (std::size_t k = 0; k < bigint_table_header::size && k < out.size(); ++k) {
+        out[k] = std::byte{ 0 };
+    }
+    if (out.size() < bigint_table_header::size) {
+        return;
+    }
+    for (std::size_t k = 0; k < bigint_table_header::magic.size(); ++k) {
+        out[k] = static_cast<std::byte>(bigint_table_header::magic[k]);
+    }
+    impl::store_le(out.data() + 8, header.version);
+    impl::store_le(out.data() + 10, header.limb_bytes);
+    impl::store_le(out.data() + 11, header.byte_order);
+    impl::store_le(out.data() + 12, header.alignment);
+    impl::store_le(out.data() + 16, header.limbs);
+    impl::store_le(out.data() + 24, header.values);
+    impl::store_le(out.data() + 32, header.data_offset);
+}
+
+/*
+ * read_table_header (False unless the magic and version are recognized)
+ */
+constexpr bool read_table_header(span<const std::byte> in, bigint_table_header& header) {
+    if (in.size() < bigint_table_header::size) {
+        return false;
+    }
+    for (std::size_t k = 0; k < bigint_table_header::magic.size(); ++k) {
+        if (in[k] != static_cast<std::byte>(bigint_table_header::magic[k])) {
+            return false;
+        }
+    }
+    header.version = impl::load_le<std::uint16_t>(in.data() + 8);
+    header.limb_bytes = impl::load_le<std::uint8_t>(in.data() + 10);
+    header.byte_order = impl::load_le<std::uint8_t>(in.data() + 11);
+    header.alignment = impl::load_le<std::uint32_t>(in.data() + 12);
+    header.limbs = impl::load_le<std::uint64_t>(in.data() + 16);
+    header.values = impl::load_le<std::uint64_t>(in.data() + 24);
+    header.data_offset = impl::load_le<std::uint64_t>(in.data() + 32);
+    return header.version == bigint_table_header::current_version;
+}
+
+/*
+ * bigint_table (Views of the values of a table, usually a 'mapped_file')
+ *
+ * 'good' is false unless the header matches T and the host byte order,
+ * the data is aligned for T and the file holds every value.
+ */
+template<typename T>
+class bigint_table {
+public:
+    constexpr bigint_table() = default;
+
+    explicit bigint_table(span<const std::byte> file) {
+        if (!read_table_header(file, header_)
+            || header_.limb_bytes != sizeof(T)
+            || header_.byte_order != (endian::native == endian::little ? 0 : 1)
+            || header_.alignment == 0 || (header_.alignment & (header_.alignment - 1)) != 0
+            || header_.data_offset % header_.alignment != 0
+            || header_.data_offset > file.size()) {
+            return;
+        }
+        const std::byte* data = file.data() + header_.data_offset;
+        const std::uint64_t available = (file.size() - header_.data_offset) / sizeof(T);
+        if (reinterpret_cast<std::uintptr_t>(data) % alignof(T) != 0
+            || (header_.limbs != 0 && header_.values > available / header_.limbs)) {
+            return;
+        }
+        limbs_ = reinterpret_cast<const T*>(data);
+        good_ = true;
+    }
+
+    bool good() const {
+        return good_;
+    }
+
+    const bigint_table_header& header() const {
+        return header_;
+    }
+
+    std::size_t size() const {
+        return good_ ? static_cast<std::size_t>(header_.values) : 0;
+    }
+
+    bigint_view<T> operator[](std::size_t i) const {
+        return { limbs_ + i * header_.limbs, static_cast<std::size_t>(header_.limbs) };
+    }
+
+private:
+    bigint_table_header header_ = {};
+    const T* limbs_ = nullptr;
+    bool good_ = false;
+};
+
+}//namespace ftl
+
+/*
+ * bigint_view
+ */
+static_assert(ftl::bigint_view<std::uint8_t>(ftl::bigint<32, std::uint8_t>{ 0x01, 0x80, 0, 0 }).highest_bit() == 16);
+static_assert(ftl::bigint_view<std::uint8_t>(ftl::bigint<32, std::uint8_t>{ 0, 0, 0, 0 }).highest_bit() == 0);
+static_assert(ftl::bigint_view<std::uint8_t>(ftl::bigint<32, std::uint8_t>{ 0x01, 0x80, 0, 0 }).significant() == 2);
+
+/*
+ * compare
+ */
+static_assert(ftl::compare<std::uint8_t>(ftl::bigint<16, std::uint8_t>{ 1, 2 }, ftl::bigint<32, std::uint8_t>{ 1, 2, 0, 0 }) == 0);
+static_assert(ftl::compare<std::uint8_t>(ftl::bigint<16, std::uint8_t>{ 9, 2 }, ftl::bigint<32, std::uint8_t>{ 1, 3, 0, 0 }) == -1);
+static_assert(ftl::compare<std::uint8_t>(ftl::bigint<16, std::uint8_t>{ 0, 0 }, ftl::bigint<8, std::uint8_t>{ 0 }) == 0);
+static_assert(ftl::bigint<16, std::uint8_t>{ 9, 2 } < ftl::bigint<16, std::uint8_t>{ 1, 3 });
+static_assert(ftl::bigint<16, std::uint8_t>{ 1, 3 } >= ftl::bigint<24, std::uint8_t>{ 1, 3, 0 });
+static_assert(ftl::bigint<16, std::uint8_t>{ 1, 3 } != ftl::bigint<16, std::uint8_t>{ 3, 1 });
+static_assert(ftl::bigint_view<std::uint32_t>(340282366920938463463374607431768211455_10)
+    > ftl::bigint_view<std::uint32_t>(18446744073709551616_10));
+
+/*
+ * modulo
+ */
+static_assert(ftl::modulo<std::uint8_t>(ftl::bigint<16, std::uint8_t>{ 0x39, 0x30 }, 100) == 45);
+static_assert(ftl::modulo<std::uint32_t>(340282366920938463463374607431768211455_10, 1000000007u) == 340282366920938463463374607431768211455_10 % 1000000007u);
+
+/*
+ * add, multiply & divmod (bigint_view)
+ */
+static_assert(ftl::add<24, std::uint8_t>(ftl::bigint<16, std::uint8_t>{ 0xFF, 0xFF }, ftl::bigint<8, std::uint8_t>{ 1 })
+    == ftl::bigint<24, std::uint8_t>{ 0, 0, 1 });
+static_assert(ftl::add<12, std::uint8_t>(ftl::bigint<16, std::uint8_t>{ 0xFF, 0xFF }, ftl::bigint<8, std::uint8_t>{ 2 })
+    == ftl::bigint<12, std::uint8_t>{ 1, 0 });
+static_assert(ftl::multiply<64, std::uint32_t>(18446744073709551615_10, 18446744073709551615_10)
+    == ftl::bigint<64, std::uint32_t>{ 1, 0 });
+static_assert(ftl::multiply<128, std::uint32_t>(18446744073709551615_10, 18446744073709551615_10)
+    == ftl::bigint<128, std::uint32_t>{ 1, 0, 0xFFFFFFFE, 0xFFFFFFFF });
+static_assert([] {
+    constexpr auto a = 340282366920938463463374607431768211455_10;
+    constexpr auto b = 1000000007_10;
+    const auto qr = ftl::divmod<128>(ftl::bigint_view<std::uint32_t>(a), ftl::bigint_view<std::uint32_t>(b));
+    return qr.first == a / b && qr.second == a % b;
+}());
+static_assert([] {
+    constexpr auto a = 1000000007_10;
+    constexpr auto b = 340282366920938463463374607431768211455_10;
+    const auto qr = ftl::divmod<64>(ftl::bigint_view<std::uint32_t>(a), ftl::bigint_view<std::uint32_t>(b));
+    return qr.first == 0u && qr.second == a;
+}());
+static_assert([] {
+    constexpr auto a = 1000000007_10;
+    constexpr ftl::bigint<64, std::uint32_t> b = { 0, 0 };
+    const auto qr = ftl::divmod<64>(ftl::bigint_view<std::uint32_t>(a), ftl::bigint_view<std::uint32_t>(b));
+    return qr.first == 0u && qr.second == 0u;
+}());
+
+/*
+ * table header
+ */
+static_assert([] {
+    std::array<std::byte, ftl::bigint_table_header::size> bytes = {};
+    ftl::write_table_header(ftl::make_table_header<std::uint32_t>(8, 3), bytes);
+    ftl::bigint_table_header header;
+    return ftl::read_table_header(bytes, header)
+        && bytes[0] == std::byte{ 'F' } && bytes[16] == std::byte{ 8 } && bytes[32] == std::byte{ 64 }
+        && header.limb_bytes == 4 && header.limbs == 8 && header.values == 3 && header.data_offset == 64;
+}());
+
+#endif//FTL_BIGINT_VIEW_HH
@@ -0,0 +1,530 @@
+#ifndef FTL_CHARCONV_HH
+#define FTL_CHARCONV_HH
+
+#include <ftl/bigint_base.hh>
+#include <ftl/bigint_arithmetic_division.hh>
+#include <ftl/bigint_arithmetic_multiplication.hh>
+#include <ftl/bigint_radix.hh>
+#include <ftl/radix.hh>
+
+#include <array>
+#include <charconv>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <string_view>
+#include <system_error>
+#include <type_traits>
+#include <utility>
+
+namespace ftl {
+namespace impl {
+
+/*
+ * make_digit_pairs (Every two digit string, in value order)
+ */
+template<std::uint8_t RADIX>
+constexpr auto make_digit_pairs() {
+    std::array<char, 2 * RADIX * RADIX> pairs = {};
+    for (std::size_t i = 0; i < RADIX * RADIX; ++i) {
+        pairs[2 * i] = compose_digit<RADIX>(i / RADIX);
+        pairs[2 * i + 1] = compose_digit<RADIX>(i % RADIX);
+    }
+    return pairs;
+}
+
+/*
+ * digit_pairs
+ */
+template<std::uint8_t RADIX>
+struct digit_pairs {
+    static constexpr std::array<char, 2 * RADIX * RADIX> value = make_digit_pairs<RADIX>();
+};
+
+/*
+ * compose_backward (Digits of 'value' ending at 'last', two per step)
+ */
+template<std::uint8_t RADIX, typename U>
+constexpr char* compose_backward(char* last, U value) {
+    using W = std::common_type_t<U, unsigned int>;
+    constexpr W square = RADIX * RADIX;
+    W v = value;
+    while (v >= square) {
+        const std::size_t pair = 2 * static_cast<std::size_t>(v % square);
+        v /= square;
+        *--last = digit_pairs<RADIX>::value[pair + 1];
+        *--last = digit_pairs<RADIX>::value[pair];
+    }
+    if (v >= RADIX) {
+        const std::size_t pair = 2 * static_cast<std::size_t>(v);
+        *--last = digit_pairs<RADIX>::value[pair + 1];
+        *--last = digit_pairs<RADIX>::value[pair];
+    } else {
+        *--last = compose_digit<RADIX>(v);
+    }
+    return last;
+}
+
+/*
+ * compose_backward_fixed (Exactly 'count' digits of 'value', zero filled)
+ */
+template<std::uint8_t RADIX, typename U>
+constexpr char* compose_backward_fixed(char* last, U value, std::size_t count) {
+    using W = std::common_type_t<U, unsigned int>;
+    constexpr W square = RADIX * RADIX;
+    W v = value;
+    for (; count >= 2; count -= 2) {
+        const std::size_t pair = 2 * static_cast<std::size_t>(v % square);
+        v /= square;
+        *--last = digit_pairs<RADIX>::value[pair + 1];
+        *--last = digit_pairs<RADIX>::value[pair];
+    }
+    if (count != 0) {
+        *--last = compose_digit<RADIX>(v % RADIX);
+    }
+    return last;
+}
+
+/*
+ * copy_chars (Copy [begin, end) to [first, last) or report it does not fit)
+ */
+constexpr std::to_chars_result copy_chars(const char* begin, const char* end, char* first, char* last) {
+    if (last - first < end - begin) {
+        return { last, std::errc::value_too_large };
+    }
+    while (begin != end) {
+        *first++ = *begin++;
+    }
+    return { first, std::errc{} };
+}
+
+/*
+ * with_radix (Calls 'f' with the radix as a compile time constant)
+ */
+template<typename R, typename F>
+constexpr R with_radix(int radix, R unsupported, F&& f) {
+    switch (radix) {
+        case 2: return f(std::integral_constant<std::uint8_t, 2>{});
+        case 8: return f(std::integral_constant<std::uint8_t, 8>{});
+        case 10: return f(std::integral_constant<std::uint8_t, 10>{});
+        case 16: return f(std::integral_constant<std::uint8_t, 16>{});
+        case 32: return f(std::integral_constant<std::uint8_t, 32>{});
+        case 36: return f(std::integral_constant<std::uint8_t, 36>{});
+        case 58: return f(std::integral_constant<std::uint8_t, 58>{});
+        case 64: return f(std::integral_constant<std::uint8_t, 64>{});
+        default: return unsupported;
+    }
+}
+
+/*
+ * to_chars_integer
+ */
+template<std::uint8_t RADIX, typename V>
+constexpr std::to_chars_result to_chars_integer(char* first, char* last, V value) {
+    using U = std::make_unsigned_t<V>;
+    char buffer[1 + required_digits_radix<RADIX, U>::value] = {};
+    char* const end = buffer + sizeof(buffer);
+    const bool negative = value < 0;
+    char* begin = compose_backward<RADIX>(end, negative ? static_cast<U>(U{ 0 } - static_cast<U>(value)) : static_cast<U>(value));
+    if (negative) {
+        *--begin = '-';
+    }
+    return copy_chars(begin, end, first, last);
+}
+
+/*
+ * to_chars_bigint
+ */
+template<std::uint8_t RADIX, std::size_t BITS, typename T>
+constexpr std::to_chars_result to_chars_bigint(char* first, char* last, const bigint<BITS, T>& value) {
+    using chunk = radix_chunk<RADIX, T>;
+    char buffer[required_digits_bits<RADIX, BITS>::value] = {};
+    char* const end = buffer + sizeof(buffer);
+    char* begin = end;
+
+    std::array<T, required_elements<T, BITS>::value> limbs = value;
+    std::size_t size = limbs.size();
+    while (size > 0 && limbs[size - 1] == zero<T>::value) {
+        --size;
+    }
+    if (size == 0) {
+        *--begin = compose_digit<RADIX>(0);
+    }
+    while (size > 0) {
+        const T remainder = divide_in_place(limbs, size, chunk::value);
+        begin = size > 0
+            ? compose_backward_fixed<RADIX>(begin, remainder, chunk::length)
+            : compose_backward<RADIX>(begin, remainder);
+    }
+    return copy_chars(begin, end, first, last);
+}
+
+/*
+ * from_chars_unsigned (Digits only, no sign)
+ */
+template<std::uint8_t RADIX, typename U>
+constexpr std::from_chars_result from_chars_unsigned(const char* first, const char* last, U& value, U limit) {
+    const char* p = first;
+    U result = zero<U>::value;
+
+    // The first 'radix_chunk' digits can never overflow
+    const char* safe = last - first > static_cast<std::ptrdiff_t>(radix_chunk<RADIX, U>::length)
+        ? first + radix_chunk<RADIX, U>::length
+        : last;
+    for (; p != safe && is_digit<RADIX>(*p); ++p) {
+        result = static_cast<U>(result * RADIX + parse_digit<RADIX>(*p));
+    }
+
+    bool overflow = false;
+    for (; p != last && is_digit<RADIX>(*p); ++p) {
+        const U digit = parse_digit<RADIX>(*p);
+        if (overflow || result > (limit - digit) / RADIX) {
+            overflow = true;
+        } else {
+            result = static_cast<U>(result * RADIX + digit);
+        }
+    }
+
+    if (p == first) {
+        return { first, std::errc::invalid_argument };
+    }
+    if (overflow || result > limit) {
+        return { p, std::errc::result_out_of_range };
+    }
+    value = result;
+    return { p, std::errc{} };
+}
+
+/*
+ * from_chars_integer
+ */
+template<std::uint8_t RADIX, typename V>
+constexpr std::from_chars_result from_chars_integer(const char* first, const char* last, V& value) {
+    using U = std::make_unsigned_t<V>;
+    const bool negative = std::is_signed<V>::value && first != last && *first == '-';
+    const U limit = negative
+        ? static_cast<U>(static_cast<U>(std::numeric_limits<V>::max()) + 1)
+        : static_cast<U>(std::numeric_limits<V>::max());
+
+    U magnitude = zero<U>::value;
+    const auto result = from_chars_unsigned<RADIX>(first + (negative ? 1 : 0), last, magnitude, limit);
+    if (result.ec == std::errc::invalid_argument) {
+        return { first, result.ec };
+    }
+    if (result.ec == std::errc{}) {
+        value = static_cast<V>(negative ? static_cast<U>(U{ 0 } - magnitude) : magnitude);
+    }
+    return result;
+}
+
+/*
+ * from_chars_bigint
+ *
+ * Digits are gathered into limb-sized chunks, each folded in with one
+ * multiply-add pass over the limbs.
+ */
+template<std::uint8_t RADIX, std::size_t BITS, typename T>
+constexpr std::from_chars_result from_chars_bigint(const char* first, const char* last, bigint<BITS, T>& value) {
+    using chunk = radix_chunk<RADIX, T>;
+    constexpr std::size_t top_bits = BITS % std::numeric_limits<T>::digits;
+
+    std::array<T, required_elements<T, BITS>::value> limbs = {};
+    std::size_t size = 0;
+    bool overflow = false;
+    const char* p = first;
+    while (p != last && is_digit<RADIX>(*p)) {
+        T scale = one<T>::value;
+        T part = zero<T>::value;
+        for (std::size_t j = 0; j < chunk::length && p != last && is_digit<RADIX>(*p); ++j, ++p) {
+            scale = static_cast<T>(scale * RADIX);
+            part = static_cast<T>(part * RADIX + parse_digit<RADIX>(*p));
+        }
+        if (!overflow && multiply_add_in_place(limbs, size, scale, part) != zero<T>::value) {
+            overflow = true;
+        }
+    }
+
+    if (p == first) {
+        return { first, std::errc::invalid_argument };
+    }
+    if (top_bits != 0 && (limbs[limbs.size() - 1] >> top_bits) != zero<T>::value) {
+        overflow = true;
+    }
+    if (overflow) {
+        return { p, std::errc::result_out_of_range };
+    }
+    for (std::size_t i = 0; i < limbs.size(); ++i) {
+        value[i] = limbs[i];
+    }
+    return { p, std::errc{} };
+}
+
+/*
+ * max_chars (Integer)
+ */
+template<std::uint8_t RADIX, typename V>
+struct max_chars :
+    identity<std::size_t, 1 + required_digits_radix<RADIX, std::make_unsigned_t<V>>::value>
+{};
+
+/*
+ * max_chars (bigint)
+ */
+template<std::uint8_t RADIX, std::size_t BITS, typename T>
+struct max_chars<RADIX, bigint<BITS, T>> :
+    required_digits_bits<RADIX, BITS>
+{};
+
+}//namespace impl
+
+/*
+ * to_chars (Integer)
+ *
+ * Mirrors 'std::to_chars': no terminator is written, and if the text does
+ * not fit, 'ec' is 'value_too_large' and 'ptr' is 'last'. Digits use the
+ * radix layer's alphabets (upper case for bases 16 and 36), and an
+ * unsupported radix reports 'invalid_argument'. Nothing is allocated.
+ */
+template<typename V, typename = std::enable_if_t<std::is_integral<V>::value && !std::is_same<V, bool>::value>>
+constexpr std::to_chars_result to_chars(char* first, char* last, V value, int radix = 10) {
+    return impl::with_radix(radix, std::to_chars_result{ last, std::errc::invalid_argument }, [&](auto r) {
+        return impl::to_chars_integer<decltype(r)::value>(first, last, value);
+    });
+}
+
+/*
+ * to_chars (bigint)
+ */
+template<std::size_t BITS, typename T>
+constexpr std::to_chars_result to_chars(char* first, char* last, bigint<BITS, T> value, int radix = 10) {
+    return impl::with_radix(radix, std::to_chars_result{ last, std::errc::invalid_argument }, [&](auto r) {
+        return impl::to_chars_bigint<decltype(r)::value>(first, last, value);
+    });
+}
+
+/*
+ * from_chars (Integer)
+ *
+ * Mirrors 'std::from_chars': a leading '-' is accepted for signed types
+ * only, 'ptr' stops at the first non-digit, and on 'result_out_of_range'
+ * the digits are consumed but 'value' is left unmodified.
+ */
+template<typename V, typename = std::enable_if_t<std::is_integral<V>::value && !std::is_same<V, bool>::value>>
+constexpr std::from_chars_result from_chars(const char* first, const char* last, V& value, int radix = 10) {
+    return impl::with_radix(radix, std::from_chars_result{ first, std::errc::invalid_argument }, [&](auto r) {
+        return impl::from_chars_integer<decltype(r)::value>(first, last, value);
+    });
+}
+
+/*
+ * from_chars (bigint)
+ */
+template<std::size_t BITS, typename T>
+constexpr std::from_chars_result from_chars(const char* first, const char* last, bigint<BITS, T>& value, int radix = 10) {
+    return impl::with_radix(radix, std::from_chars_result{ first, std::errc::invalid_argument }, [&](auto r) {
+        return impl::from_chars_bigint<decltype(r)::value>(first, last, value);
+    });
+}
+
+/*
+ * constant_digits
+ *
+ * Text of a constant with static storage duration, formatted once at
+ * compile time: 'value' is an array of exactly 'size' characters and
+ * 'view' refers to it, so runtime code never formats the constant.
+ */
+template<const auto& VALUE, std::uint8_t RADIX = 10>
+struct constant_digits {
+private:
+    using V = std::remove_cv_t<std::remove_reference_t<decltype(VALUE)>>;
+
+    static constexpr auto format() {
+        std::array<char, impl::max_chars<RADIX, V>::value> text = {};
+        const auto result = to_chars(text.data(), text.data() + text.size(), VALUE, RADIX);
+        return std::make_pair(text, static_cast<std::size_t>(result.ptr - text.data()));
+    }
+
+    static constexpr auto trim() {
+        std::array<char, format().second> text = {};
+        for (std::size_t i = 0; i < text.size(); ++i) {
+            text[i] = format().first[i];
+        }
+        return text;
+    }
+
+public:
+    static constexpr std::size_t size = format().second;
+    static constexpr std::array<char, size> value = trim();
+    static constexpr std::string_view view = { value.data(), size };
+};
+
+/*
+ * constant_digits_v
+ */
+template<const auto& VALUE, std::uint8_t RADIX = 10>
+inline constexpr std::string_view constant_digits_v = constant_digits<VALUE, RADIX>::view;
+
+}//namespace ftl
+
+/*
+ * digit_pairs
+ */
+static_assert(ftl::impl::digit_pairs<10>::value[0] == '0');
+static_assert(ftl::impl::digit_pairs<10>::value[2 * 42] == '4');
+static_assert(ftl::impl::digit_pairs<10>::value[2 * 42 + 1] == '2');
+static_assert(ftl::impl::digit_pairs<16>::value[2 * 0xAF] == 'A');
+
+/*
+ * to_chars (Integer)
+ */
+static_assert([] {
+    char text[10] = {};
+    const auto result = ftl::to_chars(text, text + 10, 1234567890);
+    return result.ec == std::errc{} && result.ptr == text + 10 && text[0] == '1' && text[9] == '0';
+}());
+static_assert([] {
+    char text[4] = {};
+    const auto result = ftl::to_chars(text, text + 4, std::int8_t{ -128 });
+    return result.ec == std::errc{} && result.ptr == text + 4
+        && text[0] == '-' && text[1] == '1' && text[2] == '2' && text[3] == '8';
+}());
+static_assert([] {
+    char text[1] = {};
+    const auto result = ftl::to_chars(text, text + 1, 0u);
+    return result.ec == std::errc{} && result.ptr == text + 1 && text[0] == '0';
+}());
+static_assert([] {
+    char text[5] = {};
+    const auto result = ftl::to_chars(text, text + 5, 0xFFED56, 16);
+    return result.ec == std::errc::value_too_large && result.ptr == text + 5;
+}());
+static_assert([] {
+    char text[3] = {};
+    const auto result = ftl::to_chars(text, text + 3, 208456, 64);
+    return result.ec == std::errc{} && text[0] == 'y' && text[1] == '5' && text[2] == 'I';
+}());
+static_assert([] {
+    char text[8] = {};
+    return ftl::to_chars(text, text + 8, 7, 7).ec == std::errc::invalid_argument;
+}());
+
+/*
+ * to_chars (bigint)
+ */
+static_assert([] {
+    char text[39] = {};
+    const auto result = ftl::to_chars(text, text + 39, 340282366920938463463374607431768211455_10);
+    const char expected[] = "340282366920938463463374607431768211455";
+    for (std::size_t i = 0; i < 39; ++i) {
+        if (text[i] != expected[i]) {
+            return false;
+        }
+    }
+    return result.ec == std::errc{} && result.ptr == text + 39;
+}());
+static_assert([] {
+    char text[8] = {};
+    const auto result = ftl::to_chars(text, text + 8, 0x100000000_16, 10);
+    return result.ec == std::errc::value_too_large && result.ptr == text + 8;
+}());
+static_assert([] {
+    char text[32] = {};
+    const auto result = ftl::to_chars(text, text + 32, 0x010966776006953D5567439E5E39F86A0D273BEED61967F6_16, 58);
+    return result.ec == std::errc{} && result.ptr == text + 32 && text[0] == '6' && text[31] == 'M';
+}());
+static_assert([] {
+    char text[4] = {};
+    const auto result = ftl::to_chars(text, text + 4, ftl::bigint<16, std::uint8_t>{ 0x05, 0x01 }, 10);
+    return result.ec == std::errc{} && result.ptr == text + 3 && text[0] == '2' && text[1] == '6' && text[2] == '1';
+}());
+static_assert([] {
+    char text[1] = {};
+    const auto result = ftl::to_chars(text, text + 1, ftl::bigint<64>{}, 16);
+    return result.ec == std::errc{} && result.ptr == text + 1 && text[0] == '0';
+}());
+
+/*
+ * from_chars (Integer)
+ */
+static_assert([] {
+    const char text[] = "1234567890 ";
+    unsigned value = 0;
+    const auto result = ftl::from_chars(text, text + 11, value);
+    return result.ec == std::errc{} && result.ptr == text + 10 && value == 1234567890;
+}());
+static_assert([] {
+    const char text[] = "-128";
+    std::int8_t value = 0;
+    const auto result = ftl::from_chars(text, text + 4, value);
+    return result.ec == std::errc{} && result.ptr == text + 4 && value == -128;
+}());
+static_assert([] {
+    const char text[] = "128";
+    std::int8_t value = 7;
+    const auto result = ftl::from_chars(text, text + 3, value);
+    return result.ec == std::errc::result_out_of_range && result.ptr == text + 3 && value == 7;
+}());
+static_assert([] {
+    const char text[] = "-1";
+    unsigned value = 7;
+    const auto result = ftl::from_chars(text, text + 2, value);
+    return result.ec == std::errc::invalid_argument && result.ptr == text && value == 7;
+}());
+static_assert([] {
+    const char text[] = "fFeD56";
+    int value = 0;
+    const auto result = ftl::from_chars(text, text + 6, value, 16);
+    return result.ec == std::errc{} && value == 0xFFED56;
+}());
+static_assert([] {
+    const char text[] = "18446744073709551615";
+    std::uint64_t value = 0;
+    const auto result = ftl::from_chars(text, text + 20, value);
+    return result.ec == std::errc{} && value == 18446744073709551615ull;
+}());
+static_assert([] {
+    const char text[] = "18446744073709551616";
+    std::uint64_t value = 0;
+    return ftl::from_chars(text, text + 20, value).ec == std::errc::result_out_of_range;
+}());
+
+/*
+ * from_chars (bigint)
+ */
+static_assert([] {
+    const char text[] = "340282366920938463463374607431768211455";
+    ftl::bigint<128> value = {};
+    const auto result = ftl::from_chars(text, text + 39, value);
+    return result.ec == std::errc{} && result.ptr == text + 39
+        && value[0] == 0xFFFFFFFF && value[1] == 0xFFFFFFFF && value[2] == 0xFFFFFFFF && value[3] == 0xFFFFFFFF;
+}());
+static_assert([] {
+    const char text[] = "340282366920938463463374607431768211456";
+    ftl::bigint<128> value = {};
+    return ftl::from_chars(text, text + 39, value).ec == std::errc::result_out_of_range;
+}());
+static_assert([] {
+    const char text[] = "1FF";
+    ftl::bigint<8, std::uint8_t> value = {};
+    return ftl::from_chars(text, text + 3, value, 16).ec == std::errc::result_out_of_range;
+}());
+static_assert([] {
+    const char text[] = "6UwLL9Risc3QfPqBUvKofHmBQ7wMtjvM";
+    ftl::bigint<200> value = {};
+    const auto result = ftl::from_chars(text, text + 32, value, 58);
+    return result.ec == std::errc{} && value[0] == 0xD61967F6 && value[5] == 0x01096677;
+}());
+static_assert([] {
+    const char text[] = "x";
+    ftl::bigint<64> value = {};
+    const auto result = ftl::from_chars(text, text + 1, value);
+    return result.ec == std::errc::invalid_argument && result.ptr == text;
+}());
+
+/*
+ * constant_digits
+ */
+static_assert(ftl::constant_digits_v<ftl::ten<ftl::bigint<64>>::value> == "10");
+static_assert(ftl::constant_digits_v<ftl::ten<ftl::bigint<64>>::value, 2> == "1010");
+
+#endif//FTL_CHARCONV_HH
@@ -0,0 +1,23 @@
+#ifndef FTL_ENDIAN_HH
+#define FTL_ENDIAN_HH
+
+namespace ftl {
+
+/*
+ * endian (Byte order, as C++20 'std::endian')
+ */
+enum class endian {
+#if defined(_WIN32)
+    little = 0,
+    big = 1,
+    native = little
+#else
+    little = __ORDER_LITTLE_ENDIAN__,
+    big = __ORDER_BIG_ENDIAN__,
+    native = __BYTE_ORDER__
+#endif
+};
+
+}//namespace ftl
+
+#endif//FTL_ENDIAN_HH
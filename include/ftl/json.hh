@@ -0,0 +1,1272 @@
+#ifndef FTL_JSON_HH
+#define FTL_JSON_HH
+
+#include <ftl/charconv.hh>
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <string_view>
+#include <system_error>
+#include <tuple>
+#include <type_traits>
+#include <vector>
+
+#if defined(__AVX2__) || defined(__PCLMUL__)
+#include <immintrin.h>
+#endif
+
+namespace ftl {
+namespace json {
+
+/*
+ * error
+ */
+enum class error {
+    none,
+    empty,
+    unclosed_string,
+    syntax,
+    too_large
+};
+
+/*
+ * type
+ */
+enum class type {
+    invalid,
+    object,
+    array,
+    string,
+    number,
+    boolean,
+    null
+};
+
+namespace impl {
+
+/*
+ * block_size (Bytes classified per step of the structural scan)
+ */
+struct block_size : std::integral_constant<std::size_t, 64> {};
+
+/*
+ * block_masks (One bit per byte of a block)
+ */
+struct block_masks {
+    std::uint64_t quote = 0;
+    std::uint64_t backslash = 0;
+    std::uint64_t op = 0;
+    std::uint64_t whitespace = 0;
+};
+
+/*
+ * block_state (Carried from one block to the next)
+ */
+struct block_state {
+    std::uint64_t escaped = 0;
+    std::uint64_t in_string = 0;
+    std::uint64_t scalar = 0;
+};
+
+/*
+ * is_op ('{' '}' '[' ']' ':' ',')
+ */
+constexpr bool is_op(const char c) {
+    return c == '{' || c == '}' || c == '[' || c == ']' || c == ':' || c == ',';
+}
+
+/*
+ * is_whitespace
+ */
+constexpr bool is_whitespace(const char c) {
+    return c == ' ' || c == '\t' || c == '\n' || c == '\r';
+}
+
+/*
+ * classify (Scalar)
+ */
+constexpr block_masks classify(const char* block) {
+    block_masks masks;
+    for (std::size_t i = 0; i < block_size::value; ++i) {
+        const std::uint64_t bit = std::uint64_t{ 1 } << i;
+        const char c = block[i];
+        masks.quote |= c == '"' ? bit : 0;
+        masks.backslash |= c == '\\' ? bit : 0;
+        masks.op |= is_op(c) ? bit : 0;
+        masks.whitespace |= is_whitespace(c) ? bit : 0;
+    }
+    return masks;
+}
+
+#if defined(__AVX2__)
+/*
+ * classify_avx2
+ */
+inline std::uint64_t movemask_avx2(__m256i lo, __m256i hi) {
+    return static_cast<std::uint32_t>(_mm256_movemask_epi8(lo))
+        | (static_cast<std::uint64_t>(static_cast<std::uint32_t>(_mm256_movemask_epi8(hi))) << 32);
+}
+
+inline block_masks classify_avx2(const char* block) {
+    const __m256i lo = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(block));
+    const __m256i hi = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(block + 32));
+    const auto eq = [](__m256i v, char c) {
+        return _mm256_cmpeq_epi8(v, _mm256_set1_epi8(c));
+    };
+    // '[' ']' and '{' '}' differ only in bit 5
+    const __m256i case_bit = _mm256_set1_epi8(0x20);
+    const __m256i lo_folded = _mm256_or_si256(lo, case_bit);
+    const __m256i hi_folded = _mm256_or_si256(hi, case_bit);
+
+    block_masks masks;
+    masks.quote = movemask_avx2(eq(lo, '"'), eq(hi, '"'));
+    masks.backslash = movemask_avx2(eq(lo, '\\'), eq(hi, '\\'));
+    masks.op = movemask_avx2(
+        _mm256_or_si256(
+            _mm256_or_si256(eq(lo_folded, '{'), eq(lo_folded, '}')),
+            _mm256_or_si256(eq(lo, ':'), eq(lo, ','))),
+        _mm256_or_si256(
+            _mm256_or_si256(eq(hi_folded, '{'), eq(hi_folded, '}')),
+            _mm256_or_si256(eq(hi, ':'), eq(hi, ','))));
+    masks.whitespace = movemask_avx2(
+        _mm256_or_si256(
+            _mm256_or_si256(eq(lo, ' '), eq(lo, '\t')),
+            _mm256_or_si256(eq(lo, '\n'), eq(lo, '\r'))),
+        _mm256_or_si256(
+            _mm256_or_si256(eq(hi, ' '), eq(hi, '\t')),
+            _mm256_or_si256(eq(hi, '\n'), eq(hi, '\r'))));
+    return masks;
+}
+#endif
+
+/*
+ * escaped_mask (Bytes preceded by an odd run of backslashes)
+ *
+ * Backslashes are rare, so each unescaped one is visited in turn; a run
+ * reaching the end of the block escapes the first byte of the next.
+ */
+constexpr std::uint64_t escaped_mask(std::uint64_t backslash, std::uint64_t& carry) {
+    std::uint64_t escaped = carry;
+    carry = 0;
+    backslash &= ~escaped;
+    while (backslash != 0) {
+        const int i = __builtin_ctzll(backslash);
+        if (i == 63) {
+            carry = 1;
+            break;
+        }
+        const std::uint64_t next = std::uint64_t{ 1 } << (i + 1);
+        escaped |= next;
+        backslash &= ~(next | (std::uint64_t{ 1 } << i));
+    }
+    return escaped;
+}
+
+/*
+ * prefix_xor (Bit i is the parity of bits 0..i)
+ */
+constexpr std::uint64_t prefix_xor(std::uint64_t bits) {
+    bits ^= bits << 1;
+    bits ^= bits << 2;
+    bits ^= bits << 4;
+    bits ^= bits << 8;
+    bits ^= bits << 16;
+    bits ^= bits << 32;
+    return bits;
+}
+
+#if defined(__PCLMUL__)
+/*
+ * prefix_xor_clmul (Carry-less multiply by all ones)
+ */
+inline std::uint64_t prefix_xor_clmul(std::uint64_t bits) {
+    const __m128i product = _mm_clmulepi64_si128(
+        _mm_set_epi64x(0, static_cast<long long>(bits)), _mm_set1_epi8(static_cast<char>(0xFF)), 0);
+    return static_cast<std::uint64_t>(_mm_cvtsi128_si64(product));
+}
+#endif
+
+/*
+ * structural_mask
+ *
+ * Structural characters outside strings, both quotes of every string, and
+ * the first byte of every number or literal.
+ */
+template<typename PREFIX_XOR>
+constexpr std::uint64_t structural_mask(const block_masks& masks, block_state& state, PREFIX_XOR&& prefix) {
+    const std::uint64_t escaped = escaped_mask(masks.backslash, state.escaped);
+    const std::uint64_t quotes = masks.quote & ~escaped;
+    const std::uint64_t in_string = prefix(quotes) ^ state.in_string;
+    state.in_string = static_cast<std::uint64_t>(static_cast<std::int64_t>(in_string) >> 63);
+
+    const std::uint64_t scalar = ~(masks.op | masks.whitespace | quotes | in_string);
+    const std::uint64_t scalar_start = scalar & ~((scalar << 1) | state.scalar);
+    state.scalar = scalar >> 63;
+
+    return (masks.op & ~in_string) | quotes | scalar_start;
+}
+
+/*
+ * flatten (Append the position of every set bit)
+ */
+constexpr std::uint32_t* flatten(std::uint64_t mask, std::uint32_t base, std::uint32_t* out) {
+    while (mask != 0) {
+        *out++ = base + static_cast<std::uint32_t>(__builtin_ctzll(mask));
+        mask &= mask - 1;
+    }
+    return out;
+}
+
+/*
+ * pad_block (Copy of the last partial block, padded with whitespace)
+ */
+constexpr std::array<char, block_size::value> pad_block(const char* text, std::size_t length) {
+    std::array<char, block_size::value> block = {};
+    for (std::size_t i = 0; i < block.size(); ++i) {
+        block[i] = i < length ? text[i] : ' ';
+    }
+    return block;
+}
+
+/*
+ * index_scalar (Structural index without SIMD, usable at compile time)
+ *
+ * 'out' must hold 'length' + 1 entries; returns the number written.
+ */
+constexpr std::size_t index_scalar(const char* text, std::size_t length, std::uint32_t* out, error& status) {
+    std::uint32_t* const begin = out;
+    block_state state;
+    std::size_t i = 0;
+    for (; i + block_size::value <= length; i += block_size::value) {
+        out = flatten(structural_mask(classify(text + i), state, prefix_xor), static_cast<std::uint32_t>(i), out);
+    }
+    if (i < length) {
+        const auto block = pad_block(text + i, length - i);
+        out = flatten(structural_mask(classify(block.data()), state, prefix_xor), static_cast<std::uint32_t>(i), out);
+    }
+    status = state.in_string != 0 ? error::unclosed_string : (out == begin ? error::empty : error::none);
+    return static_cast<std::size_t>(out - begin);
+}
+
+/*
+ * index_simd (Structural index, vectorized where the target allows)
+ */
+inline std::size_t index_simd(const char* text, std::size_t length, std::uint32_t* out, error& status) {
+#if defined(__AVX2__)
+    std::uint32_t* const begin = out;
+    block_state state;
+#if defined(__PCLMUL__)
+    const auto prefix = prefix_xor_clmul;
+#else
+    const auto prefix = prefix_xor;
+#endif
+    std::size_t i = 0;
+    for (; i + block_size::value <= length; i += block_size::value) {
+        out = flatten(structural_mask(classify_avx2(text + i), state, prefix), static_cast<std::uint32_t>(i), out);
+    }
+    if (i < length) {
+        const auto block = pad_block(text + i, length - i);
+        out = flatten(structural_mask(classify_avx2(block.data()), state, prefix), static_cast<std::uint32_t>(i), out);
+    }
+    status = state.in_string != 0 ? error::unclosed_string : (out == begin ? error::empty : error::none);
+    return static_cast<std::size_t>(out - begin);
+#else
+    return index_scalar(text, length, out, status);
+#endif
+}
+
+/*
+ * is_literal ('true', 'false', 'null' or a JSON number)
+ */
+constexpr bool is_literal(std::string_view token) {
+    if (token == "true" || token == "false" || token == "null") {
+        return true;
+    }
+    std::size_t i = token.size() > 0 && token[0] == '-' ? 1 : 0;
+    const auto digits = [&] {
+        const std::size_t first = i;
+        while (i < token.size() && token[i] >= '0' && token[i] <= '9') {
+            ++i;
+        }
+        return i - first;
+    };
+    const std::size_t integer = i;
+    if (digits() == 0 || (token[integer] == '0' && i - integer > 1)) {
+        return false;
+    }
+    if (i < token.size() && token[i] == '.') {
+        ++i;
+        if (digits() == 0) {
+            return false;
+        }
+    }
+    if (i < token.size() && (token[i] == 'e' || token[i] == 'E')) {
+        ++i;
+        if (i < token.size() && (token[i] == '+' || token[i] == '-')) {
+            ++i;
+        }
+        if (digits() == 0) {
+            return false;
+        }
+    }
+    return i == token.size();
+}
+
+/*
+ * check_grammar (Walk the structural index of a text that scanned cleanly)
+ *
+ * Checks bracket nesting, a string key and ':' before every member value,
+ * ',' between values and a single top-level value, and that every scalar
+ * is a literal or a number. The contents of strings are not checked.
+ * 'stack' holds one entry per structural.
+ */
+constexpr error check_grammar(std::string_view text, const std::uint32_t* index, std::size_t count, char* stack) {
+    enum class expect { value, value_or_close, key, key_or_close, colon, comma_or_close, end };
+    expect state = expect::value;
+    std::size_t depth = 0;
+    for (std::size_t i = 0; i < count; ++i) {
+        const std::size_t at = index[i];
+        const char c = text[at];
+        const bool value = state == expect::value || state == expect::value_or_close;
+        bool complete = false;
+        if (c == '{' || c == '[') {
+            if (!value) {
+                return error::syntax;
+            }
+            stack[depth++] = c;
+            state = c == '{' ? expect::key_or_close : expect::value_or_close;
+        } else if (c == '}' || c == ']') {
+            const char open = c == '}' ? '{' : '[';
+            const bool empty = c == '}' ? state == expect::key_or_close : state == expect::value_or_close;
+            if ((state != expect::comma_or_close && !empty) || depth == 0 || stack[depth - 1] != open) {
+                return error::syntax;
+            }
+            --depth;
+            complete = true;
+        } else if (c == ':') {
+            if (state != expect::colon) {
+                return error::syntax;
+            }
+            state = expect::value;
+        } else if (c == ',') {
+            if (state != expect::comma_or_close) {
+                return error::syntax;
+            }
+            state = stack[depth - 1] == '{' ? expect::key : expect::value;
+        } else if (c == '"') {
+            const bool key = state == expect::key || state == expect::key_or_close;
+            if (!value && !key) {
+                return error::syntax;
+            }
+            // The closing quote is the next structural
+            ++i;
+            state = expect::colon;
+            complete = !key;
+        } else {
+            std::size_t last = at;
+            while (last < text.size() && !is_op(text[last]) && !is_whitespace(text[last]) && text[last] != '"') {
+                ++last;
+            }
+            if (!value || !is_literal(text.substr(at, last - at))) {
+                return error::syntax;
+            }
+            complete = true;
+        }
+        if (complete) {
+            state = depth == 0 ? expect::end : expect::comma_or_close;
+        }
+    }
+    return state == expect::end ? error::none : error::syntax;
+}
+
+/*
+ * trim_right (Drop trailing whitespace)
+ */
+constexpr std::string_view trim_right(std::string_view text) {
+    while (!text.empty() && is_whitespace(text.back())) {
+        text.remove_suffix(1);
+    }
+    return text;
+}
+
+/*
+ * is_zero (Integer or bigint)
+ */
+template<typename V>
+constexpr bool is_zero(const V& value) {
+    if constexpr (std::is_integral<V>::value) {
+        return value == 0;
+    } else {
+        for (const auto limb : value) {
+            if (limb != 0) {
+                return false;
+            }
+        }
+        return true;
+    }
+}
+
+/*
+ * assign (Integer or bigint, limb by limb)
+ */
+template<typename V>
+constexpr void assign(V& out, const V& value) {
+    if constexpr (std::is_integral<V>::value) {
+        out = value;
+    } else {
+        for (std::size_t i = 0; i < value.size(); ++i) {
+            out[i] = value[i];
+        }
+    }
+}
+
+/*
+ * parse_integer (Exact JSON integer)
+ *
+ * Digits go straight through 'from_chars', whose chunked loop serves a
+ * byte as well as a 256-bit limb array; a fraction or exponent is rejected
+ * rather than rounded.
+ */
+template<typename V>
+constexpr std::errc parse_integer(std::string_view text, V& out) {
+    const bool negative = !text.empty() && text.front() == '-';
+    const std::string_view digits = text.substr(negative ? 1 : 0);
+    if (digits.empty() || (digits.size() > 1 && digits.front() == '0')) {
+        return std::errc::invalid_argument;
+    }
+    V result = {};
+    const char* const last = text.data() + text.size();
+    const auto parsed = ftl::from_chars(std::is_signed<V>::value ? text.data() : digits.data(), last, result);
+    if (parsed.ec == std::errc::invalid_argument || parsed.ptr != last) {
+        return std::errc::invalid_argument;
+    }
+    if (parsed.ec != std::errc{}) {
+        return parsed.ec;
+    }
+    if (!std::is_signed<V>::value && negative && !is_zero(result)) {
+        return std::errc::result_out_of_range;
+    }
+    assign(out, result);
+    return std::errc{};
+}
+
+} //namespace impl
+
+class value;
+
+/*
+ * document
+ *
+ * A parsed text and its structural index: positions of every structural
+ * character, of both quotes of every string, and of the first byte of every
+ * number and literal. Values are read lazily by walking the index.
+ */
+class document {
+public:
+    constexpr document() = default;
+
+    constexpr document(std::string_view text, const std::uint32_t* index, std::size_t count, error status) :
+        text_(text), index_(index), count_(count), status_(status)
+    {}
+
+    constexpr error status() const {
+        return status_;
+    }
+
+    constexpr std::string_view text() const {
+        return text_;
+    }
+
+    constexpr std::size_t count() const {
+        return count_;
+    }
+
+    /*
+     * position (Byte offset of a structural)
+     */
+    constexpr std::size_t position(std::size_t at) const {
+        return at < count_ ? index_[at] : text_.size();
+    }
+
+    /*
+     * token (First byte of a structural, or zero past the end)
+     */
+    constexpr char token(std::size_t at) const {
+        return at < count_ ? text_[index_[at]] : '\0';
+    }
+
+    /*
+     * skip (Structural following the value that starts at 'at')
+     */
+    constexpr std::size_t skip(std::size_t at) const {
+        const char c = token(at);
+        if (c == '"') {
+            return at + 2;
+        }
+        if (c != '{' && c != '[') {
+            return at + 1;
+        }
+        std::size_t depth = 0;
+        do {
+            const char t = token(at);
+            if (t == '{' || t == '[') {
+                ++depth;
+            } else if (t == '}' || t == ']') {
+                --depth;
+            } else if (t == '"') {
+                ++at;
+            }
+            ++at;
+        } while (depth != 0 && at < count_);
+        return at;
+    }
+
+    constexpr value root() const;
+
+private:
+    std::string_view text_ = {};
+    const std::uint32_t* index_ = nullptr;
+    std::size_t count_ = 0;
+    error status_ = error::empty;
+};
+
+/*
+ * member (Key and value of an object member)
+ */
+struct member;
+
+/*
+ * value
+ *
+ * Cursor to one value of a document. Strings are returned as views of the
+ * raw text between the quotes, with escapes left in place ('unescape'
+ * decodes them); nothing is copied or allocated.
+ */
+class value {
+public:
+    constexpr value() = default;
+
+    constexpr value(const document* doc, std::size_t at) :
+        doc_(doc), at_(at)
+    {}
+
+    constexpr json::type type() const {
+        switch (doc_ == nullptr ? '\0' : doc_->token(at_)) {
+            case '{': return json::type::object;
+            case '[': return json::type::array;
+            case '"': return json::type::string;
+            case 't': case 'f': return json::type::boolean;
+            case 'n': return json::type::null;
+            case '-': case '0': case '1': case '2': case '3': case '4':
+            case '5': case '6': case '7': case '8': case '9': return json::type::number;
+            default: return json::type::invalid;
+        }
+    }
+
+    constexpr explicit operator bool() const {
+        return type() != json::type::invalid;
+    }
+
+    constexpr bool is_object() const { return type() == json::type::object; }
+    constexpr bool is_array() const { return type() == json::type::array; }
+    constexpr bool is_string() const { return type() == json::type::string; }
+    constexpr bool is_number() const { return type() == json::type::number; }
+    constexpr bool is_boolean() const { return type() == json::type::boolean; }
+    constexpr bool is_null() const { return type() == json::type::null; }
+
+    /*
+     * raw (Complete text of the value)
+     */
+    constexpr std::string_view raw() const {
+        if (!*this) {
+            return {};
+        }
+        const std::size_t begin = doc_->position(at_);
+        switch (type()) {
+            case json::type::object:
+            case json::type::array:
+            case json::type::string: {
+                const std::size_t end = doc_->position(doc_->skip(at_) - 1) + 1;
+                return doc_->text().substr(begin, end - begin);
+            }
+            default:
+                return impl::trim_right(doc_->text().substr(begin, doc_->position(at_ + 1) - begin));
+        }
+    }
+
+    /*
+     * string (Text between the quotes, escapes undecoded)
+     */
+    constexpr std::string_view string() const {
+        if (!is_string()) {
+            return {};
+        }
+        const std::size_t begin = doc_->position(at_) + 1;
+        return doc_->text().substr(begin, doc_->position(at_ + 1) - begin);
+    }
+
+    /*
+     * boolean
+     */
+    constexpr bool boolean() const {
+        return doc_ != nullptr && doc_->token(at_) == 't';
+    }
+
+    /*
+     * get (Integer or bigint)
+     *
+     * Only integral numbers are accepted; anything else is
+     * 'invalid_argument', and a value that does not fit is
+     * 'result_out_of_range'. 'out' is only written on success.
+     */
+    template<typename V>
+    constexpr std::errc get(V& out) const {
+        if (!is_number()) {
+            return std::errc::invalid_argument;
+        }
+        return impl::parse_integer(raw(), out);
+    }
+
+    /*
+     * as (Integer or bigint, 'fallback' if 'get' fails)
+     */
+    template<typename V>
+    constexpr V as(V fallback = {}) const {
+        V result = fallback;
+        get(result);
+        return result;
+    }
+
+    /*
+     * operator[] (Object member by key, compared with the raw key text)
+     */
+    constexpr value operator[](std::string_view key) const;
+
+    /*
+     * operator[] (Array element)
+     */
+    constexpr value operator[](std::size_t i) const;
+
+    /*
+     * Iteration over array elements or object members
+     */
+    class element_iterator;
+    class member_iterator;
+
+    template<typename ITERATOR>
+    struct range {
+        ITERATOR first;
+        ITERATOR last;
+        constexpr ITERATOR begin() const { return first; }
+        constexpr ITERATOR end() const { return last; }
+    };
+
+    constexpr range<element_iterator> elements() const;
+    constexpr range<member_iterator> members() const;
+
+    constexpr const document* doc() const { return doc_; }
+    constexpr std::size_t at() const { return at_; }
+
+private:
+    const document* doc_ = nullptr;
+    std::size_t at_ = 0;
+};
+
+struct member {
+    std::string_view key;
+    json::value value;
+};
+
+/*
+ * element_iterator
+ */
+class value::element_iterator {
+public:
+    constexpr element_iterator() = default;
+
+    constexpr element_iterator(const document* doc, std::size_t at) :
+        doc_(doc), at_(at)
+    {}
+
+    constexpr value operator*() const {
+        return { doc_, at_ };
+    }
+
+    constexpr element_iterator& operator++() {
+        const std::size_t next = doc_->skip(at_);
+        at_ = doc_->token(next) == ',' ? next + 1 : end_position;
+        return *this;
+    }
+
+    constexpr bool operator==(const element_iterator& other) const { return at_ == other.at_; }
+    constexpr bool operator!=(const element_iterator& other) const { return at_ != other.at_; }
+
+    static constexpr std::size_t end_position = std::numeric_limits<std::size_t>::max();
+
+private:
+    const document* doc_ = nullptr;
+    std::size_t at_ = end_position;
+};
+
+/*
+ * member_iterator
+ */
+class value::member_iterator {
+public:
+    constexpr member_iterator() = default;
+
+    constexpr member_iterator(const document* doc, std::size_t at) :
+        doc_(doc), at_(at)
+    {}
+
+    constexpr member operator*() const {
+        return { value(doc_, at_).string(), value(doc_, at_ + 3) };
+    }
+
+    constexpr member_iterator& operator++() {
+        const std::size_t next = doc_->skip(at_ + 3);
+        at_ = doc_->token(next) == ',' && doc_->token(next + 1) == '"' ? next + 1 : end_position;
+        return *this;
+    }
+
+    constexpr bool operator==(const member_iterator& other) const { return at_ == other.at_; }
+    constexpr bool operator!=(const member_iterator& other) const { return at_ != other.at_; }
+
+    static constexpr std::size_t end_position = std::numeric_limits<std::size_t>::max();
+
+private:
+    const document* doc_ = nullptr;
+    std::size_t at_ = end_position;
+};
+
+constexpr value::range<value::element_iterator> value::elements() const {
+    if (!is_array() || doc_->token(at_ + 1) == ']') {
+        return { {}, {} };
+    }
+    return { { doc_, at_ + 1 }, {} };
+}
+
+constexpr value::range<value::member_iterator> value::members() const {
+    if (!is_object() || doc_->token(at_ + 1) != '"' || doc_->token(at_ + 3) == '\0') {
+        return { {}, {} };
+    }
+    return { { doc_, at_ + 1 }, {} };
+}
+
+constexpr value value::operator[](std::string_view key) const {
+    for (const auto m : members()) {
+        if (m.key == key) {
+            return m.value;
+        }
+    }
+    return {};
+}
+
+constexpr value value::operator[](std::size_t i) const {
+    for (const auto e : elements()) {
+        if (i-- == 0) {
+            return e;
+        }
+    }
+    return {};
+}
+
+constexpr value document::root() const {
+    return status_ == error::none ? value(this, 0) : value();
+}
+
+/*
+ * parser
+ *
+ * Owns the structural index buffer and reuses it across documents, so
+ * steady-state parsing does not allocate. A document is valid until the
+ * next call to 'parse'; the text must outlive it.
+ */
+class parser {
+public:
+    document parse(std::string_view text) {
+        if (text.size() >= std::numeric_limits<std::uint32_t>::max()) {
+            return { text, nullptr, 0, error::too_large };
+        }
+        if (index_.size() < text.size() + 1) {
+            index_.resize(text.size() + 1);
+        }
+        error status = error::none;
+        const std::size_t count = impl::index_simd(text.data(), text.size(), index_.data(), status);
+        return { text, index_.data(), count, status };
+    }
+
+private:
+    std::vector<std::uint32_t> index_;
+};
+
+/*
+ * constant_document
+ *
+ * Structural index of a JSON text with static storage duration, built once
+ * at compile time and sized to exactly the structurals it holds; a text
+ * that fails 'check_grammar' does not compile. 'value'
+ * is a document that can be walked in constant expressions, so a value
+ * looked up by constant keys is a constant itself: a direct offset into the
+ * index that runtime code reads without parsing.
+ */
+template<const auto& TEXT>
+struct constant_document {
+private:
+    static constexpr std::size_t length = sizeof(TEXT) - 1;
+
+    static constexpr auto scan() {
+        std::array<std::uint32_t, length + 1> index = {};
+        error status = error::empty;
+        const std::size_t count = impl::index_scalar(TEXT, length, index.data(), status);
+        if (status == error::none) {
+            std::array<char, length + 1> stack = {};
+            status = impl::check_grammar({ TEXT, length }, index.data(), count, stack.data());
+        }
+        return std::make_tuple(index, count, status);
+    }
+
+    static constexpr auto trim() {
+        std::array<std::uint32_t, std::get<1>(scan())> index = {};
+        for (std::size_t i = 0; i < index.size(); ++i) {
+            index[i] = std::get<0>(scan())[i];
+        }
+        return index;
+    }
+
+public:
+    static constexpr error status = std::get<2>(scan());
+    static constexpr std::array<std::uint32_t, std::get<1>(scan())> index = trim();
+    static constexpr document value = { { TEXT, length }, index.data(), index.size(), status };
+
+    static_assert(status == error::none, "malformed JSON constant");
+};
+
+/*
+ * constant_document_v
+ */
+template<const auto& TEXT>
+inline constexpr const document& constant_document_v = constant_document<TEXT>::value;
+
+/*
+ * writer
+ *
+ * Writes JSON into a caller buffer: numbers are formatted in place by the
+ * radix layer and separators are inserted automatically. Once the buffer
+ * is exhausted further output is dropped and 'good' turns false.
+ */
+class writer {
+public:
+    constexpr writer(char* first, char* last) :
+        first_(first), last_(last), p_(first)
+    {}
+
+    constexpr writer& begin_object() { return open('{'); }
+    constexpr writer& end_object() { return close('}'); }
+    constexpr writer& begin_array() { return open('['); }
+    constexpr writer& end_array() { return close(']'); }
+
+    constexpr writer& key(std::string_view name) {
+        separate();
+        quote(name);
+        put(':');
+        separator_ = false;
+        return *this;
+    }
+
+    constexpr writer& string(std::string_view text) {
+        separate();
+        quote(text);
+        separator_ = true;
+        return *this;
+    }
+
+    template<typename V, typename = std::enable_if_t<std::is_integral<V>::value && !std::is_same<V, bool>::value>>
+    constexpr writer& number(V value) {
+        separate();
+        return formatted(ftl::to_chars(p_, last_, value));
+    }
+
+    template<std::size_t BITS, typename T>
+    constexpr writer& number(const bigint<BITS, T>& value) {
+        separate();
+        return formatted(ftl::to_chars(p_, last_, value));
+    }
+
+    constexpr writer& boolean(bool value) {
+        return literal(value ? "true" : "false");
+    }
+
+    constexpr writer& null() {
+        return literal("null");
+    }
+
+    /*
+     * raw_string (String contents that are already escaped)
+     */
+    constexpr writer& raw_string(std::string_view text) {
+        separate();
+        put('"');
+        for (const char c : text) {
+            put(c);
+        }
+        put('"');
+        separator_ = true;
+        return *this;
+    }
+
+    /*
+     * raw (Pre-formatted JSON value)
+     */
+    constexpr writer& raw(std::string_view text) {
+        return literal(text);
+    }
+
+    constexpr bool good() const {
+        return !overflow_;
+    }
+
+    constexpr std::size_t size() const {
+        return static_cast<std::size_t>(p_ - first_);
+    }
+
+    constexpr std::string_view view() const {
+        return { first_, size() };
+    }
+
+private:
+    constexpr void put(char c) {
+        if (overflow_ || p_ == last_) {
+            overflow_ = true;
+        } else {
+            *p_++ = c;
+        }
+    }
+
+    constexpr void separate() {
+        if (separator_) {
+            put(',');
+        }
+    }
+
+    constexpr void quote(std::string_view text) {
+        constexpr char hex[] = "0123456789abcdef";
+        put('"');
+        for (const char c : text) {
+            switch (c) {
+                case '"': put('\\'); put('"'); break;
+                case '\\': put('\\'); put('\\'); break;
+                case '\n': put('\\'); put('n'); break;
+                case '\r': put('\\'); put('r'); break;
+                case '\t': put('\\'); put('t'); break;
+                default:
+                    if (static_cast<unsigned char>(c) < 0x20) {
+                        put('\\'); put('u'); put('0'); put('0');
+                        put(hex[(c >> 4) & 0xF]);
+                        put(hex[c & 0xF]);
+                    } else {
+                        put(c);
+                    }
+            }
+        }
+        put('"');
+    }
+
+    constexpr writer& open(char bracket) {
+        separate();
+        put(bracket);
+        separator_ = false;
+        return *this;
+    }
+
+    constexpr writer& close(char bracket) {
+        put(bracket);
+        separator_ = true;
+        return *this;
+    }
+
+    constexpr writer& literal(std::string_view text) {
+        separate();
+        for (const char c : text) {
+            put(c);
+        }
+        separator_ = true;
+        return *this;
+    }
+
+    constexpr writer& formatted(std::to_chars_result result) {
+        if (overflow_ || result.ec != std::errc{}) {
+            overflow_ = true;
+        } else {
+            p_ = result.ptr;
+        }
+        separator_ = true;
+        return *this;
+    }
+
+    char* first_;
+    char* last_;
+    char* p_;
+    bool separator_ = false;
+    bool overflow_ = false;
+};
+
+/*
+ * unescape (Decode a raw string into 'out', which needs 'raw.size()' bytes)
+ *
+ * Returns the end of the decoded text, or nullptr for a malformed escape.
+ */
+constexpr char* unescape(std::string_view raw, char* out) {
+    const auto hex = [](std::string_view text, std::size_t at, std::uint32_t& code) {
+        code = 0;
+        if (at + 4 > text.size()) {
+            return false;
+        }
+        for (std::size_t i = at; i < at + 4; ++i) {
+            const char c = text[i];
+            const std::uint32_t digit = c >= '0' && c <= '9' ? static_cast<std::uint32_t>(c - '0')
+                : c >= 'a' && c <= 'f' ? static_cast<std::uint32_t>(c - 'a' + 10)
+                : c >= 'A' && c <= 'F' ? static_cast<std::uint32_t>(c - 'A' + 10)
+                : 16;
+            if (digit == 16) {
+                return false;
+            }
+            code = (code << 4) | digit;
+        }
+        return true;
+    };
+
+    for (std::size_t i = 0; i < raw.size(); ++i) {
+        if (raw[i] != '\\') {
+            *out++ = raw[i];
+            continue;
+        }
+        if (++i == raw.size()) {
+            return nullptr;
+        }
+        switch (raw[i]) {
+            case '"': *out++ = '"'; break;
+            case '\\': *out++ = '\\'; break;
+            case '/': *out++ = '/'; break;
+            case 'b': *out++ = '\b'; break;
+            case 'f': *out++ = '\f'; break;
+            case 'n': *out++ = '\n'; break;
+            case 'r': *out++ = '\r'; break;
+            case 't': *out++ = '\t'; break;
+            case 'u': {
+                std::uint32_t code = 0;
+                if (!hex(raw, i + 1, code)) {
+                    return nullptr;
+                }
+                i += 4;
+                if (code >= 0xD800 && code < 0xDC00) {
+                    std::uint32_t low = 0;
+                    if (i + 2 >= raw.size() || raw[i + 1] != '\\' || raw[i + 2] != 'u'
+                        || !hex(raw, i + 3, low) || low < 0xDC00 || low >= 0xE000) {
+                        return nullptr;
+                    }
+                    i += 6;
+                    code = 0x10000 + ((code - 0xD800) << 10) + (low - 0xDC00);
+                } else if (code >= 0xDC00 && code < 0xE000) {
+                    return nullptr;
+                }
+                if (code < 0x80) {
+                    *out++ = static_cast<char>(code);
+                } else if (code < 0x800) {
+                    *out++ = static_cast<char>(0xC0 | (code >> 6));
+                    *out++ = static_cast<char>(0x80 | (code & 0x3F));
+                } else if (code < 0x10000) {
+                    *out++ = static_cast<char>(0xE0 | (code >> 12));
+                    *out++ = static_cast<char>(0x80 | ((code >> 6) & 0x3F));
+                    *out++ = static_cast<char>(0x80 | (code & 0x3F));
+                } else {
+                    *out++ = static_cast<char>(0xF0 | (code >> 18));
+                    *out++ = static_cast<char>(0x80 | ((code >> 12) & 0x3F));
+                    *out++ = static_cast<char>(0x80 | ((code >> 6) & 0x3F));
+                    *out++ = static_cast<char>(0x80 | (code & 0x3F));
+                }
+                break;
+            }
+            default:
+                return nullptr;
+        }
+    }
+    return out;
+}
+
+} //namespace json
+} //namespace ftl
+
+/*
+ * escaped_mask
+ */
+static_assert([] {
+    std::uint64_t carry = 0;
+    return ftl::json::impl::escaped_mask(0b0110, carry) == 0b0100 && carry == 0;
+}());
+static_assert([] {
+    std::uint64_t carry = 0;
+    return ftl::json::impl::escaped_mask(0b0111, carry) == 0b1010 && carry == 0;
+}());
+static_assert([] {
+    std::uint64_t carry = 0;
+    const std::uint64_t escaped = ftl::json::impl::escaped_mask(std::uint64_t{ 1 } << 63, carry);
+    return escaped == 0 && carry == 1 && ftl::json::impl::escaped_mask(0b1, carry) == 0b1 && carry == 0;
+}());
+
+/*
+ * is_literal
+ */
+static_assert(ftl::json::impl::is_literal("null") && ftl::json::impl::is_literal("-0.5e+10"));
+static_assert(!ftl::json::impl::is_literal("nul") && !ftl::json::impl::is_literal("01") && !ftl::json::impl::is_literal("1."));
+
+/*
+ * check_grammar
+ */
+static_assert([] {
+    constexpr std::string_view text = R"({"a":})";
+    std::uint32_t index[8] = {};
+    char stack[8] = {};
+    ftl::json::error status = ftl::json::error::none;
+    const std::size_t count = ftl::json::impl::index_scalar(text.data(), text.size(), index, status);
+    return status == ftl::json::error::none && ftl::json::impl::check_grammar(text, index, count, stack) == ftl::json::error::syntax;
+}());
+
+/*
+ * prefix_xor
+ */
+static_assert(ftl::json::impl::prefix_xor(0b1001) == 0b0111);
+static_assert(ftl::json::impl::prefix_xor(0b100001000) == 0b011111000);
+
+/*
+ * index_scalar
+ */
+static_assert([] {
+    const char text[] = R"({"a\"":[1, true]})";
+    std::uint32_t index[sizeof(text)] = {};
+    ftl::json::error status = ftl::json::error::empty;
+    const std::size_t count = ftl::json::impl::index_scalar(text, sizeof(text) - 1, index, status);
+    const std::uint32_t expected[] = { 0, 1, 5, 6, 7, 8, 9, 11, 15, 16 };
+    for (std::size_t i = 0; i < count; ++i) {
+        if (index[i] != expected[i]) {
+            return false;
+        }
+    }
+    return status == ftl::json::error::none && count == 10;
+}());
+static_assert([] {
+    const char text[] = R"({"a)";
+    std::uint32_t index[sizeof(text)] = {};
+    ftl::json::error status = ftl::json::error::none;
+    ftl::json::impl::index_scalar(text, sizeof(text) - 1, index, status);
+    return status == ftl::json::error::unclosed_string;
+}());
+
+/*
+ * document & value
+ */
+static_assert([] {
+    const char text[] = R"( {"name": "ftl", "tags": ["fast", "light"], "size": -12.5e3, "ok": true, "none": null, "nested": {"x": {}} } )";
+    std::uint32_t index[sizeof(text)] = {};
+    ftl::json::error status = ftl::json::error::empty;
+    const std::size_t count = ftl::json::impl::index_scalar(text, sizeof(text) - 1, index, status);
+    const ftl::json::document doc(std::string_view(text, sizeof(text) - 1), index, count, status);
+    const auto root = doc.root();
+    return root.is_object()
+        && root["name"].string() == "ftl"
+        && root["tags"].is_array()
+        && root["tags"][1].string() == "light"
+        && !root["tags"][2]
+        && root["size"].is_number()
+        && root["size"].raw() == "-12.5e3"
+        && root["ok"].boolean()
+        && root["none"].is_null()
+        && root["nested"]["x"].raw() == "{}"
+        && root["tags"].raw() == R"(["fast", "light"])"
+        && !root["missing"];
+}());
+static_assert([] {
+    const char text[] = R"([[], {}, [1, [2, 3]], "x"])";
+    std::uint32_t index[sizeof(text)] = {};
+    ftl::json::error status = ftl::json::error::empty;
+    const std::size_t count = ftl::json::impl::index_scalar(text, sizeof(text) - 1, index, status);
+    const ftl::json::document doc(std::string_view(text, sizeof(text) - 1), index, count, status);
+    std::size_t n = 0;
+    for (const auto e : doc.root().elements()) {
+        n += e ? 1 : 0;
+    }
+    return n == 4 && doc.root()[2][1][1].raw() == "3" && doc.root()[3].string() == "x"
+        && doc.root()[0].elements().begin() == doc.root()[0].elements().end();
+}());
+
+/*
+ * value::get
+ */
+static_assert([] {
+    const char text[] = R"([255, 256, -128, -129, 0, -0, 01, 1.5, 1e3, "7", 115792089237316195423570985008687907853269984665640564039457584007913129639935, 115792089237316195423570985008687907853269984665640564039457584007913129639936])";
+    std::uint32_t index[sizeof(text)] = {};
+    ftl::json::error status = ftl::json::error::empty;
+    const std::size_t count = ftl::json::impl::index_scalar(text, sizeof(text) - 1, index, status);
+    const ftl::json::document doc(std::string_view(text, sizeof(text) - 1), index, count, status);
+    const auto root = doc.root();
+    std::uint8_t u8 = 0;
+    std::int8_t i8 = 0;
+    ftl::bigint<256> b256 = {};
+    return root[0].get(u8) == std::errc{} && u8 == 255
+        && root[1].get(u8) == std::errc::result_out_of_range && u8 == 255
+        && root[2].get(i8) == std::errc{} && i8 == -128
+        && root[3].get(i8) == std::errc::result_out_of_range
+        && root[2].get(u8) == std::errc::result_out_of_range
+        && root[5].get(u8) == std::errc{} && u8 == 0
+        && root[6].get(u8) == std::errc::invalid_argument
+        && root[7].get(u8) == std::errc::invalid_argument
+        && root[8].get(u8) == std::errc::invalid_argument
+        && root[9].get(u8) == std::errc::invalid_argument
+        && root[10].get(b256) == std::errc{} && b256[0] == 0xFFFFFFFF && b256[7] == 0xFFFFFFFF
+        && root[11].get(b256) == std::errc::result_out_of_range;
+}());
+
+/*
+ * writer
+ */
+static_assert([] {
+    char buffer[96] = {};
+    ftl::json::writer out(buffer, buffer + sizeof(buffer));
+    out.begin_object()
+        .key("id").number(0xFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFF_16)
+        .key("n").number(-42)
+        .key("s").string("a\"b\n\x01")
+        .key("l").begin_array().boolean(true).null().begin_object().end_object().end_array()
+        .end_object();
+    return out.good() && out.view() == R"({"id":340282366920938463463374607431768211455,"n":-42,"s":"a\"b\n\u0001","l":[true,null,{}]})";
+}());
+static_assert([] {
+    char buffer[4] = {};
+    ftl::json::writer out(buffer, buffer + sizeof(buffer));
+    out.begin_array().number(12345).end_array();
+    return !out.good() && out.size() == 1;
+}());
+
+/*
+ * unescape
+ */
+static_assert([] {
+    char out[16] = {};
+    const std::string_view raw = R"(a\"\\\u00e9\n)";
+    char* end = ftl::json::unescape(raw, out);
+    return end == out + 6 && out[0] == 'a' && out[1] == '"' && out[2] == '\\'
+        && out[3] == '\xC3' && out[4] == '\xA9' && out[5] == '\n';
+}());
+static_assert([] {
+    char out[16] = {};
+    return ftl::json::unescape(R"(\ud83d\ude00)", out) == out + 4 && out[0] == '\xF0'
+        && out[1] == '\x9F' && out[2] == '\x98' && out[3] == '\x80'
+        && ftl::json::unescape(R"(é)", out) == out + 2 && out[0] == '\xC3' && out[1] == '\xA9'
+        && ftl::json::unescape(R"(\x)", out) == nullptr
+        && ftl::json::unescape(R"(\uDE00)", out) == nullptr
+        && ftl::json::unescape(R"(\ud83dx)", out) == nullptr;
+}());
+
+#endif//FTL_JSON_HH
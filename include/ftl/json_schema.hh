@@ -0,0 +1,286 @@
+#ifndef FTL_JSON_SCHEMA_HH
+#define FTL_JSON_SCHEMA_HH
+
+#include <ftl/bigint_base.hh>
+#include <ftl/json.hh>
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <system_error>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+namespace ftl {
+namespace json {
+
+/*
+ * field_descriptor (JSON key and member pointer)
+ */
+template<typename S, typename M>
+struct field_descriptor {
+    std::string_view name;
+    M S::* member;
+};
+
+/*
+ * field
+ */
+template<typename S, typename M>
+constexpr field_descriptor<S, M> field(std::string_view name, M S::* member) {
+    return { name, member };
+}
+
+/*
+ * fields (Specialize with a constexpr tuple of 'field's named 'value')
+ *
+ *   template<>
+ *   struct ftl::json::fields<account> {
+ *       static constexpr auto value = std::make_tuple(
+ *           field("id", &account::id),
+ *           field("balance", &account::balance));
+ *   };
+ */
+template<typename S>
+struct fields;
+
+namespace impl {
+
+/*
+ * has_fields
+ */
+template<typename S, typename = void>
+struct has_fields : std::false_type {};
+
+template<typename S>
+struct has_fields<S, std::void_t<decltype(fields<S>::value)>> : std::true_type {};
+
+/*
+ * is_bigint
+ */
+template<typename V>
+struct is_bigint : std::false_type {};
+
+template<std::size_t BITS, typename T>
+struct is_bigint<bigint<BITS, T>> : std::true_type {};
+
+/*
+ * is_std_array
+ */
+template<typename V>
+struct is_std_array : std::false_type {};
+
+template<typename T, std::size_t N>
+struct is_std_array<std::array<T, N>> : std::true_type {};
+
+/*
+ * key_hash (FNV-1a with a seed)
+ */
+constexpr std::uint32_t key_hash(std::string_view key, std::uint32_t seed) {
+    std::uint32_t hash = 2166136261u ^ seed;
+    for (const char c : key) {
+        hash = (hash ^ static_cast<unsigned char>(c)) * 16777619u;
+    }
+    return hash;
+}
+
+/*
+ * key_table (Perfect hash of a struct's keys)
+ *
+ * The seed is searched at compile time so every key lands in its own slot
+ * of a power-of-two table; a lookup is one hash, one slot load and one
+ * key comparison.
+ */
+template<typename S>
+struct key_table {
+    static constexpr std::size_t count = std::tuple_size<std::decay_t<decltype(fields<S>::value)>>::value;
+
+    static constexpr std::size_t size = [] {
+        std::size_t size = 1;
+        while (size < 2 * count) {
+            size *= 2;
+        }
+        return size;
+    }();
+
+    static constexpr std::array<std::string_view, count> names = std::apply([](const auto&... f) {
+        return std::array<std::string_view, count>{ f.name... };
+    }, fields<S>::value);
+
+    static constexpr bool unique = [] {
+        for (std::size_t i = 0; i < count; ++i) {
+            for (std::size_t j = i + 1; j < count; ++j) {
+                if (names[i] == names[j]) {
+                    return false;
+                }
+            }
+        }
+        return true;
+    }();
+    static_assert(unique, "duplicate JSON field name");
+
+    static constexpr std::uint32_t seed = [] {
+        for (std::uint32_t seed = 0;; ++seed) {
+            std::array<bool, size> used = {};
+            bool collision = false;
+            for (std::size_t i = 0; i < count && !collision; ++i) {
+                const std::size_t slot = key_hash(names[i], seed) & (size - 1);
+                collision = used[slot];
+                used[slot] = true;
+            }
+            if (!collision) {
+                return seed;
+            }
+        }
+    }();
+
+    // Field index + 1 per slot, zero when empty
+    static constexpr std::array<std::size_t, size> slots = [] {
+        std::array<std::size_t, size> slots = {};
+        for (std::size_t i = 0; i < count; ++i) {
+            slots[key_hash(names[i], seed) & (size - 1)] = i + 1;
+        }
+        return slots;
+    }();
+
+    /*
+     * find (Field index, or 'count' for an unknown key)
+     */
+    static constexpr std::size_t find(std::string_view key) {
+        const std::size_t slot = slots[key_hash(key, seed) & (size - 1)];
+        return slot != 0 && names[slot - 1] == key ? slot - 1 : count;
+    }
+};
+
+template<typename V>
+constexpr std::errc read(const value& in, V& out);
+
+template<typename V>
+constexpr void write(writer& out, const V& value);
+
+/*
+ * read_field (Member selected by a runtime index)
+ */
+template<typename S, std::size_t... I>
+constexpr std::errc read_field(std::size_t i, const value& in, S& out, std::index_sequence<I...>) {
+    std::errc ec = std::errc{};
+    ((i == I ? (ec = read(in, out.*(std::get<I>(fields<S>::value).member)), true) : false) || ...);
+    return ec;
+}
+
+/*
+ * read
+ */
+template<typename V>
+constexpr std::errc read(const value& in, V& out) {
+    if constexpr (std::is_same<V, bool>::value) {
+        if (!in.is_boolean()) {
+            return std::errc::invalid_argument;
+        }
+        out = in.boolean();
+        return std::errc{};
+    } else if constexpr (std::is_integral<V>::value || is_bigint<V>::value) {
+        return in.get(out);
+    } else if constexpr (std::is_same<V, std::string_view>::value) {
+        if (!in.is_string()) {
+            return std::errc::invalid_argument;
+        }
+        out = in.string();
+        return std::errc{};
+    } else if constexpr (is_std_array<V>::value) {
+        if (!in.is_array()) {
+            return std::errc::invalid_argument;
+        }
+        std::size_t i = 0;
+        for (const auto element : in.elements()) {
+            if (i == out.size()) {
+                return std::errc::result_out_of_range;
+            }
+            const std::errc ec = read(element, out[i++]);
+            if (ec != std::errc{}) {
+                return ec;
+            }
+        }
+        return std::errc{};
+    } else {
+        static_assert(has_fields<V>::value, "type has no JSON fields");
+        if (!in.is_object()) {
+            return std::errc::invalid_argument;
+        }
+        using table = key_table<V>;
+        for (const auto m : in.members()) {
+            const std::size_t i = table::find(m.key);
+            if (i != table::count) {
+                const std::errc ec = read_field(i, m.value, out, std::make_index_sequence<table::count>{});
+                if (ec != std::errc{}) {
+                    return ec;
+                }
+            }
+        }
+        return std::errc{};
+    }
+}
+
+/*
+ * write
+ */
+template<typename V>
+constexpr void write(writer& out, const V& value) {
+    if constexpr (std::is_same<V, bool>::value) {
+        out.boolean(value);
+    } else if constexpr (std::is_integral<V>::value || is_bigint<V>::value) {
+        out.number(value);
+    } else if constexpr (std::is_same<V, std::string_view>::value) {
+        out.raw_string(value);
+    } else if constexpr (is_std_array<V>::value) {
+        out.begin_array();
+        for (const auto& element : value) {
+            write(out, element);
+        }
+        out.end_array();
+    } else {
+        static_assert(has_fields<V>::value, "type has no JSON fields");
+        out.begin_object();
+        std::apply([&](const auto&... f) {
+            ((out.key(f.name), write(out, value.*(f.member))), ...);
+        }, fields<V>::value);
+        out.end_object();
+    }
+}
+
+} //namespace impl
+
+/*
+ * from_json
+ *
+ * Reads the members of a JSON object straight into 'out', matching keys
+ * through the struct's perfect hash; unknown keys are skipped and missing
+ * ones leave their member untouched. Keys are compared in raw form, and
+ * 'string_view' members receive the raw string contents. Stops at the
+ * first member that does not convert and returns its error.
+ */
+template<typename S>
+constexpr std::errc from_json(const value& in, S& out) {
+    return impl::read(in, out);
+}
+
+template<typename S>
+constexpr std::errc from_json(const document& in, S& out) {
+    return in.status() == error::none ? impl::read(in.root(), out) : std::errc::invalid_argument;
+}
+
+/*
+ * to_json
+ */
+template<typename S>
+constexpr writer& to_json(writer& out, const S& value) {
+    impl::write(out, value);
+    return out;
+}
+
+} //namespace json
+} //namespace ftl
+
+#endif//FTL_JSON_SCHEMA_HH
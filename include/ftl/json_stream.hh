@@ -0,0 +1,266 @@
+#ifndef FTL_JSON_STREAM_HH
+#define FTL_JSON_STREAM_HH
+
+#include <ftl/json.hh>
+#include <ftl/mapped_file.hh>
+#include <ftl/parallel.hh>
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstring>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#if defined(FTL_MAPPED_FILE_POSIX)
+#include <unistd.h>
+#endif
+
+namespace ftl {
+namespace json {
+namespace impl {
+
+/*
+ * find_newline (Scalar)
+ *
+ * JSON strings cannot hold a raw newline, so every '\n' of an NDJSON text
+ * ends a record and no quote tracking is needed to find boundaries.
+ */
+constexpr std::size_t find_newline(std::string_view text, std::size_t from) {
+    for (; from < text.size(); ++from) {
+        if (text[from] == '\n') {
+            return from;
+        }
+    }
+    return text.size();
+}
+
+/*
+ * find_newline_simd
+ */
+inline std::size_t find_newline_simd(std::string_view text, std::size_t from) {
+#if defined(__AVX2__)
+    const __m256i newline = _mm256_set1_epi8('\n');
+    for (; from + block_size::value <= text.size(); from += block_size::value) {
+        const char* p = text.data() + from;
+        const std::uint64_t mask = movemask_avx2(
+            _mm256_cmpeq_epi8(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(p)), newline),
+            _mm256_cmpeq_epi8(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(p + 32)), newline));
+        if (mask != 0) {
+            return from + static_cast<std::size_t>(__builtin_ctzll(mask));
+        }
+    }
+    return find_newline(text, from);
+#else
+    if (from >= text.size()) {
+        return text.size();
+    }
+    const void* found = std::memchr(text.data() + from, '\n', text.size() - from);
+    return found == nullptr ? text.size() : static_cast<std::size_t>(static_cast<const char*>(found) - text.data());
+#endif
+}
+
+/*
+ * record_boundary (Start of the first record at or after 'at')
+ */
+constexpr std::size_t record_boundary(std::string_view text, std::size_t at) {
+    if (at == 0 || at >= text.size()) {
+        return at == 0 ? 0 : text.size();
+    }
+    const std::size_t newline = find_newline(text, at - 1);
+    return newline == text.size() ? newline : newline + 1;
+}
+
+/*
+ * is_blank (Whitespace only)
+ */
+constexpr bool is_blank(std::string_view text) {
+    for (const char c : text) {
+        if (!is_whitespace(c)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/*
+ * for_each_record
+ */
+template<typename FIND, typename F>
+constexpr void for_each_record(std::string_view text, FIND&& find, F&& f) {
+    std::size_t first = 0;
+    while (first < text.size()) {
+        const std::size_t last = find(text, first);
+        std::string_view record = text.substr(first, last - first);
+        if (!record.empty() && record.back() == '\r') {
+            record.remove_suffix(1);
+        }
+        if (!is_blank(record)) {
+            f(record);
+        }
+        first = last + 1;
+    }
+}
+
+} //namespace impl
+
+/*
+ * for_each_record
+ *
+ * Calls 'f' with a view of every non-blank line of an NDJSON text, without
+ * a trailing '\r'.
+ */
+template<typename F>
+void for_each_record(std::string_view text, F&& f) {
+    impl::for_each_record(text, impl::find_newline_simd, f);
+}
+
+/*
+ * split_records (Disjoint ranges of whole records)
+ *
+ * Cuts 'text' into at most 'parts' ranges of about equal size, each
+ * starting and ending on a record boundary, so they can be read in
+ * parallel. Empty ranges are dropped.
+ */
+inline std::vector<std::string_view> split_records(std::string_view text, std::size_t parts) {
+    std::vector<std::string_view> ranges;
+    parts = parts == 0 ? 1 : parts;
+    std::size_t first = 0;
+    for (std::size_t i = 1; i <= parts && first < text.size(); ++i) {
+        const std::size_t last = i == parts
+            ? text.size()
+            : impl::record_boundary(text, std::max(first, text.size() / parts * i));
+        if (last > first) {
+            ranges.push_back(text.substr(first, last - first));
+        }
+        first = last;
+    }
+    return ranges;
+}
+
+/*
+ * for_each_record_parallel
+ *
+ * Splits 'text' with 'split_records' and reads each range on its own
+ * thread; 'f' is called as 'f(worker, record)' with a worker number below
+ * 'threads', so per-thread state such as a 'parser' can be indexed by it.
+ */
+template<typename F>
+void for_each_record_parallel(std::string_view text, std::size_t threads, F&& f) {
+    const std::vector<std::string_view> ranges = split_records(text, threads);
+    parallel_invoke(ranges.size(), [&](std::size_t worker) {
+        for_each_record(ranges[worker], [&](std::string_view record) { f(worker, record); });
+    });
+}
+
+#if defined(FTL_MAPPED_FILE_POSIX)
+/*
+ * mapped_file
+ */
+using ftl::mapped_file;
+
+/*
+ * record_reader (Pipes and other unmappable descriptors)
+ *
+ * Reads into one of two reusable buffers; a record cut by the end of a
+ * read is moved to the front of the other buffer and completed there. A
+ * buffer only grows for a record longer than it. Records are valid until
+ * the next call to 'next'.
+ */
+class record_reader {
+public:
+    explicit record_reader(int fd, std::size_t capacity = std::size_t{ 1 } << 20) :
+        fd_(fd)
+    {
+        buffers_[0].resize(capacity == 0 ? 1 : capacity);
+        buffers_[1].resize(buffers_[0].size());
+    }
+
+    bool next(std::string_view& record) {
+        for (;;) {
+            const std::vector<char>& buffer = buffers_[current_];
+            const std::string_view pending(buffer.data() + first_, last_ - first_);
+            const std::size_t newline = impl::find_newline_simd(pending, scanned_);
+            if (newline == pending.size() && !eof_) {
+                scanned_ = pending.size();
+                refill();
+                continue;
+            }
+            if (pending.empty()) {
+                return false;
+            }
+            record = pending.substr(0, newline);
+            first_ += newline == pending.size() ? newline : newline + 1;
+            scanned_ = 0;
+            if (!record.empty() && record.back() == '\r') {
+                record.remove_suffix(1);
+            }
+            if (!impl::is_blank(record)) {
+                return true;
+            }
+        }
+    }
+
+    bool good() const {
+        return !failed_;
+    }
+
+private:
+    void refill() {
+        const std::size_t tail = last_ - first_;
+        std::vector<char>& next = buffers_[current_ ^ 1];
+        if (next.size() < tail * 2) {
+            next.resize(tail * 2);
+        }
+        std::memcpy(next.data(), buffers_[current_].data() + first_, tail);
+        current_ ^= 1;
+        first_ = 0;
+        last_ = tail;
+
+        const ::ssize_t count = ::read(fd_, next.data() + last_, next.size() - last_);
+        if (count <= 0) {
+            eof_ = true;
+            failed_ = count < 0;
+        } else {
+            last_ += static_cast<std::size_t>(count);
+        }
+    }
+
+    int fd_;
+    std::array<std::vector<char>, 2> buffers_;
+    std::size_t current_ = 0;
+    std::size_t first_ = 0;
+    std::size_t last_ = 0;
+    std::size_t scanned_ = 0;
+    bool eof_ = false;
+    bool failed_ = false;
+};
+#endif
+
+} //namespace json
+} //namespace ftl
+
+/*
+ * record_boundary
+ */
+static_assert(ftl::json::impl::record_boundary("{}\n[1]\n2", 0) == 0);
+static_assert(ftl::json::impl::record_boundary("{}\n[1]\n2", 1) == 3);
+static_assert(ftl::json::impl::record_boundary("{}\n[1]\n2", 3) == 3);
+static_assert(ftl::json::impl::record_boundary("{}\n[1]\n2", 4) == 7);
+static_assert(ftl::json::impl::record_boundary("{}\n[1]\n2", 8) == 8);
+
+/*
+ * for_each_record
+ */
+static_assert([] {
+    std::size_t count = 0;
+    std::size_t bytes = 0;
+    ftl::json::impl::for_each_record("{\"a\":1}\r\n\n  \n[2]\n3", ftl::json::impl::find_newline, [&](std::string_view record) {
+        ++count;
+        bytes += record.size();
+    });
+    return count == 3 && bytes == 11;
+}());
+
+#endif//FTL_JSON_STREAM_HH
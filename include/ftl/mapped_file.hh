@@ -0,0 +1,85 @@
+#ifndef FTL_MAPPED_FILE_HH
+#define FTL_MAPPED_FILE_HH
+
+#include <ftl/span.hh>
+
+#include <cstddef>
+#include <string_view>
+#include <utility>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define FTL_MAPPED_FILE_POSIX 1
+#endif
+
+namespace ftl {
+
+#if defined(FTL_MAPPED_FILE_POSIX)
+/*
+ * mapped_file (Read-only memory map)
+ */
+class mapped_file {
+public:
+    explicit mapped_file(const char* path) {
+        const int fd = ::open(path, O_RDONLY);
+        if (fd < 0) {
+            return;
+        }
+        struct stat info = {};
+        if (::fstat(fd, &info) == 0) {
+            size_ = static_cast<std::size_t>(info.st_size);
+            if (size_ == 0) {
+                good_ = true;
+            } else {
+                void* data = ::mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+                if (data != MAP_FAILED) {
+                    ::madvise(data, size_, MADV_SEQUENTIAL);
+                    data_ = static_cast<const char*>(data);
+                    good_ = true;
+                }
+            }
+        }
+        ::close(fd);
+    }
+
+    mapped_file(const mapped_file&) = delete;
+    mapped_file& operator=(const mapped_file&) = delete;
+
+    mapped_file(mapped_file&& other) noexcept :
+        data_(std::exchange(other.data_, nullptr)),
+        size_(std::exchange(other.size_, 0)),
+        good_(std::exchange(other.good_, false))
+    {}
+
+    ~mapped_file() {
+        if (data_ != nullptr) {
+            ::munmap(const_cast<char*>(data_), size_);
+        }
+    }
+
+    bool good() const {
+        return good_;
+    }
+
+    std::string_view view() const {
+        return { data_, data_ == nullptr ? 0 : size_ };
+    }
+
+    span<const std::byte> bytes() const {
+        return { reinterpret_cast<const std::byte*>(data_), data_ == nullptr ? 0 : size_ };
+    }
+
+private:
+    const char* data_ = nullptr;
+    std::size_t size_ = 0;
+    bool good_ = false;
+};
+
+#endif
+
+}//namespace ftl
+
+#endif//FTL_MAPPED_FILE_HH
@@ -0,0 +1,487 @@
+#ifndef FTL_MPN_HH
+#define FTL_MPN_HH
+
+#include <ftl/bigint_base.hh>
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+
+#if defined(__x86_64__)
+#include <immintrin.h>
+#endif
+
+namespace ftl {
+
+/*
+ * mpn (Limb kernels)
+ *
+ * Raw loops over caller-owned limbs, least significant first, in the
+ * spirit of GMP's mpn layer; the bigint operators are built on them. 'dst'
+ * may equal an input in every kernel, other overlaps are not supported
+ * except for the shifts, which may also move limbs within one buffer.
+ * At runtime on x86-64 the carry chains of 'add_n' and 'sub_n' use the
+ * ADC and SBB instructions.
+ */
+namespace mpn {
+namespace impl {
+
+template<typename T>
+using wide = typename ftl::impl::bigint_datatype<T>::overflow_type;
+
+template<typename T>
+struct digits : std::integral_constant<unsigned, std::numeric_limits<T>::digits> {};
+
+/*
+ * leading_zeros (Of a non-zero limb)
+ */
+template<typename T>
+constexpr unsigned leading_zeros(T x) {
+    return static_cast<unsigned>(__builtin_clzll(x)) - (64 - digits<T>::value);
+}
+
+#if defined(__x86_64__)
+/*
+ * add_n_adc (Carry chain on ADC)
+ */
+template<typename T>
+inline T add_n_adc(T* dst, const T* a, const T* b, std::size_t n) {
+    unsigned char carry = 0;
+    for (std::size_t i = 0; i < n; ++i) {
+        if constexpr (sizeof(T) == 8) {
+            unsigned long long sum;
+            carry = _addcarry_u64(carry, a[i], b[i], &sum);
+            dst[i] = static_cast<T>(sum);
+        } else {
+            unsigned int sum;
+            carry = _addcarry_u32(carry, a[i], b[i], &sum);
+            dst[i] = static_cast<T>(sum);
+        }
+    }
+    return carry;
+}
+
+/*
+ * sub_n_sbb (Borrow chain on SBB)
+ */
+template<typename T>
+inline T sub_n_sbb(T* dst, const T* a, const T* b, std::size_t n) {
+    unsigned char borrow = 0;
+    for (std::size_t i = 0; i < n; ++i) {
+        if constexpr (sizeof(T) == 8) {
+            unsigned long long difference;
+            borrow = _subborrow_u64(borrow, a[i], b[i], &difference);
+            dst[i] = static_cast<T>(difference);
+        } else {
+            unsigned int difference;
+            borrow = _subborrow_u32(borrow, a[i], b[i], &difference);
+            dst[i] = static_cast<T>(difference);
+        }
+    }
+    return borrow;
+}
+#endif
+
+} //namespace impl
+
+/*
+ * add_n (dst = a + b, n limbs; returns the carry)
+ */
+template<typename T>
+constexpr T add_n(T* dst, const T* a, const T* b, std::size_t n) {
+#if defined(__x86_64__)
+    if constexpr (sizeof(T) == 8 || sizeof(T) == 4) {
+        if (!__builtin_is_constant_evaluated()) {
+            return impl::add_n_adc(dst, a, b, n);
+        }
+    }
+#endif
+    T carry = 0;
+    for (std::size_t i = 0; i < n; ++i) {
+        const T sum = static_cast<T>(a[i] + carry);
+        carry = sum < carry;
+        const T result = static_cast<T>(sum + b[i]);
+        carry = static_cast<T>(carry + (result < sum));
+        dst[i] = result;
+    }
+    return carry;
+}
+
+/*
+ * sub_n (dst = a - b, n limbs; returns the borrow)
+ */
+template<typename T>
+constexpr T sub_n(T* dst, const T* a, const T* b, std::size_t n) {
+#if defined(__x86_64__)
+    if constexpr (sizeof(T) == 8 || sizeof(T) == 4) {
+        if (!__builtin_is_constant_evaluated()) {
+            return impl::sub_n_sbb(dst, a, b, n);
+        }
+    }
+#endif
+    T borrow = 0;
+    for (std::size_t i = 0; i < n; ++i) {
+        const T ai = a[i];
+        const T subtrahend = static_cast<T>(b[i] + borrow);
+        borrow = subtrahend < borrow;
+        borrow = static_cast<T>(borrow + (ai < subtrahend));
+        dst[i] = static_cast<T>(ai - subtrahend);
+    }
+    return borrow;
+}
+
+/*
+ * add_1 (dst = a + b, n limbs; returns the carry)
+ *
+ * In place, the loop stops as soon as the carry dies out.
+ */
+template<typename T>
+constexpr T add_1(T* dst, const T* a, std::size_t n, T b) {
+    for (std::size_t i = 0; i < n && (b != 0 || dst != a); ++i) {
+        const T sum = static_cast<T>(a[i] + b);
+        b = sum < b;
+        dst[i] = sum;
+    }
+    return b;
+}
+
+/*
+ * sub_1 (dst = a - b, n limbs; returns the borrow)
+ *
+ * In place, the loop stops as soon as the borrow dies out.
+ */
+template<typename T>
+constexpr T sub_1(T* dst, const T* a, std::size_t n, T b) {
+    for (std::size_t i = 0; i < n && (b != 0 || dst != a); ++i) {
+        const T ai = a[i];
+        dst[i] = static_cast<T>(ai - b);
+        b = ai < b;
+    }
+    return b;
+}
+
+/*
+ * add (dst = a + b for an >= bn; returns the carry)
+ */
+template<typename T>
+constexpr T add(T* dst, const T* a, std::size_t an, const T* b, std::size_t bn) {
+    const T carry = add_n(dst, a, b, bn);
+    return add_1(dst + bn, a + bn, an - bn, carry);
+}
+
+/*
+ * sub (dst = a - b for an >= bn; returns the borrow)
+ */
+template<typename T>
+constexpr T sub(T* dst, const T* a, std::size_t an, const T* b, std::size_t bn) {
+    const T borrow = sub_n(dst, a, b, bn);
+    return sub_1(dst + bn, a + bn, an - bn, borrow);
+}
+
+/*
+ * mul_1 (dst = a * b, n limbs; returns the high limb)
+ */
+template<typename T>
+constexpr T mul_1(T* dst, const T* a, std::size_t n, T b) {
+    using W = impl::wide<T>;
+    W carry = 0;
+    for (std::size_t i = 0; i < n; ++i) {
+        const W product = static_cast<W>(a[i]) * b + carry;
+        dst[i] = static_cast<T>(product);
+        carry = product >> impl::digits<T>::value;
+    }
+    return static_cast<T>(carry);
+}
+
+/*
+ * addmul_1 (dst += a * b, n limbs; returns the carry limb)
+ */
+template<typename T>
+constexpr T addmul_1(T* dst, const T* a, std::size_t n, T b) {
+    using W = impl::wide<T>;
+    W carry = 0;
+    for (std::size_t i = 0; i < n; ++i) {
+        const W product = static_cast<W>(a[i]) * b + dst[i] + carry;
+        dst[i] = static_cast<T>(product);
+        carry = product >> impl::digits<T>::value;
+    }
+    return static_cast<T>(carry);
+}
+
+/*
+ * submul_1 (dst -= a * b, n limbs; returns the borrow limb)
+ */
+template<typename T>
+constexpr T submul_1(T* dst, const T* a, std::size_t n, T b) {
+    using W = impl::wide<T>;
+    W carry = 0;
+    for (std::size_t i = 0; i < n; ++i) {
+        const W product = static_cast<W>(a[i]) * b + carry;
+        const T low = static_cast<T>(product);
+        const T di = dst[i];
+        carry = (product >> impl::digits<T>::value) + (di < low);
+        dst[i] = static_cast<T>(di - low);
+    }
+    return static_cast<T>(carry);
+}
+
+/*
+ * mul (dst = a * b, an + bn limbs; dst must not overlap a or b)
+ */
+template<typename T>
+constexpr void mul(T* dst, const T* a, std::size_t an, const T* b, std::size_t bn) {
+    if (bn == 0) {
+        for (std::size_t i = 0; i < an; ++i) {
+            dst[i] = 0;
+        }
+        return;
+    }
+    dst[an] = mul_1(dst, a, an, b[0]);
+    for (std::size_t j = 1; j < bn; ++j) {
+        dst[an + j] = addmul_1(dst + j, a, an, b[j]);
+    }
+}
+
+/*
+ * lshift (dst = a << shift, 0 < shift < limb bits; returns the bits
+ * shifted out, in the low bits)
+ *
+ * Runs from the top limb down, so 'dst' may also start above 'a'.
+ */
+template<typename T>
+constexpr T lshift(T* dst, const T* a, std::size_t n, unsigned shift) {
+    if (n == 0) {
+        return 0;
+    }
+    const unsigned back = impl::digits<T>::value - shift;
+    const T out = static_cast<T>(a[n - 1] >> back);
+    for (std::size_t i = n - 1; i > 0; --i) {
+        dst[i] = static_cast<T>(static_cast<T>(a[i] << shift) | (a[i - 1] >> back));
+    }
+    dst[0] = static_cast<T>(a[0] << shift);
+    return out;
+}
+
+/*
+ * rshift (dst = a >> shift, 0 < shift < limb bits; returns the bits
+ * shifted out, in the high bits)
+ *
+ * Runs from the bottom limb up, so 'dst' may also start below 'a'.
+ */
+template<typename T>
+constexpr T rshift(T* dst, const T* a, std::size_t n, unsigned shift) {
+    if (n == 0) {
+        return 0;
+    }
+    const unsigned back = impl::digits<T>::value - shift;
+    const T out = static_cast<T>(a[0] << back);
+    for (std::size_t i = 0; i + 1 < n; ++i) {
+        dst[i] = static_cast<T>((a[i] >> shift) | static_cast<T>(a[i + 1] << back));
+    }
+    dst[n - 1] = static_cast<T>(a[n - 1] >> shift);
+    return out;
+}
+
+/*
+ * cmp (Sign of a - b, n limbs)
+ */
+template<typename T>
+constexpr int cmp(const T* a, const T* b, std::size_t n) {
+    for (std::size_t i = n; i > 0; --i) {
+        if (a[i - 1] != b[i - 1]) {
+            return a[i - 1] < b[i - 1] ? -1 : 1;
+        }
+    }
+    return 0;
+}
+
+/*
+ * divrem_1 (q = a / d, n limbs; returns the remainder)
+ */
+template<typename T>
+constexpr T divrem_1(T* q, const T* a, std::size_t n, T d) {
+    using W = impl::wide<T>;
+    W remainder = 0;
+    for (std::size_t i = n; i > 0; --i) {
+        remainder = (remainder << impl::digits<T>::value) | a[i - 1];
+        q[i - 1] = static_cast<T>(remainder / d);
+        remainder %= d;
+    }
+    return static_cast<T>(remainder);
+}
+
+/*
+ * divrem (q = a / d and r = a % d, for an >= dn and d[dn - 1] != 0)
+ *
+ * Knuth's algorithm D: 'q' gets an - dn + 1 limbs and 'r' gets dn.
+ * 'scratch' holds the normalized operands, an + dn + 1 limbs; none of the
+ * buffers may overlap.
+ */
+template<typename T>
+constexpr void divrem(T* q, T* r, const T* a, std::size_t an, const T* d, std::size_t dn, T* scratch) {
+    using W = impl::wide<T>;
+    constexpr unsigned bits = impl::digits<T>::value;
+    if (dn == 1) {
+        r[0] = divrem_1(q, a, an, d[0]);
+        return;
+    }
+
+    const unsigned shift = impl::leading_zeros(d[dn - 1]);
+    T* const u = scratch;
+    T* const v = scratch + an + 1;
+    if (shift == 0) {
+        for (std::size_t i = 0; i < an; ++i) {
+            u[i] = a[i];
+        }
+        for (std::size_t i = 0; i < dn; ++i) {
+            v[i] = d[i];
+        }
+        u[an] = 0;
+    } else {
+        u[an] = lshift(u, a, an, shift);
+        lshift(v, d, dn, shift);
+    }
+
+    const W base = W{ 1 } << bits;
+    for (std::size_t j = an - dn + 1; j > 0; --j) {
+        T* const uj = u + j - 1;
+        const W top = (static_cast<W>(uj[dn]) << bits) | uj[dn - 1];
+        W qhat = top / v[dn - 1];
+        W rhat = top % v[dn - 1];
+        while (qhat >= base || qhat * v[dn - 2] > ((rhat << bits) | uj[dn - 2])) {
+            --qhat;
+            rhat += v[dn - 1];
+            if (rhat >= base) {
+                break;
+            }
+        }
+        const T borrow = submul_1(uj, v, dn, static_cast<T>(qhat));
+        const T head = uj[dn];
+        uj[dn] = static_cast<T>(head - borrow);
+        if (head < borrow) {
+            --qhat;
+            uj[dn] = static_cast<T>(uj[dn] + add_n(uj, uj, v, dn));
+        }
+        q[j - 1] = static_cast<T>(qhat);
+    }
+
+    if (shift == 0) {
+        for (std::size_t i = 0; i < dn; ++i) {
+            r[i] = u[i];
+        }
+    } else {
+        rshift(r, u, dn, shift);
+    }
+}
+
+/*
+ * normalized_size (n without leading zero limbs)
+ */
+template<typename T>
+constexpr std::size_t normalized_size(const T* a, std::size_t n) {
+    while (n > 0 && a[n - 1] == 0) {
+        --n;
+    }
+    return n;
+}
+
+} //namespace mpn
+}//namespace ftl
+
+/*
+ * add_n & sub_n
+ */
+static_assert([] {
+    std::uint8_t a[] = { 0xFF, 0xFF, 0x01 };
+    const std::uint8_t b[] = { 0x01, 0x00, 0x00 };
+    const std::uint8_t carry = ftl::mpn::add_n(a, a, b, 3);
+    const std::uint8_t borrow = ftl::mpn::sub_n(a, a, b, 3);
+    return carry == 0 && borrow == 0 && a[0] == 0xFF && a[1] == 0xFF && a[2] == 0x01;
+}());
+static_assert([] {
+    std::uint16_t r[2] = {};
+    const std::uint16_t a[] = { 0xFFFF, 0xFFFF };
+    const std::uint16_t b[] = { 1, 0 };
+    const std::uint16_t zero[] = { 0, 0 };
+    return ftl::mpn::add_n(r, a, b, 2) == 1 && r[0] == 0 && r[1] == 0
+        && ftl::mpn::sub_n(r, zero, b, 2) == 1 && r[0] == 0xFFFF && r[1] == 0xFFFF;
+}());
+
+/*
+ * mul_1, addmul_1 & submul_1
+ */
+static_assert([] {
+    std::uint8_t r[2] = {};
+    const std::uint8_t a[] = { 0xFF, 0xFF };
+    const std::uint8_t high = ftl::mpn::mul_1(r, a, 2, std::uint8_t{ 0xFF });
+    // 0xFFFF * 0xFF = 0xFEFF01
+    return high == 0xFE && r[0] == 0x01 && r[1] == 0xFF;
+}());
+static_assert([] {
+    std::uint32_t r[] = { 5, 0 };
+    const std::uint32_t a[] = { 0xFFFFFFFF, 0 };
+    const std::uint32_t carry = ftl::mpn::addmul_1(r, a, 2, 2u);
+    const std::uint32_t borrow = ftl::mpn::submul_1(r, a, 2, 2u);
+    return carry == 0 && borrow == 0 && r[0] == 5 && r[1] == 0
+        && ftl::mpn::submul_1(r, a, 2, 1u) == 1;
+}());
+
+/*
+ * mul
+ */
+static_assert([] {
+    const std::uint8_t a[] = { 123, 238 };
+    const std::uint8_t b[] = { 141, 25, 1 };
+    std::uint8_t r[5] = {};
+    ftl::mpn::mul(r, a, 2, b, 3);
+    return r[0] == 191 && r[1] == 92 && r[2] == 72 && r[3] == 6 && r[4] == 1;
+}());
+
+/*
+ * lshift & rshift
+ */
+static_assert([] {
+    std::uint8_t a[] = { 0x81, 0x42 };
+    const std::uint8_t out = ftl::mpn::lshift(a, a, 2, 1);
+    return out == 0 && a[0] == 0x02 && a[1] == 0x85
+        && ftl::mpn::rshift(a, a, 2, 4) == 0x20 && a[0] == 0x50 && a[1] == 0x08;
+}());
+static_assert([] {
+    std::uint8_t a[] = { 0x81, 0x42, 0, 0 };
+    a[3] = ftl::mpn::lshift(a + 1, a, 2, 4);
+    const bool up = a[1] == 0x10 && a[2] == 0x28 && a[3] == 0x04;
+    ftl::mpn::rshift(a, a + 1, 3, 4);
+    return up && a[0] == 0x81 && a[1] == 0x42 && a[2] == 0;
+}());
+
+/*
+ * cmp & divrem_1
+ */
+static_assert([] {
+    const std::uint8_t a[] = { 0x39, 0x30 };
+    const std::uint8_t b[] = { 0x40, 0x2F };
+    std::uint8_t q[2] = {};
+    return ftl::mpn::cmp(a, b, 2) == 1 && ftl::mpn::cmp(b, a, 2) == -1 && ftl::mpn::cmp(a, a, 2) == 0
+        && ftl::mpn::divrem_1(q, a, 2, std::uint8_t{ 100 }) == 45 && q[0] == 123 && q[1] == 0;
+}());
+
+/*
+ * divrem
+ */
+static_assert([] {
+    // 0x0123456789ABCDEF / 0x89AB = 0x021DA1D7B29F, remainder 0x66BA
+    const std::uint16_t a[] = { 0xCDEF, 0x89AB, 0x4567, 0x0123 };
+    const std::uint16_t d[] = { 0x89AB, 0 };
+    const std::uint16_t d2[] = { 0x0001, 0x8000 };
+    std::uint16_t q[4] = {};
+    std::uint16_t r[2] = {};
+    std::uint16_t scratch[7] = {};
+    ftl::mpn::divrem(q, r, a, 4, d, 1, scratch);
+    const bool single = r[0] == 0x66BA && q[0] == 0xB29F && q[1] == 0xA1D7 && q[2] == 0x021D && q[3] == 0;
+    ftl::mpn::divrem(q, r, a, 4, d2, 2, scratch);
+    // 0x0123456789ABCDEF / 0x80000001 = 0x02468ACF, remainder 0x07654320
+    return single && q[0] == 0x8ACF && q[1] == 0x0246 && q[2] == 0 && r[0] == 0x4320 && r[1] == 0x0765;
+}());
+
+#endif//FTL_MPN_HH
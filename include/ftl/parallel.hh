@@ -0,0 +1,90 @@
+#ifndef FTL_PARALLEL_HH
+#define FTL_PARALLEL_HH
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <thread>
+#include <vector>
+
+namespace ftl {
+
+/*
+ * parallel_invoke (f(worker) for every worker below 'threads')
+ *
+ * Worker 0 runs on the calling thread and every other worker on a thread
+ * of its own; all of them have finished when this returns. The threads
+ * are started and joined by every call, there is no pool, so the work per
+ * call has to outweigh a thread start.
+ */
+template<typename F>
+void parallel_invoke(std::size_t threads, F&& f) {
+    std::vector<std::thread> workers;
+    workers.reserve(threads > 1 ? threads - 1 : 0);
+    for (std::size_t worker = 1; worker < threads; ++worker) {
+        workers.emplace_back([&f, worker] { f(worker); });
+    }
+    if (threads > 0) {
+        f(std::size_t{ 0 });
+    }
+    for (auto& thread : workers) {
+        thread.join();
+    }
+}
+
+namespace impl {
+
+/*
+ * work_share (Chunks still owned by one worker, on a cache line of its own)
+ */
+struct alignas(64) work_share {
+    std::atomic<std::size_t> next{ 0 };
+    std::size_t end = 0;
+};
+
+} //namespace impl
+
+/*
+ * parallel_for (f(begin, end) over [0, count) in chunks of 'grain' items)
+ *
+ * Work stealing: every worker starts with an equal run of chunks, claimed
+ * one at a time with an atomic increment, and once its own run is empty
+ * it claims the chunks left in the other workers' runs, nearest first.
+ * Each chunk is handed out exactly once, and the counters sit on separate
+ * cache lines. The workers come from 'parallel_invoke', so they are
+ * started for this call only.
+ */
+template<typename F>
+void parallel_for(std::size_t count, std::size_t grain, std::size_t threads, F&& f) {
+    grain = std::max<std::size_t>(grain, 1);
+    const std::size_t chunks = (count + grain - 1) / grain;
+    threads = std::min(threads, chunks);
+    if (threads <= 1) {
+        for (std::size_t begin = 0; begin < count; begin += grain) {
+            f(begin, std::min(count, begin + grain));
+        }
+        return;
+    }
+
+    std::vector<impl::work_share> shares(threads);
+    for (std::size_t worker = 0; worker < threads; ++worker) {
+        shares[worker].next.store(chunks * worker / threads, std::memory_order_relaxed);
+        shares[worker].end = chunks * (worker + 1) / threads;
+    }
+    parallel_invoke(threads, [&](std::size_t worker) {
+        for (std::size_t k = 0; k < threads; ++k) {
+            impl::work_share& share = shares[(worker + k) % threads];
+            for (;;) {
+                const std::size_t chunk = share.next.fetch_add(1, std::memory_order_relaxed);
+                if (chunk >= share.end) {
+                    break;
+                }
+                f(chunk * grain, std::min(count, (chunk + 1) * grain));
+            }
+        }
+    });
+}
+
+}//namespace ftl
+
+#endif//FTL_PARALLEL_HH
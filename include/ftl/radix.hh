@@ -2,6 +2,10 @@
 #define FTL_RADIX_HH
 
 #include <array>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <type_traits>
 
 #include <ftl/comparison.hh>
 #include <ftl/arithmetic.hh>
@@ -11,270 +15,323 @@ namespace ftl {
 namespace impl {
 
 /*
- * required_digits_radix (Generic)
+ * radix_alphabet (Generic)
+ *
+ * Digit characters in ascending order. 'folds_case' accepts the lower case
+ * form of every letter, and 'aliases' lists extra (character, digit
+ * character) pairs accepted when parsing.
  */
-template<
-    std::size_t RADIX,
-    typename T,
-    typename = std::enable_if_t<std::is_integral<T>::value>>
-struct required_digits_radix :
-    identity<std::size_t, 0>
-{};
+template<std::uint8_t RADIX>
+struct radix_alphabet;
 
 /*
- * required_digits_radix (Base 2)
+ * radix_alphabet (Base 2)
  */
-template<typename T>
-struct required_digits_radix<2, T> :
-    identity<std::size_t, std::numeric_limits<T>::digits>
-{};
+template<>
+struct radix_alphabet<2> {
+    static constexpr char digits[] = "01";
+    static constexpr char aliases[] = "";
+    static constexpr bool folds_case = false;
+};
 
 /*
- * required_digits_radix (Base 8)
+ * radix_alphabet (Base 8)
  */
-template<typename T>
-struct required_digits_radix<8, T> :
-    identity<
-        std::size_t,
-        1 + static_cast<std::size_t>(
-            static_cast<double>(std::numeric_limits<T>::digits) *
-            0.33333333333333333333333333333333
-        )
-    >
-{};
+template<>
+struct radix_alphabet<8> {
+    static constexpr char digits[] = "01234567";
+    static constexpr char aliases[] = "";
+    static constexpr bool folds_case = false;
+};
 
 /*
- * required_digits_radix (Base 10)
+ * radix_alphabet (Base 10)
  */
-template<typename T>
-struct required_digits_radix<10, T> :
-    identity<
-        std::size_t,
-        1 + static_cast<std::size_t>(
-            static_cast<double>(std::numeric_limits<T>::digits) *
-            0.30102999566398119521373889472449
-        )
-    >
-{};
+template<>
+struct radix_alphabet<10> {
+    static constexpr char digits[] = "0123456789";
+    static constexpr char aliases[] = "";
+    static constexpr bool folds_case = false;
+};
 
 /*
- * required_digits_radix (Base 2)
+ * radix_alphabet (Base 16)
  */
-template<typename T>
-struct required_digits_radix<16, T> :
-    identity<
-        std::size_t,
-        1 + static_cast<std::size_t>(
-            static_cast<double>(std::numeric_limits<T>::digits) *
-            0.25
-        )
-    >
-{};
+template<>
+struct radix_alphabet<16> {
+    static constexpr char digits[] = "0123456789ABCDEF";
+    static constexpr char aliases[] = "";
+    static constexpr bool folds_case = true;
+};
 
 /*
- * required_digits_radix (Base 2)
+ * radix_alphabet (Base 32, Crockford)
  */
-template<typename T>
-struct required_digits_radix<64, T> :
-    identity<
-        std::size_t,
-        1 + static_cast<std::size_t>(
-            static_cast<double>(std::numeric_limits<T>::digits) *
-            0.16666666666666666666666666666666
-        )
-    >
-{};
+template<>
+struct radix_alphabet<32> {
+    static constexpr char digits[] = "0123456789ABCDEFGHJKMNPQRSTVWXYZ";
+    static constexpr char aliases[] = "O0I1L1";
+    static constexpr bool folds_case = true;
+};
+
+/*
+ * radix_alphabet (Base 36)
+ */
+template<>
+struct radix_alphabet<36> {
+    static constexpr char digits[] = "0123456789ABCDEFGHIJKLMNOPQRSTUVWXYZ";
+    static constexpr char aliases[] = "";
+    static constexpr bool folds_case = true;
+};
+
+/*
+ * radix_alphabet (Base 58, Bitcoin)
+ */
+template<>
+struct radix_alphabet<58> {
+    static constexpr char digits[] = "123456789ABCDEFGHJKLMNPQRSTUVWXYZabcdefghijkmnopqrstuvwxyz";
+    static constexpr char aliases[] = "";
+    static constexpr bool folds_case = false;
+};
+
+/*
+ * radix_alphabet (Base 64)
+ */
+template<>
+struct radix_alphabet<64> {
+    static constexpr char digits[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+    static constexpr char aliases[] = "";
+    static constexpr bool folds_case = false;
+};
+
+/*
+ * invalid_digit (Table entry of characters outside the alphabet)
+ */
+template<typename V = std::uint8_t>
+struct invalid_digit : identity<V, 0xFF> {};
+
+/*
+ * make_digit_table (Character to digit table generated from the alphabet)
+ */
+template<std::uint8_t RADIX>
+constexpr auto make_digit_table() {
+    using alphabet = radix_alphabet<RADIX>;
+    static_assert(sizeof(alphabet::digits) == RADIX + 1, "radix_alphabet size");
 
+    std::array<std::uint8_t, 256> table = {};
+    for (std::size_t c = 0; c < table.size(); ++c) {
+        table[c] = invalid_digit<>::value;
+    }
+    for (std::size_t d = 0; d < RADIX; ++d) {
+        const auto c = static_cast<unsigned char>(alphabet::digits[d]);
+        table[c] = static_cast<std::uint8_t>(d);
+        if (alphabet::folds_case && c >= 'A' && c <= 'Z') {
+            table[c - 'A' + 'a'] = static_cast<std::uint8_t>(d);
+        }
+    }
+    for (std::size_t i = 0; i + 1 < sizeof(alphabet::aliases); i += 2) {
+        const auto c = static_cast<unsigned char>(alphabet::aliases[i]);
+        const auto d = table[static_cast<unsigned char>(alphabet::aliases[i + 1])];
+        table[c] = d;
+        if (alphabet::folds_case && c >= 'A' && c <= 'Z') {
+            table[c - 'A' + 'a'] = d;
+        }
+    }
+    return table;
 }
+
 /*
- * parse_digit (Base 2)
+ * digit_table
+ */
+template<std::uint8_t RADIX>
+struct digit_table {
+    static constexpr std::array<std::uint8_t, 256> value = make_digit_table<RADIX>();
+};
+
+/*
+ * radix_chunk (Largest power of RADIX held by one T)
+ */
+template<std::size_t RADIX, typename T>
+struct radix_chunk {
+    static constexpr std::size_t digits() {
+        std::size_t k = 0;
+        for (T power = 1; power <= std::numeric_limits<T>::max() / RADIX; power *= RADIX) {
+            ++k;
+        }
+        return k;
+    }
+
+    static constexpr T power() {
+        T power = 1;
+        for (std::size_t i = 0; i < digits(); ++i) {
+            power *= RADIX;
+        }
+        return power;
+    }
+
+    static constexpr std::size_t length = digits();
+    static constexpr T value = power();
+};
+
+/*
+ * radix_shift (log2(radix) for power of two radices, otherwise zero)
  */
-template<std::uint8_t RADIX, typename V = std::uint8_t>
-constexpr typename std::enable_if<RADIX == 2, V>::type
-parse_digit(const char c) {
-    constexpr std::array<V, 256> _ = {
-        /* 000-015 */ 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
-        /* 016-031 */ 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
-        /* 032-047 */ 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
-        /* 048-063 */ 0, 1, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
-        /* 064-079 */ 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
-        /* 080-095 */ 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
-        /* 096-111 */ 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
-        /* 112-127 */ 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
-        /* 128-143 */ 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
-        /* 144-159 */ 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
-        /* 160-175 */ 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
-        /* 176-191 */ 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
-        /* 192-207 */ 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
-        /* 208-223 */ 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
-        /* 224-239 */ 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
-        /* 240-255 */ 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0
-    };
-    return _[c];
+constexpr std::size_t radix_shift(std::size_t radix) {
+    std::size_t shift = 0;
+    if ((radix & (radix - 1)) == 0) {
+        for (; radix > 1; radix >>= 1) {
+            ++shift;
+        }
+    }
+    return shift;
 }
 
 /*
- * parse_digit (Base 8)
+ * bit_length (Of a little endian array of 32 bit limbs)
  */
-template<std::uint8_t RADIX, typename V = std::uint8_t>
-constexpr typename std::enable_if<RADIX == 8, V>::type
-parse_digit(const char c) {
-    constexpr std::array<V, 256> _ = {
-        /* 000-015 */ 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
-        /* 016-031 */ 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
-        /* 032-047 */ 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
-        /* 048-063 */ 0, 1, 2, 3, 4, 5, 6, 7, 0, 0, 0, 0, 0, 0, 0, 0,
-        /* 064-079 */ 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
-        /* 080-095 */ 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
-        /* 096-111 */ 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
-        /* 112-127 */ 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
-        /* 128-143 */ 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
-        /* 144-159 */ 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
-        /* 160-175 */ 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
-        /* 176-191 */ 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
-        /* 192-207 */ 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
-        /* 208-223 */ 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
-        /* 224-239 */ 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
-        /* 240-255 */ 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0
-    };
-    return _[c];
+template<std::size_t N>
+constexpr std::size_t bit_length(const std::array<std::uint32_t, N>& limbs) {
+    for (std::size_t i = N; i > 0; --i) {
+        if (limbs[i - 1] != 0) {
+            std::size_t bits = (i - 1) * 32;
+            for (std::uint32_t top = limbs[i - 1]; top != 0; top >>= 1) {
+                ++bits;
+            }
+            return bits;
+        }
+    }
+    return 0;
 }
 
 /*
- * compose_digit (Base 8)
+ * scale_in_place (Of a little endian array of 32 bit limbs)
  */
-template<std::uint8_t RADIX, typename V = std::uint8_t>
-constexpr typename std::enable_if<RADIX == 8, V>::type
-compose_digit(const char d) {
-    constexpr std::array<const char, RADIX> _ = {
-        '0', '1', '2', '3', '4', '5', '6', '7'
-    };
-    return _[d];
+template<std::size_t N>
+constexpr void scale_in_place(std::array<std::uint32_t, N>& limbs, std::uint32_t factor) {
+    std::uint64_t carry = 0;
+    for (std::size_t i = 0; i < N; ++i) {
+        const std::uint64_t product = static_cast<std::uint64_t>(limbs[i]) * factor + carry;
+        limbs[i] = static_cast<std::uint32_t>(product);
+        carry = product >> 32;
+    }
 }
 
 /*
- * parse_digit (Base 10)
+ * radix_power_bits (Exact bit length of RADIX^DIGITS - 1, the largest
+ * DIGITS digit number)
  */
-template<std::uint8_t RADIX = 10, typename V = std::uint8_t>
-constexpr typename std::enable_if<RADIX == 10, V>::type
-parse_digit(const char c) {
-    constexpr std::array<V, 256> _ = {
-        /* 000-015 */ 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
-        /* 016-031 */ 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
-        /* 032-047 */ 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
-        /* 048-063 */ 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 0, 0, 0, 0, 0, 0,
-        /* 064-079 */ 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
-        /* 080-095 */ 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
-        /* 096-111 */ 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
-        /* 112-127 */ 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
-        /* 128-143 */ 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
-        /* 144-159 */ 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
-        /* 160-175 */ 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
-        /* 176-191 */ 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
-        /* 192-207 */ 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
-        /* 208-223 */ 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
-        /* 224-239 */ 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
-        /* 240-255 */ 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0
-    };
-    return _[c];
+template<std::size_t RADIX, std::size_t DIGITS>
+constexpr std::size_t radix_power_bits() {
+    static_assert(RADIX >= 2 && RADIX <= 64, "radix_power_bits radix");
+    if (radix_shift(RADIX) != 0) {
+        return DIGITS * radix_shift(RADIX);
+    }
+
+    using chunk = radix_chunk<RADIX, std::uint32_t>;
+    std::array<std::uint32_t, (DIGITS * 6) / 32 + 2> power = { 1 };
+    for (std::size_t i = 0; i < DIGITS; i += chunk::length) {
+        std::uint32_t factor = 1;
+        for (std::size_t j = i; j < DIGITS && j < i + chunk::length; ++j) {
+            factor *= RADIX;
+        }
+        scale_in_place(power, factor);
+    }
+    for (std::size_t i = 0; i < power.size(); ++i) {
+        if (power[i]-- != 0) {
+            break;
+        }
+    }
+    return bit_length(power);
 }
 
 /*
- * compose_digit (Base 10)
+ * radix_log2 (Lower bound on log2(radix), in units of 2^-31)
+ *
+ * Each fraction bit comes from squaring the mantissa; truncating the
+ * square only ever makes the result smaller.
  */
-template<std::uint8_t RADIX = 10, typename V = std::uint8_t>
-constexpr typename std::enable_if<RADIX == 10, V>::type
-compose_digit(const char d) {
-    constexpr std::array<V, RADIX> _ = {
-        '0', '1', '2', '3', '4', '5', '6', '7', '8', '9'
-    };
-    return _[d];
+constexpr std::uint64_t radix_log2(std::size_t radix) {
+    constexpr unsigned fraction = 31;
+    unsigned exponent = 0;
+    while ((radix >> (exponent + 1)) != 0) {
+        ++exponent;
+    }
+    std::uint64_t mantissa = (static_cast<std::uint64_t>(radix) << fraction) >> exponent;
+    std::uint64_t result = exponent;
+    for (unsigned i = 0; i < fraction; ++i) {
+        mantissa = (mantissa * mantissa) >> fraction;
+        result <<= 1;
+        if (mantissa >= (std::uint64_t{ 2 } << fraction)) {
+            mantissa >>= 1;
+            result |= 1;
+        }
+    }
+    return result;
 }
 
 /*
- * parse_digit (Base 16)
+ * radix_bits_digits (Digit count of 2^BITS - 1, the largest BITS bit
+ * number; never below the exact count)
+ *
+ * floor(BITS / log2(RADIX)) + 1 with log2(RADIX) rounded down, so the
+ * count is at most one digit over, and only when BITS / log2(RADIX) is
+ * within about 2^-29 of an integer. Constant work for any BITS.
  */
-template<std::uint8_t RADIX, typename V = std::uint8_t>
-constexpr typename std::enable_if<RADIX == 16, V>::type
-parse_digit(const char c) {
-    constexpr std::array<V, 256> _ = {
-        /* 000-015 */ 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
-        /* 016-031 */ 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
-        /* 032-047 */ 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
-        /* 048-063 */ 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 0, 0, 0, 0, 0, 0,
-        /* 064-079 */ 0, 10, 11, 12, 13, 14, 15, 0, 0, 0, 0, 0, 0, 0, 0, 0,
-        /* 080-095 */ 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
-        /* 096-111 */ 0, 10, 11, 12, 13, 14, 15, 0, 0, 0, 0, 0, 0, 0, 0, 0,
-        /* 112-127 */ 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
-        /* 128-143 */ 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
-        /* 144-159 */ 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
-        /* 160-175 */ 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
-        /* 176-191 */ 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
-        /* 192-207 */ 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
-        /* 208-223 */ 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
-        /* 224-239 */ 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
-        /* 240-255 */ 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0
-    };
-    return _[c];
+template<std::size_t RADIX, std::size_t BITS>
+constexpr std::size_t radix_bits_digits() {
+    static_assert(RADIX >= 2 && RADIX <= 64, "radix_bits_digits radix");
+    if (radix_shift(RADIX) != 0) {
+        return (BITS + radix_shift(RADIX) - 1) / radix_shift(RADIX);
+    }
+    return static_cast<std::size_t>((static_cast<std::uint64_t>(BITS) << 31) / radix_log2(RADIX)) + 1;
 }
 
 /*
- * compose_digit (Base 16)
+ * required_digits_bits
+ *
+ * Digits needed to write any unsigned value of BITS bits.
+ */
+template<std::size_t RADIX, std::size_t BITS>
+struct required_digits_bits :
+    identity<std::size_t, radix_bits_digits<RADIX, BITS>()>
+{};
+
+/*
+ * required_digits_radix
+ */
+template<
+    std::size_t RADIX,
+    typename T,
+    typename = std::enable_if_t<std::is_integral<T>::value>>
+struct required_digits_radix :
+    required_digits_bits<RADIX, std::numeric_limits<T>::digits>
+{};
+
+} //namespace impl
+
+/*
+ * is_digit
  */
-template<std::uint8_t RADIX, typename V = std::uint8_t>
-constexpr typename std::enable_if<RADIX == 16, V>::type
-compose_digit(V d) {
-    constexpr std::array<const char, RADIX> _ = {
-        '0', '1', '2', '3', '4', '5', '6', '7',
-        '8', '9', 'A', 'B', 'C', 'D', 'E', 'F'
-    };
-    return _[d];
+template<std::uint8_t RADIX = 10>
+constexpr bool is_digit(const char c) {
+    return impl::digit_table<RADIX>::value[static_cast<unsigned char>(c)] != impl::invalid_digit<>::value;
 }
 
 /*
- * parse_digit (Base 64)
+ * parse_digit (Characters outside the alphabet parse as zero)
  */
-template<std::uint8_t RADIX, typename V = std::uint8_t>
-constexpr typename std::enable_if<RADIX == 64, V>::type
-parse_digit(const char c) {
-    constexpr std::array<V, 256> _ = {
-        /* 000-015 */ 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
-        /* 016-031 */ 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
-        /* 032-047 */ 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 62, 0, 0, 0, 63,
-        /* 048-063 */ 52, 53, 54, 55, 56, 57, 58, 59, 60, 61, 0, 0, 0, 0, 0, 0,
-        /* 064-079 */ 0, 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14,
-        /* 080-095 */ 15, 16, 17, 18, 19, 20, 21, 22, 23, 24, 25, 26, 0, 0, 0, 0,
-        /* 096-111 */ 0, 26, 27, 28, 29, 30, 31, 32, 33, 34, 35, 36, 37, 38, 39, 40,
-        /* 112-127 */ 41, 42, 43, 44, 45, 46, 47, 48, 49, 50, 51, 0, 0, 0, 0, 0,
-        /* 128-143 */ 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
-        /* 144-159 */ 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
-        /* 160-175 */ 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
-        /* 176-191 */ 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
-        /* 192-207 */ 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
-        /* 208-223 */ 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
-        /* 224-239 */ 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
-        /* 240-255 */ 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0
-    };
-    return _[c];
+template<std::uint8_t RADIX = 10, typename V = std::uint8_t>
+constexpr V parse_digit(const char c) {
+    const std::uint8_t d = impl::digit_table<RADIX>::value[static_cast<unsigned char>(c)];
+    return static_cast<V>(d == impl::invalid_digit<>::value ? 0 : d);
 }
 
 /*
- * compose_digit (Base 64)
+ * compose_digit
  */
-template<std::uint8_t RADIX, typename V = std::uint8_t>
-constexpr typename std::enable_if<RADIX == 64, V>::type
-compose_digit(V d) {
-    constexpr std::array<V, RADIX> _ = {
-        'A', 'B', 'C', 'D', 'E', 'F', 'G', 'H',
-        'I', 'J', 'K', 'L', 'M', 'N', 'O', 'P',
-        'Q', 'R', 'S', 'T', 'U', 'V', 'W', 'X',
-        'Y', 'Z', 'a', 'b', 'c', 'd', 'e', 'f',
-        'g', 'h', 'i', 'j', 'k', 'l', 'm', 'n',
-        'o', 'p', 'q', 'r', 's', 't', 'u', 'v',
-        'w', 'x', 'y', 'z', '0', '1', '2', '3',
-        '4', '5', '6', '7', '8', '9', '+', '/'
-    };
-    return _[d];
+template<std::uint8_t RADIX = 10, typename V = std::uint8_t>
+constexpr char compose_digit(V d) {
+    return impl::radix_alphabet<RADIX>::digits[d];
 }
 
 /*
@@ -613,6 +670,97 @@ static_assert(ftl::compose_digit<64>(61) == '9', "compose_digit<64>(61)");
 static_assert(ftl::compose_digit<64>(62) == '+', "compose_digit<64>(62)");
 static_assert(ftl::compose_digit<64>(63) == '/', "compose_digit<64>(63)");
 
+/*
+ * is_digit
+ */
+static_assert(ftl::is_digit('0'), "is_digit('0')");
+static_assert(!ftl::is_digit('a'), "is_digit('a')");
+static_assert(ftl::is_digit<16>('f'), "is_digit<16>('f')");
+static_assert(!ftl::is_digit<16>('g'), "is_digit<16>('g')");
+static_assert(!ftl::is_digit<64>('='), "is_digit<64>('=')");
+static_assert(!ftl::is_digit<58>('0'), "is_digit<58>('0')");
+static_assert(!ftl::is_digit<58>('l'), "is_digit<58>('l')");
+static_assert(!ftl::is_digit<32>('U'), "is_digit<32>('U')");
+static_assert(!ftl::is_digit<10>('\xB0'), "is_digit<10>('\\xB0')");
+
+/*
+ * parse_digit (Base 32)
+ */
+static_assert(ftl::parse_digit<32>('0') == 0, "parse_digit<32>('0')");
+static_assert(ftl::parse_digit<32>('O') == 0, "parse_digit<32>('O')");
+static_assert(ftl::parse_digit<32>('o') == 0, "parse_digit<32>('o')");
+static_assert(ftl::parse_digit<32>('I') == 1, "parse_digit<32>('I')");
+static_assert(ftl::parse_digit<32>('l') == 1, "parse_digit<32>('l')");
+static_assert(ftl::parse_digit<32>('A') == 10, "parse_digit<32>('A')");
+static_assert(ftl::parse_digit<32>('j') == 18, "parse_digit<32>('j')");
+static_assert(ftl::parse_digit<32>('Z') == 31, "parse_digit<32>('Z')");
+
+/*
+ * compose_digit (Base 32)
+ */
+static_assert(ftl::compose_digit<32>(0) == '0', "compose_digit<32>(0)");
+static_assert(ftl::compose_digit<32>(18) == 'J', "compose_digit<32>(18)");
+static_assert(ftl::compose_digit<32>(31) == 'Z', "compose_digit<32>(31)");
+
+/*
+ * parse_digit (Base 36)
+ */
+static_assert(ftl::parse_digit<36>('9') == 9, "parse_digit<36>('9')");
+static_assert(ftl::parse_digit<36>('a') == 10, "parse_digit<36>('a')");
+static_assert(ftl::parse_digit<36>('Z') == 35, "parse_digit<36>('Z')");
+
+/*
+ * compose_digit (Base 36)
+ */
+static_assert(ftl::compose_digit<36>(10) == 'A', "compose_digit<36>(10)");
+static_assert(ftl::compose_digit<36>(35) == 'Z', "compose_digit<36>(35)");
+
+/*
+ * parse_digit (Base 58)
+ */
+static_assert(ftl::parse_digit<58>('1') == 0, "parse_digit<58>('1')");
+static_assert(ftl::parse_digit<58>('9') == 8, "parse_digit<58>('9')");
+static_assert(ftl::parse_digit<58>('A') == 9, "parse_digit<58>('A')");
+static_assert(ftl::parse_digit<58>('J') == 17, "parse_digit<58>('J')");
+static_assert(ftl::parse_digit<58>('a') == 33, "parse_digit<58>('a')");
+static_assert(ftl::parse_digit<58>('z') == 57, "parse_digit<58>('z')");
+
+/*
+ * compose_digit (Base 58)
+ */
+static_assert(ftl::compose_digit<58>(0) == '1', "compose_digit<58>(0)");
+static_assert(ftl::compose_digit<58>(17) == 'J', "compose_digit<58>(17)");
+static_assert(ftl::compose_digit<58>(57) == 'z', "compose_digit<58>(57)");
+
+/*
+ * radix_chunk
+ */
+static_assert(ftl::impl::radix_chunk<10, std::uint32_t>::length == 9);
+static_assert(ftl::impl::radix_chunk<10, std::uint32_t>::value == 1000000000);
+static_assert(ftl::impl::radix_chunk<58, std::uint32_t>::length == 5);
+static_assert(ftl::impl::radix_chunk<58, std::uint32_t>::value == 656356768);
+static_assert(ftl::impl::radix_chunk<16, std::uint8_t>::length == 1);
+static_assert(ftl::impl::radix_chunk<10, std::uint8_t>::value == 100);
+
+/*
+ * required_digits_radix (Upper bound)
+ */
+static_assert(ftl::impl::required_digits_radix<2, std::uint32_t>::value == 32);
+static_assert(ftl::impl::required_digits_radix<8, std::uint32_t>::value == 11);
+static_assert(ftl::impl::required_digits_radix<10, std::uint8_t>::value == 3);
+static_assert(ftl::impl::required_digits_radix<10, std::uint32_t>::value == 10);
+static_assert(ftl::impl::required_digits_radix<10, std::uint64_t>::value == 20);
+static_assert(ftl::impl::required_digits_radix<16, std::uint32_t>::value == 8);
+static_assert(ftl::impl::required_digits_radix<32, std::uint64_t>::value == 13);
+static_assert(ftl::impl::required_digits_radix<36, std::uint64_t>::value == 13);
+static_assert(ftl::impl::required_digits_radix<58, std::uint64_t>::value == 11);
+static_assert(ftl::impl::required_digits_radix<64, std::uint64_t>::value == 11);
+static_assert(ftl::impl::required_digits_bits<10, 128>::value == 39);
+static_assert(ftl::impl::required_digits_bits<10, 256>::value == 78);
+static_assert(ftl::impl::required_digits_bits<58, 256>::value == 44);
+static_assert(ftl::impl::required_digits_bits<10, 65536>::value == 19729);
+static_assert(ftl::impl::required_digits_bits<10, 1000000>::value == 301030);
+
 /*
  * parse_digits
  */
@@ -648,6 +796,9 @@ static_assert(ftl::from_digits(ftl::parse_digits("1234567890")) == 1234567890);
 static_assert(ftl::from_digits<8>(ftl::parse_digits<8>("147625")) == 0147625);
 static_assert(ftl::from_digits<16>(ftl::parse_digits<16>("FFED56")) == 0xFFED56);
 static_assert(ftl::from_digits<64>(ftl::parse_digits<64>("y5I")) == 208456);
+static_assert(ftl::from_digits<32>(ftl::parse_digits<32>("1ZoO")) == 65536 - 1024);
+static_assert(ftl::from_digits<36>(ftl::parse_digits<36>("zz")) == 1295);
+static_assert(ftl::from_digits<58>(ftl::parse_digits<58>("211")) == 3364);
 
 /*
  * to_digits
@@ -0,0 +1,394 @@
+#ifndef FTL_RADIX_STREAM_HH
+#define FTL_RADIX_STREAM_HH
+
+#include <ftl/identity.hh>
+#include <ftl/radix.hh>
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+namespace ftl {
+namespace impl {
+
+/*
+ * radix_quantum (Generic)
+ *
+ * Bits carried by one digit, and whether a partial quantum is completed
+ * with padding characters.
+ */
+template<std::uint8_t RADIX>
+struct radix_quantum;
+
+/*
+ * radix_quantum (Base 16)
+ */
+template<>
+struct radix_quantum<16> {
+    static constexpr std::size_t bits = 4;
+    static constexpr bool padded = false;
+};
+
+/*
+ * radix_quantum (Base 32, Crockford)
+ */
+template<>
+struct radix_quantum<32> {
+    static constexpr std::size_t bits = 5;
+    static constexpr bool padded = false;
+};
+
+/*
+ * radix_quantum (Base 64)
+ */
+template<>
+struct radix_quantum<64> {
+    static constexpr std::size_t bits = 6;
+    static constexpr bool padded = true;
+};
+
+/*
+ * quantum_bits (lcm(8, bits): smallest run of whole bytes and whole digits)
+ */
+template<std::size_t BITS>
+struct quantum_bits :
+    identity<std::size_t, BITS % 8 == 0 ? BITS : (BITS % 4 == 0 ? 8 : (BITS % 2 == 0 ? 4 * BITS : 8 * BITS))>
+{};
+
+/*
+ * padding_digit
+ */
+template<typename V = char>
+struct padding_digit : identity<V, '='> {};
+
+} //namespace impl
+
+/*
+ * radix_encoder
+ *
+ * Incremental bytes to text encoder. The partial quantum is carried between
+ * calls to 'update', so input may be split at any byte. Output is written to
+ * caller-provided storage sized with 'max_output'; memory use is constant.
+ */
+template<std::uint8_t RADIX>
+struct radix_encoder {
+    static constexpr std::size_t digit_bits = impl::radix_quantum<RADIX>::bits;
+    static constexpr std::size_t quantum_bytes = impl::quantum_bits<digit_bits>::value / 8;
+    static constexpr std::size_t quantum_digits = impl::quantum_bits<digit_bits>::value / digit_bits;
+
+    /*
+     * max_output (Upper bound on characters written by 'update' or 'finish')
+     */
+    static constexpr std::size_t max_output(std::size_t bytes) {
+        return ((bytes + quantum_bytes) / quantum_bytes) * quantum_digits;
+    }
+
+    /*
+     * update
+     */
+    constexpr std::size_t update(const std::uint8_t* first, const std::uint8_t* last, char* out) {
+        char* const begin = out;
+
+        // Top up the carried partial quantum
+        while (first != last && consumed != 0) {
+            out = push(*first++, out);
+        }
+
+        // Whole quanta
+        while (static_cast<std::size_t>(last - first) >= quantum_bytes) {
+            std::uint64_t q = 0;
+            for (std::size_t i = 0; i < quantum_bytes; ++i) {
+                q = (q << 8) | first[i];
+            }
+            for (std::size_t i = quantum_digits; i > 0; --i) {
+                out[i - 1] = static_cast<char>(compose_digit<RADIX>(static_cast<std::uint8_t>(q & mask)));
+                q >>= digit_bits;
+            }
+            first += quantum_bytes;
+            out += quantum_digits;
+        }
+
+        // Carry the remainder
+        while (first != last) {
+            out = push(*first++, out);
+        }
+        return static_cast<std::size_t>(out - begin);
+    }
+
+    /*
+     * finish (Flush the partial quantum, padding if the radix requires it)
+     */
+    constexpr std::size_t finish(char* out) {
+        char* const begin = out;
+        if (consumed != 0) {
+            if (carry_bits != 0) {
+                *out++ = static_cast<char>(compose_digit<RADIX>(static_cast<std::uint8_t>((carry << (digit_bits - carry_bits)) & mask)));
+            }
+            if (impl::radix_quantum<RADIX>::padded) {
+                const std::size_t written = (consumed * 8 + digit_bits - 1) / digit_bits;
+                for (std::size_t i = written; i < quantum_digits; ++i) {
+                    *out++ = impl::padding_digit<>::value;
+                }
+            }
+        }
+        carry = 0;
+        carry_bits = 0;
+        consumed = 0;
+        return static_cast<std::size_t>(out - begin);
+    }
+
+    std::uint32_t carry = 0;
+    std::size_t carry_bits = 0;
+    std::size_t consumed = 0;
+
+private:
+    static constexpr std::uint32_t mask = (std::uint32_t{1} << digit_bits) - 1;
+
+    constexpr char* push(std::uint8_t byte, char* out) {
+        carry = (carry << 8) | byte;
+        carry_bits += 8;
+        while (carry_bits >= digit_bits) {
+            carry_bits -= digit_bits;
+            *out++ = static_cast<char>(compose_digit<RADIX>(static_cast<std::uint8_t>((carry >> carry_bits) & mask)));
+        }
+        carry &= (std::uint32_t{1} << carry_bits) - 1;
+        consumed = (consumed + 1) % quantum_bytes;
+        return out;
+    }
+};
+
+/*
+ * radix_decoder
+ *
+ * Incremental text to bytes decoder, the inverse of 'radix_encoder'. Decoding
+ * stops at the first character that is not a digit or padding; 'good' then
+ * reports false. Padding is optional, but once present it must end the input.
+ */
+template<std::uint8_t RADIX>
+struct radix_decoder {
+    static constexpr std::size_t digit_bits = impl::radix_quantum<RADIX>::bits;
+    static constexpr std::size_t quantum_bytes = impl::quantum_bits<digit_bits>::value / 8;
+    static constexpr std::size_t quantum_digits = impl::quantum_bits<digit_bits>::value / digit_bits;
+
+    /*
+     * max_output (Upper bound on bytes written by 'update')
+     */
+    static constexpr std::size_t max_output(std::size_t digits) {
+        return ((digits + quantum_digits) / quantum_digits) * quantum_bytes;
+    }
+
+    /*
+     * update
+     */
+    constexpr std::size_t update(const char* first, const char* last, std::uint8_t* out) {
+        std::uint8_t* const begin = out;
+
+        // Top up the carried partial quantum
+        while (first != last && !failed && (digits != 0 || padding != 0)) {
+            out = push(*first++, out);
+        }
+
+        // Whole quanta
+        while (!failed && padding == 0 && static_cast<std::size_t>(last - first) >= quantum_digits) {
+            std::uint64_t q = 0;
+            std::size_t i = 0;
+            for (; i < quantum_digits && is_digit<RADIX>(first[i]); ++i) {
+                q = (q << digit_bits) | parse_digit<RADIX>(first[i]);
+            }
+            if (i != quantum_digits) {
+                break;
+            }
+            for (std::size_t j = quantum_bytes; j > 0; --j) {
+                out[j - 1] = static_cast<std::uint8_t>(q & 0xFF);
+                q >>= 8;
+            }
+            first += quantum_digits;
+            out += quantum_bytes;
+        }
+
+        // Partial quanta, padding and errors
+        while (first != last && !failed) {
+            out = push(*first++, out);
+        }
+        return static_cast<std::size_t>(out - begin);
+    }
+
+    /*
+     * finish (Validate the trailing partial quantum and reset)
+     */
+    constexpr bool finish() {
+        const bool result = good()
+            && (padding == 0 || (digits != 0 && digits + padding == quantum_digits));
+        carry = 0;
+        carry_bits = 0;
+        digits = 0;
+        padding = 0;
+        failed = false;
+        return result;
+    }
+
+    /*
+     * good (No invalid character seen, and no digit left without a byte)
+     */
+    constexpr bool good() const {
+        return !failed && carry_bits < digit_bits;
+    }
+
+    std::uint32_t carry = 0;
+    std::size_t carry_bits = 0;
+    std::size_t digits = 0;
+    std::size_t padding = 0;
+    bool failed = false;
+
+private:
+    constexpr std::uint8_t* push(const char c, std::uint8_t* out) {
+        if (c == impl::padding_digit<>::value && impl::radix_quantum<RADIX>::padded) {
+            ++padding;
+        } else if (padding != 0 || !is_digit<RADIX>(c)) {
+            failed = true;
+        } else {
+            carry = (carry << digit_bits) | parse_digit<RADIX>(c);
+            carry_bits += digit_bits;
+            if (carry_bits >= 8) {
+                carry_bits -= 8;
+                *out++ = static_cast<std::uint8_t>(carry >> carry_bits);
+                carry &= (std::uint32_t{1} << carry_bits) - 1;
+            }
+            digits = (digits + 1) % quantum_digits;
+        }
+        return out;
+    }
+};
+
+}//namespace ftl
+
+/*
+ * quantum_bits
+ */
+static_assert(ftl::impl::quantum_bits<4>::value == 8);
+static_assert(ftl::impl::quantum_bits<6>::value == 24);
+
+/*
+ * radix_encoder (Base 16)
+ */
+static_assert(ftl::radix_encoder<16>::max_output(3) == 8);
+static_assert([] {
+    const std::uint8_t bytes[] = { 0xDE, 0xAD, 0xBE, 0xEF };
+    std::array<char, 8> text = {};
+    ftl::radix_encoder<16> encoder;
+    std::size_t n = encoder.update(bytes, bytes + 1, text.data());
+    n += encoder.update(bytes + 1, bytes + 4, text.data() + n);
+    n += encoder.finish(text.data() + n);
+    const char expected[] = "DEADBEEF";
+    for (std::size_t i = 0; i < text.size(); ++i) {
+        if (text[i] != expected[i]) {
+            return false;
+        }
+    }
+    return n == 8;
+}());
+
+/*
+ * radix_encoder (Base 64)
+ */
+static_assert(ftl::radix_encoder<64>::max_output(2) == 4);
+static_assert([] {
+    const std::uint8_t bytes[] = { 'M', 'a', 'n', 'M', 'a' };
+    std::array<char, 8> text = {};
+    ftl::radix_encoder<64> encoder;
+    std::size_t n = encoder.update(bytes, bytes + 2, text.data());
+    n += encoder.update(bytes + 2, bytes + 5, text.data() + n);
+    n += encoder.finish(text.data() + n);
+    const char expected[] = "TWFuTWE=";
+    for (std::size_t i = 0; i < text.size(); ++i) {
+        if (text[i] != expected[i]) {
+            return false;
+        }
+    }
+    return n == 8;
+}());
+static_assert([] {
+    const std::uint8_t bytes[] = { 'M' };
+    std::array<char, 4> text = {};
+    ftl::radix_encoder<64> encoder;
+    std::size_t n = encoder.update(bytes, bytes + 1, text.data());
+    n += encoder.finish(text.data() + n);
+    return n == 4 && text[0] == 'T' && text[1] == 'Q' && text[2] == '=' && text[3] == '=';
+}());
+
+/*
+ * radix_decoder (Base 16)
+ */
+static_assert([] {
+    const char text[] = "deADbeEF";
+    std::array<std::uint8_t, 4> bytes = {};
+    ftl::radix_decoder<16> decoder;
+    std::size_t n = decoder.update(text, text + 3, bytes.data());
+    n += decoder.update(text + 3, text + 8, bytes.data() + n);
+    return n == 4 && decoder.finish()
+        && bytes[0] == 0xDE && bytes[1] == 0xAD && bytes[2] == 0xBE && bytes[3] == 0xEF;
+}());
+static_assert([] {
+    const char text[] = "ABC";
+    std::array<std::uint8_t, 2> bytes = {};
+    ftl::radix_decoder<16> decoder;
+    decoder.update(text, text + 3, bytes.data());
+    return !decoder.finish();
+}());
+static_assert([] {
+    const char text[] = "A\xC3";
+    std::array<std::uint8_t, 2> bytes = {};
+    ftl::radix_decoder<16> decoder;
+    decoder.update(text, text + 2, bytes.data());
+    return !decoder.good();
+}());
+
+/*
+ * radix_decoder (Base 64)
+ */
+static_assert([] {
+    const char text[] = "TWFuTWE=";
+    std::array<std::uint8_t, 6> bytes = {};
+    ftl::radix_decoder<64> decoder;
+    std::size_t n = decoder.update(text, text + 5, bytes.data());
+    n += decoder.update(text + 5, text + 8, bytes.data() + n);
+    return n == 5 && decoder.finish()
+        && bytes[0] == 'M' && bytes[1] == 'a' && bytes[2] == 'n' && bytes[3] == 'M' && bytes[4] == 'a';
+}());
+static_assert([] {
+    const char text[] = "TWE";
+    std::array<std::uint8_t, 3> bytes = {};
+    ftl::radix_decoder<64> decoder;
+    std::size_t n = decoder.update(text, text + 3, bytes.data());
+    return n == 2 && decoder.finish();
+}());
+static_assert([] {
+    const char text[] = "TW=E";
+    std::array<std::uint8_t, 3> bytes = {};
+    ftl::radix_decoder<64> decoder;
+    decoder.update(text, text + 4, bytes.data());
+    return !decoder.finish();
+}());
+static_assert([] {
+    const char text[] = "T===";
+    std::array<std::uint8_t, 3> bytes = {};
+    ftl::radix_decoder<64> decoder;
+    decoder.update(text, text + 4, bytes.data());
+    return !decoder.finish();
+}());
+static_assert([] {
+    const char text[] = "====";
+    std::array<std::uint8_t, 3> bytes = {};
+    ftl::radix_decoder<64> decoder;
+    decoder.update(text, text + 4, bytes.data());
+    return !decoder.finish();
+}());
+static_assert([] {
+    const char text[] = "TWFu====";
+    std::array<std::uint8_t, 6> bytes = {};
+    ftl::radix_decoder<64> decoder;
+    decoder.update(text, text + 8, bytes.data());
+    return !decoder.finish();
+}());
+
+#endif//FTL_RADIX_STREAM_HH
@@ -0,0 +1,247 @@
+#ifndef FTL_SCRATCH_HH
+#define FTL_SCRATCH_HH
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <memory_resource>
+#include <type_traits>
+#include <vector>
+
+namespace ftl {
+
+/*
+ * scratch_arena (Bump allocator for temporaries released in LIFO order)
+ *
+ * Memory comes from an upstream 'std::pmr::memory_resource', so any
+ * allocator plugs in, in blocks that double in size. Released blocks are
+ * kept, and a thread that repeats the same work stops calling the
+ * upstream after the first round. An allocation is a pointer bump;
+ * 'release' rolls back to a 'mark' and frees everything allocated after
+ * it. The arena is not synchronized: one per thread.
+ */
+class scratch_arena {
+public:
+    /*
+     * block_alignment (Every block starts on a cache line)
+     */
+    static constexpr std::size_t block_alignment = 64;
+
+    /*
+     * marker (Position to roll back to)
+     */
+    struct marker {
+        std::size_t block = 0;
+        std::size_t offset = 0;
+        std::size_t in_use = 0;
+    };
+
+    explicit scratch_arena(std::pmr::memory_resource* upstream = std::pmr::get_default_resource(), std::size_t initial = 64 * 1024) :
+        upstream_(upstream),
+        initial_(initial)
+    {}
+
+    scratch_arena(const scratch_arena&) = delete;
+    scratch_arena& operator=(const scratch_arena&) = delete;
+
+    ~scratch_arena() {
+        for (const block& b : blocks_) {
+            upstream_->deallocate(b.data, b.size, block_alignment);
+        }
+    }
+
+    marker mark() const {
+        return { current_, offset_, in_use_ };
+    }
+
+    void release(marker m) {
+        current_ = m.block;
+        offset_ = m.offset;
+        in_use_ = m.in_use;
+    }
+
+    /*
+     * allocate ('alignment' is a power of two, at most 'block_alignment')
+     */
+    void* allocate(std::size_t bytes, std::size_t alignment = alignof(std::max_align_t)) {
+        if (blocks_.empty()) {
+            grow(0, bytes);
+            return take(0, bytes);
+        }
+        const std::size_t start = align(offset_, alignment);
+        if (start + bytes <= blocks_[current_].size) {
+            return take(start, bytes);
+        }
+        // Later blocks are free in LIFO order: reuse the next one if it
+        // fits, otherwise give it back to the upstream for a larger one
+        const std::size_t next = current_ + 1;
+        if (next < blocks_.size() && blocks_[next].size < bytes) {
+            for (std::size_t k = next; k < blocks_.size(); ++k) {
+                upstream_->deallocate(blocks_[k].data, blocks_[k].size, block_alignment);
+                reserved_ -= blocks_[k].size;
+            }
+            blocks_.resize(next);
+        }
+        if (next == blocks_.size()) {
+            grow(blocks_.back().size, bytes);
+        }
+        in_use_ += blocks_[current_].size - offset_;
+        current_ = next;
+        offset_ = 0;
+        return take(0, bytes);
+    }
+
+    /*
+     * in_use, peak and reserved (Bytes)
+     *
+     * 'in_use' counts alignment padding and the unused tail of blocks
+     * moved past, 'peak' is its high-water mark since construction or
+     * 'reset_peak', and 'reserved' is what the upstream has handed out.
+     */
+    std::size_t in_use() const {
+        return in_use_;
+    }
+
+    std::size_t peak() const {
+        return peak_;
+    }
+
+    std::size_t reserved() const {
+        return reserved_;
+    }
+
+    void reset_peak() {
+        peak_ = in_use_;
+    }
+
+    std::pmr::memory_resource* upstream() const {
+        return upstream_;
+    }
+
+private:
+    struct block {
+        char* data;
+        std::size_t size;
+    };
+
+    void grow(std::size_t last, std::size_t bytes) {
+        const std::size_t size = std::max({ initial_, 2 * last, align(bytes, block_alignment) });
+        blocks_.push_back({ static_cast<char*>(upstream_->allocate(size, block_alignment)), size });
+        reserved_ += size;
+    }
+
+    static std::size_t align(std::size_t offset, std::size_t alignment) {
+        return (offset + alignment - 1) / alignment * alignment;
+    }
+
+    void* take(std::size_t start, std::size_t bytes) {
+        in_use_ += start + bytes - offset_;
+        peak_ = std::max(peak_, in_use_);
+        offset_ = start + bytes;
+        return blocks_[current_].data + start;
+    }
+
+    std::pmr::memory_resource* upstream_;
+    std::size_t initial_;
+    std::vector<block> blocks_;
+    std::size_t current_ = 0;
+    std::size_t offset_ = 0;
+    std::size_t in_use_ = 0;
+    std::size_t peak_ = 0;
+    std::size_t reserved_ = 0;
+};
+
+namespace impl {
+
+/*
+ * scratch_slot (The arena temporaries on this thread are drawn from)
+ */
+inline scratch_arena*& scratch_slot() {
+    thread_local scratch_arena arena;
+    thread_local scratch_arena* current = &arena;
+    return current;
+}
+
+} //namespace impl
+
+/*
+ * thread_scratch (This thread's scratch arena)
+ *
+ * Each thread has an arena of its own, created on first use with the
+ * default memory resource as upstream; a 'scratch_scope' redirects it.
+ */
+inline scratch_arena& thread_scratch() {
+    return *impl::scratch_slot();
+}
+
+/*
+ * scratch_scope (Points 'thread_scratch' at another arena until destroyed)
+ */
+class scratch_scope {
+public:
+    explicit scratch_scope(scratch_arena& arena) :
+        previous_(impl::scratch_slot())
+    {
+        impl::scratch_slot() = &arena;
+    }
+
+    scratch_scope(const scratch_scope&) = delete;
+    scratch_scope& operator=(const scratch_scope&) = delete;
+
+    ~scratch_scope() {
+        impl::scratch_slot() = previous_;
+    }
+
+private:
+    scratch_arena* previous_;
+};
+
+/*
+ * scratch_buffer (Zeroed array of 'count' limbs from a scratch arena)
+ *
+ * Released when destroyed, so buffers in nested scopes come and go in
+ * LIFO order; the pointer suits the 'mpn' kernels directly.
+ */
+template<typename T>
+class scratch_buffer {
+    static_assert(std::is_trivially_copyable<T>::value && std::is_trivially_destructible<T>::value);
+
+public:
+    explicit scratch_buffer(std::size_t count, scratch_arena& arena = thread_scratch()) :
+        arena_(arena),
+        mark_(arena.mark()),
+        data_(static_cast<T*>(arena.allocate(count * sizeof(T), scratch_arena::block_alignment))),
+        size_(count)
+    {
+        std::fill(data_, data_ + size_, T{});
+    }
+
+    scratch_buffer(const scratch_buffer&) = delete;
+    scratch_buffer& operator=(const scratch_buffer&) = delete;
+
+    ~scratch_buffer() {
+        arena_.release(mark_);
+    }
+
+    T* data() { return data_; }
+    const T* data() const { return data_; }
+    std::size_t size() const { return size_; }
+
+    T& operator[](std::size_t i) { return data_[i]; }
+    const T& operator[](std::size_t i) const { return data_[i]; }
+
+    T* begin() { return data_; }
+    T* end() { return data_ + size_; }
+    const T* begin() const { return data_; }
+    const T* end() const { return data_ + size_; }
+
+private:
+    scratch_arena& arena_;
+    scratch_arena::marker mark_;
+    T* data_;
+    std::size_t size_;
+};
+
+}//namespace ftl
+
+#endif//FTL_SCRATCH_HH
@@ -0,0 +1,98 @@
+#ifndef FTL_SPAN_HH
+#define FTL_SPAN_HH
+
+#include <array>
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+
+namespace ftl {
+
+/*
+ * span (Pointer and size, as a dynamic extent C++20 'std::span')
+ */
+template<typename T>
+class span {
+public:
+    using element_type = T;
+    using value_type = std::remove_cv_t<T>;
+    using iterator = T*;
+
+    constexpr span() = default;
+
+    constexpr span(T* data, std::size_t size) :
+        data_(data), size_(size)
+    {}
+
+    template<std::size_t N>
+    constexpr span(T (&data)[N]) :
+        data_(data), size_(N)
+    {}
+
+    template<typename U, std::size_t N, typename = std::enable_if_t<std::is_convertible<U (*)[], T (*)[]>::value>>
+    constexpr span(std::array<U, N>& data) :
+        data_(data.data()), size_(N)
+    {}
+
+    template<typename U, std::size_t N, typename = std::enable_if_t<std::is_convertible<const U (*)[], T (*)[]>::value>>
+    constexpr span(const std::array<U, N>& data) :
+        data_(data.data()), size_(N)
+    {}
+
+    template<typename U, typename = std::enable_if_t<std::is_convertible<U (*)[], T (*)[]>::value>>
+    constexpr span(const span<U>& other) :
+        data_(other.data()), size_(other.size())
+    {}
+
+    // Rvalue containers only bind to spans of const elements
+    template<
+        typename C,
+        typename = std::enable_if_t<
+            !std::is_array<std::remove_reference_t<C>>::value
+            && (std::is_lvalue_reference<C>::value || std::is_const<T>::value)
+            && std::is_convertible<std::remove_pointer_t<decltype(std::declval<C&>().data())> (*)[], T (*)[]>::value
+        >,
+        typename = decltype(std::declval<C&>().size())
+    >
+    constexpr span(C&& container) :
+        data_(container.data()), size_(container.size())
+    {}
+
+    constexpr T* data() const { return data_; }
+    constexpr std::size_t size() const { return size_; }
+    constexpr bool empty() const { return size_ == 0; }
+    constexpr T& operator[](std::size_t i) const { return data_[i]; }
+    constexpr iterator begin() const { return data_; }
+    constexpr iterator end() const { return data_ + size_; }
+
+    constexpr span first(std::size_t count) const { return { data_, count }; }
+    constexpr span last(std::size_t count) const { return { data_ + size_ - count, count }; }
+    constexpr span subspan(std::size_t offset, std::size_t count) const { return { data_ + offset, count }; }
+
+private:
+    T* data_ = nullptr;
+    std::size_t size_ = 0;
+};
+
+}//namespace ftl
+
+/*
+ * span
+ */
+static_assert([] {
+    int values[] = { 1, 2, 3, 4 };
+    const ftl::span<int> all = values;
+    const ftl::span<const int> tail = all.last(3);
+    return all.size() == 4 && tail[0] == 2 && tail.subspan(1, 2)[1] == 4 && all.first(0).empty();
+}());
+static_assert([] {
+    std::array<int, 3> values = { 1, 2, 3 };
+    const ftl::span<const int> view = values;
+    int sum = 0;
+    for (const int v : view) {
+        sum += v;
+    }
+    return sum == 6;
+}());
+
+#endif//FTL_SPAN_HH
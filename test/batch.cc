@@ -0,0 +1,74 @@
+#include "check.hh"
+
+#include <ftl/batch.hh>
+
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+namespace {
+
+std::mt19937_64 generator(42);
+
+template<std::size_t BITS>
+std::vector<ftl::bigint<BITS>> random_values(std::size_t count) {
+    std::vector<ftl::bigint<BITS>> values(count);
+    for (ftl::bigint<BITS>& value : values) {
+        // Some values use fewer limbs, so the divisions take every path
+        const std::size_t limbs = 1 + generator() % value.count;
+        for (std::size_t i = 0; i < limbs; ++i) {
+            value[i] = static_cast<std::uint32_t>(generator());
+        }
+    }
+    return values;
+}
+
+} //namespace
+
+/*
+ * batch (Against the scalar functions, over several chunks and threads)
+ */
+int main() {
+    const std::size_t threads = 4;
+    {
+        const auto a = random_values<256>(5000);
+        const auto b = random_values<128>(5000);
+        using product = decltype(ftl::multiply(a[0], b[0]));
+        std::vector<product> out(a.size());
+        ftl::batch::multiply<256, 128, std::uint32_t, product>(a, b, out, threads);
+        for (std::size_t i = 0; i < out.size(); ++i) {
+            FTL_CHECK(out[i] == ftl::multiply(a[i], b[i]));
+        }
+    }
+    {
+        const auto a = random_values<512>(3000);
+        auto b = random_values<192>(3000);
+        for (ftl::bigint<192>& value : b) {
+            value[0] |= 1;
+        }
+        std::vector<ftl::bigint<512>> quotient(a.size());
+        std::vector<ftl::bigint<192>> remainder(a.size());
+        ftl::batch::divmod<512, 192, std::uint32_t>(a, b, quotient, remainder, threads);
+        for (std::size_t i = 0; i < a.size(); ++i) {
+            const auto expected = ftl::divmod(a[i], b[i]);
+            FTL_CHECK(quotient[i] == expected.first && remainder[i] == expected.second);
+        }
+    }
+    {
+        ftl::bigint<256> modulus = random_values<256>(1)[0];
+        modulus[0] |= 1;
+        modulus[7] |= 0x80000000;
+        auto base = random_values<256>(200);
+        for (ftl::bigint<256>& value : base) {
+            value = value % modulus;
+        }
+        const auto exponent = random_values<64>(base.size());
+        std::vector<ftl::bigint<256>> out(base.size());
+        ftl::batch::pow_mod<256, 64, std::uint32_t>(base, exponent, modulus, out, threads);
+        for (std::size_t i = 0; i < out.size(); ++i) {
+            FTL_CHECK(out[i] == ftl::pow_mod(base[i], exponent[i], modulus));
+        }
+    }
+    return ftl::test::failures() != 0;
+}
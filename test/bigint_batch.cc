@@ -0,0 +1,80 @@
+#include "check.hh"
+
+#include <ftl/bigint_arithmetic_addition.hh>
+#include <ftl/bigint_arithmetic_division.hh>
+#include <ftl/bigint_arithmetic_multiplication.hh>
+#include <ftl/bigint_arithmetic_subtraction.hh>
+#include <ftl/bigint_batch.hh>
+
+#include <cstddef>
+#include <cstdint>
+#include <random>
+
+namespace {
+
+std::mt19937_64 generator(43);
+
+// Random limbs, or all ones or zero to run the carries through every limb
+template<std::size_t BITS>
+ftl::bigint<BITS> random_value() {
+    ftl::bigint<BITS> value = {};
+    const unsigned kind = generator() % 4;
+    for (std::uint32_t& limb : value) {
+        limb = kind == 0 ? 0xFFFFFFFFu : kind == 1 ? 0u : static_cast<std::uint32_t>(generator());
+    }
+    return ftl::resize<BITS>(value);
+}
+
+/*
+ * bigint_batch (Every lane against the bigint function, at runtime)
+ *
+ * LANES is not a multiple of 8, so with AVX2 both the vector steps and
+ * the scalar tail run.
+ */
+template<std::size_t BITS, std::size_t LANES>
+void check_batch() {
+    ftl::bigint_batch<BITS, LANES> a = {};
+    ftl::bigint_batch<BITS, LANES> b = {};
+    for (std::size_t lane = 0; lane < LANES; ++lane) {
+        a.set(lane, random_value<BITS>());
+        b.set(lane, random_value<BITS>());
+    }
+    const auto sum = ftl::add(a, b);
+    const auto difference = ftl::subtract(a, b);
+    const auto product = ftl::multiply(a, b);
+    for (std::size_t lane = 0; lane < LANES; ++lane) {
+        FTL_CHECK(sum.get(lane) == ftl::add_in_place(a.get(lane), b.get(lane)));
+        FTL_CHECK(difference.get(lane) == ftl::subtract_in_place(a.get(lane), b.get(lane)));
+        FTL_CHECK(product.get(lane) == ftl::multiply(a.get(lane), b.get(lane)));
+    }
+
+    // Odd modulus with the top bit set, and operands below it
+    ftl::bigint<BITS> modulus = random_value<BITS>();
+    modulus[0] |= 1;
+    modulus[modulus.count - 1] |= static_cast<std::uint32_t>(1u << ((BITS - 1) % 32));
+    const ftl::montgomery<BITS> m(modulus);
+    for (std::size_t lane = 0; lane < LANES; ++lane) {
+        a.set(lane, a.get(lane) % modulus);
+        b.set(lane, b.get(lane) % modulus);
+    }
+    const auto montgomery_product = ftl::montgomery_multiply(m, a, b);
+    const auto reduced = ftl::montgomery_reduce(m, ftl::multiply(a, b));
+    for (std::size_t lane = 0; lane < LANES; ++lane) {
+        const ftl::bigint<BITS> expected = ftl::montgomery_multiply(m, a.get(lane), b.get(lane));
+        FTL_CHECK(montgomery_product.get(lane) == expected);
+        FTL_CHECK(reduced.get(lane) == ftl::montgomery_reduce(m, ftl::multiply(a.get(lane), b.get(lane))));
+        FTL_CHECK(reduced.get(lane) == expected);
+    }
+}
+
+} //namespace
+
+int main() {
+    for (int round = 0; round < 20; ++round) {
+        check_batch<40, 19>();
+        check_batch<61, 13>();
+        check_batch<256, 19>();
+        check_batch<255, 8>();
+    }
+    return ftl::test::failures() != 0;
+}
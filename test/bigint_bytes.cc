@@ -0,0 +1,95 @@
+#include "check.hh"
+
+#include <ftl/bigint_bytes.hh>
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <utility>
+#include <vector>
+
+namespace {
+
+// Longer than every byte image below, so truncation is covered too
+constexpr std::size_t pattern_size = 144;
+
+constexpr std::array<std::byte, pattern_size> make_pattern() {
+    std::array<std::byte, pattern_size> bytes = {};
+    std::uint32_t state = 36;
+    for (std::byte& byte : bytes) {
+        state = state * 1664525u + 1013904223u;
+        byte = static_cast<std::byte>(state >> 24);
+    }
+    return bytes;
+}
+
+constexpr std::array<std::byte, pattern_size> pattern = make_pattern();
+
+/*
+ * from_bytes & to_bytes (Runtime paths against the constexpr loop)
+ *
+ * The expected values are constant evaluated, so they come from the
+ * portable loop; the same calls on a runtime copy take the memcpy and
+ * byte reversal paths. 1000 bits leaves a partial top limb to mask.
+ */
+template<ftl::endian ENDIAN, typename T, std::size_t LENGTH>
+void check_length() {
+    constexpr ftl::span<const std::byte> bytes(pattern.data(), LENGTH);
+    constexpr auto expected = ftl::from_bytes<ENDIAN, 1000, T>(bytes);
+    constexpr auto expected_out = [] {
+        std::array<std::byte, LENGTH> out = {};
+        const bool fits = ftl::to_bytes<ENDIAN>(ftl::from_bytes<ENDIAN, 1000, T>(bytes), out);
+        return std::make_pair(out, fits);
+    }();
+
+    const std::vector<std::byte> copy(pattern.begin(), pattern.begin() + LENGTH);
+    const auto value = ftl::from_bytes<ENDIAN, 1000, T>(copy);
+    FTL_CHECK(value == expected);
+
+    std::vector<std::byte> out(LENGTH, std::byte{ 0xAA });
+    const bool fits = ftl::to_bytes<ENDIAN>(value, out);
+    FTL_CHECK(fits == expected_out.second);
+    FTL_CHECK(std::equal(out.begin(), out.end(), expected_out.first.begin()));
+}
+
+template<ftl::endian ENDIAN, typename T, std::size_t... LENGTH>
+void check_lengths(std::index_sequence<LENGTH...>) {
+    (check_length<ENDIAN, T, LENGTH>(), ...);
+}
+
+/*
+ * Round trip of random byte strings that fit
+ */
+template<ftl::endian ENDIAN, typename T>
+void check_round_trip(std::mt19937_64& generator) {
+    for (std::size_t length = 0; length <= 128; ++length) {
+        std::vector<std::byte> bytes(length);
+        for (std::byte& byte : bytes) {
+            byte = static_cast<std::byte>(generator());
+        }
+        const auto value = ftl::from_bytes<ENDIAN, 1024, T>(bytes);
+        std::vector<std::byte> out(length);
+        FTL_CHECK(ftl::to_bytes<ENDIAN>(value, out) && out == bytes);
+    }
+}
+
+template<typename T>
+void check_limb() {
+    check_lengths<ftl::endian::little, T>(std::make_index_sequence<pattern_size + 1>{});
+    check_lengths<ftl::endian::big, T>(std::make_index_sequence<pattern_size + 1>{});
+    std::mt19937_64 generator(36);
+    check_round_trip<ftl::endian::little, T>(generator);
+    check_round_trip<ftl::endian::big, T>(generator);
+}
+
+} //namespace
+
+int main() {
+    check_limb<std::uint8_t>();
+    check_limb<std::uint16_t>();
+    check_limb<std::uint32_t>();
+    check_limb<std::uint64_t>();
+    return ftl::test::failures() != 0;
+}
@@ -0,0 +1,147 @@
+#include "check.hh"
+
+#include <ftl/bigint_arithmetic_addition.hh>
+#include <ftl/bigint_arithmetic_division.hh>
+#include <ftl/bigint_arithmetic_multiplication.hh>
+#include <ftl/bigint_arithmetic_shift.hh>
+#include <ftl/bigint_arithmetic_subtraction.hh>
+#include <ftl/bigint_dyn.hh>
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <random>
+#include <string>
+#include <system_error>
+#include <utility>
+
+namespace {
+
+std::mt19937_64 generator(45);
+
+// Fixed width reference, wide enough for every product below
+template<typename T>
+using reference = ftl::bigint<4096, T>;
+
+// Values up to 'bits' bits, some of them all ones
+template<typename T>
+reference<T> random_value(std::size_t bits) {
+    reference<T> value = {};
+    const std::size_t length = generator() % (bits + 1);
+    const bool ones = generator() % 4 == 0;
+    for (std::size_t i = 0; i * std::numeric_limits<T>::digits < length; ++i) {
+        value[i] = ones ? static_cast<T>(~T{ 0 }) : static_cast<T>(generator());
+    }
+    return value >> (4096 - length);
+}
+
+template<typename T>
+bool same(const ftl::bigint_dyn<T>& value, const reference<T>& expected) {
+    return value.size() == ftl::mpn::normalized_size(expected.data(), expected.count)
+        && ftl::resize<4096>(value) == expected;
+}
+
+template<typename T>
+std::string chars(const ftl::bigint_dyn<T>& value, int radix) {
+    std::string out(4200, ' ');
+    const std::to_chars_result result = ftl::to_chars(out.data(), out.data() + out.size(), value, radix);
+    return result.ec == std::errc{} ? std::string(out.data(), result.ptr) : std::string();
+}
+
+template<typename T>
+std::string chars(const reference<T>& value, int radix) {
+    std::string out(4200, ' ');
+    const std::to_chars_result result = ftl::to_chars(out.data(), out.data() + out.size(), value, radix);
+    return result.ec == std::errc{} ? std::string(out.data(), result.ptr) : std::string();
+}
+
+/*
+ * Operators against bigint<4096>, on values of up to 1800 bits
+ */
+template<typename T>
+void check_operators() {
+    for (int iteration = 0; iteration < 300; ++iteration) {
+        const std::size_t bits = iteration % 3 == 0 ? 100 : 1800;
+        const reference<T> a = random_value<T>(bits);
+        const reference<T> b = random_value<T>(bits);
+        const ftl::bigint_dyn<T> x(a);
+        const ftl::bigint_dyn<T> y(b);
+        FTL_CHECK(same(x, a) && same(y, b));
+
+        FTL_CHECK(same(x + y, ftl::add_in_place(a, b)));
+        FTL_CHECK(same(x * y, ftl::multiply(ftl::resize<2048>(a), ftl::resize<2048>(b))));
+        if (a >= b) {
+            FTL_CHECK(same(x - y, ftl::subtract_in_place(a, b)));
+        } else {
+            FTL_CHECK(same(y - x, ftl::subtract_in_place(b, a)));
+        }
+        if (b != reference<T>{}) {
+            const auto qr = ftl::divmod(x, y);
+            const auto expected = ftl::divmod(a, b);
+            FTL_CHECK(same(qr.first, expected.first) && same(qr.second, expected.second));
+            FTL_CHECK(same(x / y, expected.first) && same(x % y, expected.second));
+        }
+
+        const std::size_t shift = generator() % 300;
+        FTL_CHECK(same(x << shift, a << shift));
+        FTL_CHECK(same(x >> shift, a >> shift));
+        FTL_CHECK(same(x >> (10 * shift), a >> (10 * shift)));
+        FTL_CHECK((x < y) == (a < b) && (x == y) == (a == b));
+
+        // Compound assignment, including aliasing and moves
+        ftl::bigint_dyn<T> z = x;
+        z += z;
+        FTL_CHECK(same(z, ftl::add_in_place(a, a)));
+        z -= x;
+        FTL_CHECK(same(z, a));
+        z *= y;
+        FTL_CHECK(same(z, ftl::multiply(ftl::resize<2048>(a), ftl::resize<2048>(b))));
+        ftl::bigint_dyn<T> moved = std::move(z);
+        FTL_CHECK(z.size() == 0);
+        z = x;
+        z <<= shift;
+        z >>= shift;
+        FTL_CHECK(z == x && moved == x * y);
+
+        for (const int radix : { 10, 16, 8, 2 }) {
+            const std::string text = chars(x, radix);
+            FTL_CHECK(!text.empty() && text == chars(a, radix));
+            ftl::bigint_dyn<T> parsed;
+            const std::from_chars_result result = ftl::from_chars(text.data(), text.data() + text.size(), parsed, radix);
+            FTL_CHECK(result.ec == std::errc{} && result.ptr == text.data() + text.size() && parsed == x);
+        }
+    }
+}
+
+} //namespace
+
+/*
+ * bigint_dyn
+ */
+int main() {
+    check_operators<std::uint8_t>();
+    check_operators<std::uint32_t>();
+    check_operators<std::uint64_t>();
+
+    // Long decimal strings take the divide-and-conquer path of 'from_chars'
+    std::string digits(30000, '0');
+    for (char& c : digits) {
+        c = static_cast<char>('0' + generator() % 10);
+    }
+    digits[0] = '7';
+    ftl::bigint_dyn<> value;
+    const std::from_chars_result parsed = ftl::from_chars(digits.data(), digits.data() + digits.size(), value);
+    FTL_CHECK(parsed.ec == std::errc{} && parsed.ptr == digits.data() + digits.size());
+    std::string out(digits.size() + 1, ' ');
+    const std::to_chars_result printed = ftl::to_chars(out.data(), out.data() + out.size(), value);
+    FTL_CHECK(printed.ec == std::errc{} && std::string(out.data(), printed.ptr) == digits);
+
+    ftl::bigint_dyn<> empty;
+    FTL_CHECK(ftl::from_chars(digits.data(), digits.data(), empty).ec == std::errc::invalid_argument);
+    FTL_CHECK(ftl::bigint_dyn<>(std::uint32_t{ 0 }).size() == 0);
+
+    // A zero divisor gives zero for both results
+    const auto qr = ftl::divmod(value, ftl::bigint_dyn<>());
+    FTL_CHECK(qr.first.size() == 0 && qr.second.size() == 0);
+    return ftl::test::failures() != 0;
+}
@@ -0,0 +1,92 @@
+#include "check.hh"
+
+#include <ftl/bigint_parallel.hh>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <string>
+#include <system_error>
+#include <vector>
+
+namespace {
+
+std::mt19937_64 generator(40);
+
+template<typename T>
+std::vector<T> random_limbs(std::size_t count) {
+    std::vector<T> limbs(count);
+    for (T& limb : limbs) {
+        limb = static_cast<T>(generator());
+    }
+    return limbs;
+}
+
+/*
+ * mul_parallel (Against 'mul', above and below the threshold)
+ */
+template<typename T>
+void check_mul_parallel(std::size_t an, std::size_t bn) {
+    const std::vector<T> a = random_limbs<T>(an);
+    const std::vector<T> b = random_limbs<T>(bn);
+    std::vector<T> expected(an + bn);
+    if (an >= bn) {
+        ftl::mpn::mul(expected.data(), a.data(), an, b.data(), bn);
+    } else {
+        ftl::mpn::mul(expected.data(), b.data(), bn, a.data(), an);
+    }
+    for (const std::size_t threads : { 1, 2, 3, 5 }) {
+        std::vector<T> product(an + bn, static_cast<T>(~T{ 0 }));
+        ftl::mpn::mul_parallel(product.data(), a.data(), an, b.data(), bn, threads);
+        FTL_CHECK(product == expected);
+    }
+}
+
+/*
+ * to_chars_parallel & from_chars_parallel (Against the serial functions)
+ */
+template<std::size_t BITS>
+void check_chars_parallel(const ftl::bigint<BITS>& value) {
+    for (const int radix : { 10, 16, 36, 58 }) {
+        std::string expected(BITS + 1, ' ');
+        const std::to_chars_result serial = ftl::to_chars(expected.data(), expected.data() + expected.size(), value, radix);
+        FTL_CHECK(serial.ec == std::errc{});
+        expected.resize(static_cast<std::size_t>(serial.ptr - expected.data()));
+        ftl::bigint<BITS> expected_value;
+        ftl::from_chars(expected.data(), expected.data() + expected.size(), expected_value, radix);
+        FTL_CHECK(expected_value == value);
+
+        for (const std::size_t threads : { 1, 3 }) {
+            std::string text(BITS + 1, ' ');
+            const std::to_chars_result result = ftl::to_chars_parallel(text.data(), text.data() + text.size(), value, radix, threads);
+            FTL_CHECK(result.ec == std::errc{});
+            text.resize(static_cast<std::size_t>(result.ptr - text.data()));
+            FTL_CHECK(text == expected);
+
+            ftl::bigint<BITS> parsed;
+            const std::from_chars_result back = ftl::from_chars_parallel(expected.data(), expected.data() + expected.size(), parsed, radix, threads);
+            FTL_CHECK(back.ec == std::errc{} && back.ptr == expected.data() + expected.size() && parsed == value);
+        }
+    }
+}
+
+} //namespace
+
+int main() {
+    check_mul_parallel<std::uint32_t>(2000, 600);
+    check_mul_parallel<std::uint32_t>(600, 2000);
+    check_mul_parallel<std::uint32_t>(1 << 16, 17);
+    check_mul_parallel<std::uint32_t>(40, 30);
+    check_mul_parallel<std::uint64_t>(1500, 1500);
+
+    ftl::bigint<40000> value = {};
+    const std::vector<std::uint32_t> limbs = random_limbs<std::uint32_t>(value.count);
+    std::copy(limbs.begin(), limbs.end(), value.begin());
+    check_chars_parallel(value);
+    // Leading zero limbs, and zero itself
+    std::fill(value.begin() + 700, value.end(), 0u);
+    check_chars_parallel(value);
+    check_chars_parallel(ftl::bigint<40000>{});
+    return ftl::test::failures() != 0;
+}
@@ -0,0 +1,79 @@
+#include "check.hh"
+
+#include <ftl/bigint_sort.hh>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+namespace {
+
+using key_type = ftl::bigint<128>;
+
+std::mt19937_64 generator(44);
+
+// Keys varying in the low 'bits' bits only, so with duplicates when short
+std::vector<key_type> random_keys(std::size_t count, std::size_t bits) {
+    std::vector<key_type> keys(count);
+    for (key_type& key : keys) {
+        for (std::size_t i = 0; i * 32 < bits; ++i) {
+            key[i] = static_cast<std::uint32_t>(generator());
+        }
+        if (bits % 32 != 0) {
+            key[bits / 32] &= (1u << (bits % 32)) - 1;
+        }
+    }
+    return keys;
+}
+
+/*
+ * sort & sort_by_key (Threaded, against 'std::stable_sort')
+ */
+void check_sort(std::size_t bits) {
+    // Enough keys for three workers above 'sort_parallel_threshold'
+    const std::size_t count = 3 * ftl::impl::sort_parallel_threshold::value + 123;
+    const std::vector<key_type> keys = random_keys(count, bits);
+
+    std::vector<std::uint32_t> expected_payload(count);
+    for (std::size_t i = 0; i < count; ++i) {
+        expected_payload[i] = static_cast<std::uint32_t>(i);
+    }
+    std::stable_sort(expected_payload.begin(), expected_payload.end(), [&](std::uint32_t a, std::uint32_t b) {
+        return keys[a] < keys[b];
+    });
+    std::vector<key_type> expected(count);
+    for (std::size_t i = 0; i < count; ++i) {
+        expected[i] = keys[expected_payload[i]];
+    }
+
+    for (const std::size_t threads : { 1, 3, 8 }) {
+        std::vector<key_type> sorted = keys;
+        ftl::sort<128, std::uint32_t>(sorted, threads);
+        FTL_CHECK(sorted == expected);
+
+        std::vector<key_type> sorted_keys = keys;
+        std::vector<std::uint32_t> payload(count);
+        for (std::size_t i = 0; i < count; ++i) {
+            payload[i] = static_cast<std::uint32_t>(i);
+        }
+        ftl::sort_by_key<128, std::uint32_t, std::uint32_t>(sorted_keys, payload, threads);
+        FTL_CHECK(sorted_keys == expected && payload == expected_payload);
+    }
+
+    std::vector<key_type> serial = keys;
+    ftl::sort<128, std::uint32_t>(serial);
+    FTL_CHECK(serial == expected);
+}
+
+} //namespace
+
+int main() {
+    // One and three varying bytes sort bottom-up, in an odd number of
+    // passes that ends with a copy back; sixteen sort top-down
+    check_sort(8);
+    check_sort(20);
+    check_sort(128);
+    return ftl::test::failures() != 0;
+}
@@ -0,0 +1,68 @@
+#include "check.hh"
+
+#include <ftl/bigint_varint.hh>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <system_error>
+#include <vector>
+
+/*
+ * encode_varints & decode_varints (Round trip across 64 byte blocks)
+ */
+int main() {
+    using value_type = ftl::bigint<256, std::uint32_t>;
+    std::mt19937_64 random(37);
+    std::vector<value_type> values(2000);
+    for (value_type& value : values) {
+        // Mostly one and two byte encodings, with some up to the full width
+        const std::size_t limbs = random() % 4 == 0 ? 1 + random() % value.count : 1;
+        const std::uint32_t mask = random() % 2 == 0 ? 0x3FFF : 0xFFFFFFFF;
+        for (std::size_t i = 0; i < limbs; ++i) {
+            value[i] = static_cast<std::uint32_t>(random()) & (i == 0 ? mask : 0xFFFFFFFF);
+        }
+    }
+
+    std::vector<std::byte> bytes(values.size() * ftl::impl::max_varint_size<256, std::uint32_t>::value);
+    std::byte* const end = ftl::encode_varints<256, std::uint32_t>(values, bytes.data());
+    bytes.resize(static_cast<std::size_t>(end - bytes.data()));
+    std::size_t size = 0;
+    for (const value_type& value : values) {
+        size += ftl::varint_size(value);
+    }
+    FTL_CHECK(bytes.size() == size);
+
+    std::vector<value_type> decoded(values.size());
+    ftl::varint_result result = ftl::decode_varints<256, std::uint32_t>(bytes, decoded);
+    FTL_CHECK(result.ec == std::errc{} && result.count == values.size() && result.ptr == bytes.data() + bytes.size());
+    FTL_CHECK(decoded == values);
+
+    // The input ends inside the last encoding: everything before it decodes
+    const std::size_t last = ftl::varint_size(values.back());
+    const std::vector<std::byte> truncated(bytes.begin(), bytes.end() - 1);
+    decoded.assign(values.size(), value_type{});
+    result = ftl::decode_varints<256, std::uint32_t>(truncated, decoded);
+    FTL_CHECK(result.ec == std::errc::invalid_argument);
+    FTL_CHECK(result.count == values.size() - 1);
+    FTL_CHECK(result.ptr == truncated.data() + bytes.size() - last);
+    FTL_CHECK(std::equal(values.begin(), values.end() - 1, decoded.begin()));
+
+    // A value too wide for the output stops the batch at its index
+    std::vector<ftl::bigint<16, std::uint16_t>> narrow(values.size());
+    result = ftl::decode_varints<16, std::uint16_t>(bytes, narrow);
+    std::size_t fits = 0;
+    while (fits < values.size() && values[fits].highest_bit() <= 16) {
+        ++fits;
+    }
+    FTL_CHECK(result.ec == std::errc::result_out_of_range && result.count == fits);
+
+    // Output shorter than the input
+    decoded.assign(10, value_type{});
+    result = ftl::decode_varints<256, std::uint32_t>(bytes, decoded);
+    FTL_CHECK(result.ec == std::errc{} && result.count == 10);
+    FTL_CHECK(std::equal(decoded.begin(), decoded.end(), values.begin()));
+
+    return ftl::test::failures() != 0;
+}
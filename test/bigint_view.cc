@@ -0,0 +1,111 @@
+#include "check.hh"
+
+#include <ftl/bigint_arithmetic_addition.hh>
+#include <ftl/bigint_arithmetic_division.hh>
+#include <ftl/bigint_arithmetic_multiplication.hh>
+#include <ftl/bigint_view.hh>
+#include <ftl/mapped_file.hh>
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace {
+
+using value_type = ftl::bigint<256, std::uint64_t>;
+
+void write_file(const std::string& path, const std::vector<std::byte>& bytes) {
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    out.write(reinterpret_cast<const char*>(bytes.data()), static_cast<std::streamsize>(bytes.size()));
+}
+
+std::vector<std::byte> table_file(const ftl::bigint_table_header& header, const std::vector<value_type>& values) {
+    std::vector<std::byte> bytes(ftl::bigint_table_header::size + values.size() * sizeof(value_type));
+    ftl::write_table_header(header, bytes);
+    std::memcpy(bytes.data() + ftl::bigint_table_header::size, values.data(), values.size() * sizeof(value_type));
+    return bytes;
+}
+
+} //namespace
+
+/*
+ * bigint_table (Over a 'mapped_file', with view arithmetic against bigint)
+ */
+int main() {
+    std::mt19937_64 random(38);
+    std::vector<value_type> values(64);
+    for (value_type& value : values) {
+        // Some values use fewer limbs, so the views differ in significant size
+        const std::size_t limbs = 1 + random() % value.count;
+        for (std::size_t i = 0; i < limbs; ++i) {
+            value[i] = random();
+        }
+    }
+    values[5] = value_type{};
+
+    const std::string path = (std::filesystem::temp_directory_path() / "ftl-test-bigint_view.bin").string();
+    const ftl::bigint_table_header header = ftl::make_table_header<std::uint64_t>(value_type::count, values.size());
+    write_file(path, table_file(header, values));
+    {
+        const ftl::mapped_file file(path.c_str());
+        FTL_CHECK(file.good());
+        FTL_CHECK(file.bytes().size() == ftl::bigint_table_header::size + values.size() * sizeof(value_type));
+
+        const ftl::bigint_table<std::uint64_t> table(file.bytes());
+        FTL_CHECK(table.good());
+        FTL_CHECK(table.size() == values.size());
+        FTL_CHECK(table.header().limbs == value_type::count);
+        for (std::size_t i = 0; i < table.size(); ++i) {
+            FTL_CHECK(ftl::resize<256>(table[i]) == values[i]);
+        }
+
+        for (std::size_t i = 0; i + 1 < table.size(); ++i) {
+            const value_type& a = values[i];
+            const value_type& b = values[i + 1];
+            FTL_CHECK(ftl::add<257>(table[i], table[i + 1]) == ftl::add(a, b));
+            FTL_CHECK(ftl::add<256>(table[i], table[i + 1]) == ftl::add_in_place(a, b));
+            FTL_CHECK(ftl::multiply<512>(table[i], table[i + 1]) == ftl::multiply(a, b));
+            FTL_CHECK(ftl::multiply<100>(table[i], table[i + 1]) == ftl::resize<100>(ftl::multiply(a, b)));
+            if (b != value_type{}) {
+                const auto view_qr = ftl::divmod<256>(table[i], table[i + 1]);
+                const auto qr = ftl::divmod(a, b);
+                FTL_CHECK(view_qr.first == qr.first && view_qr.second == qr.second);
+            }
+        }
+    }
+
+    // Limb size other than the table's
+    {
+        const ftl::mapped_file file(path.c_str());
+        FTL_CHECK(!ftl::bigint_table<std::uint32_t>(file.bytes()).good());
+    }
+
+    // Header promising more values than the file holds
+    {
+        std::vector<std::byte> bytes = table_file(header, values);
+        bytes.resize(bytes.size() - 1);
+        write_file(path, bytes);
+        const ftl::mapped_file file(path.c_str());
+        const ftl::bigint_table<std::uint64_t> table(file.bytes());
+        FTL_CHECK(file.good() && !table.good() && table.size() == 0);
+    }
+
+    // Unknown magic
+    {
+        std::vector<std::byte> bytes = table_file(header, values);
+        bytes[0] = std::byte{ 'X' };
+        write_file(path, bytes);
+        const ftl::mapped_file file(path.c_str());
+        FTL_CHECK(file.good() && !ftl::bigint_table<std::uint64_t>(file.bytes()).good());
+    }
+
+    std::remove(path.c_str());
+    FTL_CHECK(!ftl::mapped_file(path.c_str()).good());
+    return ftl::test::failures() != 0;
+}
@@ -0,0 +1,23 @@
+#include <ftl/bigint_radix.hh>
+#include <ftl/charconv.hh>
+
+#include <cstdint>
+#include <limits>
+
+/*
+ * constant_digits
+ */
+constexpr auto secp256k1_p = 0xFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFEFFFFFC2F_16;
+constexpr auto zero_bigint = 0_10;
+constexpr std::int64_t int64_min = std::numeric_limits<std::int64_t>::min();
+
+static_assert(ftl::constant_digits<secp256k1_p>::size == 78);
+static_assert(ftl::constant_digits<secp256k1_p>::value.size() == 78);
+static_assert(ftl::constant_digits<secp256k1_p>::view
+    == "115792089237316195423570985008687907853269984665640564039457584007908834671663");
+static_assert(ftl::constant_digits_v<secp256k1_p, 16>
+    == "FFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFEFFFFFC2F");
+static_assert(ftl::constant_digits_v<zero_bigint> == "0");
+static_assert(ftl::constant_digits_v<int64_min> == "-9223372036854775808");
+
+int main() {}
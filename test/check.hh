@@ -0,0 +1,27 @@
+#ifndef FTL_TEST_CHECK_HH
+#define FTL_TEST_CHECK_HH
+
+#include <cstdio>
+
+namespace ftl::test {
+
+/*
+ * failures (Checks failed so far; 'main' returns whether there were any)
+ */
+inline int& failures() {
+    static int count = 0;
+    return count;
+}
+
+inline void check(bool ok, const char* expression, const char* file, int line) {
+    if (!ok) {
+        std::fprintf(stderr, "%s:%d: check failed: %s\n", file, line, expression);
+        ++failures();
+    }
+}
+
+} //namespace ftl::test
+
+#define FTL_CHECK(...) ftl::test::check(static_cast<bool>(__VA_ARGS__), #__VA_ARGS__, __FILE__, __LINE__)
+
+#endif//FTL_TEST_CHECK_HH
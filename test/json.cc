@@ -0,0 +1,178 @@
+#include "check.hh"
+
+#include <ftl/json.hh>
+
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <string>
+#include <string_view>
+#include <vector>
+
+/*
+ * constant_document
+ */
+static constexpr char config[] = R"({
+    "name": "ftl",
+    "port": 8080,
+    "modulus": 115792089237316195423570985008687907853269984665640564039457584007908834671663,
+    "debug": false,
+    "limits": [1, 2, 4]
+})";
+
+static constexpr ftl::json::value port = ftl::json::constant_document_v<config>.root()["port"];
+
+static_assert(ftl::json::constant_document<config>::index.size() == 33);
+static_assert(port.at() == 10);
+static_assert(port.as<std::uint16_t>() == 8080);
+static_assert(ftl::json::constant_document_v<config>.root()["name"].string() == "ftl");
+static_assert(!ftl::json::constant_document_v<config>.root()["debug"].boolean());
+static_assert(ftl::json::constant_document_v<config>.root()["limits"][2].as<int>() == 4);
+static_assert(ftl::json::constant_document_v<config>.root()["modulus"].as<ftl::bigint<256>>()[0] == 0xFFFFFC2F);
+
+/*
+ * check_grammar (The check behind constant_document's status)
+ */
+static constexpr ftl::json::error grammar(std::string_view text) {
+    std::uint32_t index[64] = {};
+    char stack[64] = {};
+    ftl::json::error status = ftl::json::error::none;
+    const std::size_t count = ftl::json::impl::index_scalar(text.data(), text.size(), index, status);
+    return status != ftl::json::error::none ? status : ftl::json::impl::check_grammar(text, index, count, stack);
+}
+
+static_assert(grammar(config) == ftl::json::error::none);
+static_assert(grammar(R"( {"a": [{}, [], "b", -1.5e3, true, null]} )") == ftl::json::error::none);
+static_assert(grammar(R"("only")") == ftl::json::error::none);
+static_assert(grammar("0") == ftl::json::error::none);
+static_assert(grammar("[]") == ftl::json::error::none);
+
+static_assert(grammar(R"({"a":})") == ftl::json::error::syntax);
+static_assert(grammar("{]") == ftl::json::error::syntax);
+static_assert(grammar("[1 2 3]") == ftl::json::error::syntax);
+static_assert(grammar(R"({"a" 1})") == ftl::json::error::syntax);
+static_assert(grammar(R"({"a":1,})") == ftl::json::error::syntax);
+static_assert(grammar(R"({1:2})") == ftl::json::error::syntax);
+static_assert(grammar(R"({"a":1 "b":2})") == ftl::json::error::syntax);
+static_assert(grammar(R"({"a"::1})") == ftl::json::error::syntax);
+static_assert(grammar("[1,]") == ftl::json::error::syntax);
+static_assert(grammar("[,1]") == ftl::json::error::syntax);
+static_assert(grammar("{,}") == ftl::json::error::syntax);
+static_assert(grammar("[[]") == ftl::json::error::syntax);
+static_assert(grammar("[]]") == ftl::json::error::syntax);
+static_assert(grammar("}") == ftl::json::error::syntax);
+static_assert(grammar("1 2") == ftl::json::error::syntax);
+static_assert(grammar(R"("a""b")") == ftl::json::error::syntax);
+static_assert(grammar("[tru]") == ftl::json::error::syntax);
+static_assert(grammar("[01]") == ftl::json::error::syntax);
+static_assert(grammar("[-]") == ftl::json::error::syntax);
+static_assert(grammar(R"(["a)") == ftl::json::error::unclosed_string);
+static_assert(grammar("  ") == ftl::json::error::empty);
+
+namespace {
+
+std::mt19937_64 generator(31);
+
+/*
+ * index_simd & parser::parse (Against index_scalar)
+ *
+ * Built with AVX2 and PCLMUL, this runs the vectorized classification and
+ * the carry-less prefix xor; otherwise both fall back to the scalar scan.
+ */
+void check_index(std::string_view text, ftl::json::parser& parser) {
+    std::vector<std::uint32_t> expected(text.size() + 1);
+    ftl::json::error expected_status = ftl::json::error::none;
+    const std::size_t expected_count = ftl::json::impl::index_scalar(text.data(), text.size(), expected.data(), expected_status);
+    expected.resize(expected_count);
+
+    std::vector<std::uint32_t> index(text.size() + 1);
+    ftl::json::error status = ftl::json::error::none;
+    const std::size_t count = ftl::json::impl::index_simd(text.data(), text.size(), index.data(), status);
+    index.resize(count);
+    FTL_CHECK(status == expected_status && index == expected);
+
+    const ftl::json::document doc = parser.parse(text);
+    FTL_CHECK(doc.status() == expected_status && doc.count() == expected_count);
+    for (std::size_t i = 0; i < doc.count() && i < expected_count; ++i) {
+        FTL_CHECK(doc.position(i) == expected[i]);
+    }
+}
+
+// Structural characters, scalars and strings whose escapes include runs
+// of backslashes, so quotes and escapes land on every offset of a block
+std::string random_text(std::size_t tokens) {
+    static constexpr std::string_view pieces[] = { "{", "}", "[", "]", ":", ",", " ", "\n", "12", "true", "-0.5e3" };
+    std::string text;
+    for (std::size_t i = 0; i < tokens; ++i) {
+        if (generator() % 3 != 0) {
+            text += pieces[generator() % (sizeof(pieces) / sizeof(pieces[0]))];
+            continue;
+        }
+        text += '"';
+        const std::size_t length = generator() % 12;
+        for (std::size_t k = 0; k < length; ++k) {
+            switch (generator() % 5) {
+            case 0:
+                text.append(1 + generator() % 6, '\\');
+                text += generator() % 2 == 0 ? '"' : 'n';
+                break;
+            case 1:
+                text += "\\\"";
+                break;
+            case 2:
+                text += ' ';
+                break;
+            default:
+                text += static_cast<char>('a' + generator() % 26);
+                break;
+            }
+        }
+        text += '"';
+    }
+    return text;
+}
+
+} //namespace
+
+int main() {
+    ftl::json::parser parser;
+
+    // Shorter than a block, and empty or blank
+    for (const std::string_view text : { "", "   ", "1", "\"a\"", "{\"a\":[1,2]}", "\"\\\"", "[\"\\\\\"]" }) {
+        check_index(text, parser);
+    }
+
+    // A string whose backslashes and closing quote straddle a block edge
+    for (std::size_t offset = 48; offset < 80; ++offset) {
+        for (std::size_t run = 0; run < 6; ++run) {
+            std::string text = "[" + std::string(offset, ' ') + "\"";
+            text.append(run, '\\');
+            text += "\",\"a\"]";
+            check_index(text, parser);
+        }
+    }
+
+    for (int round = 0; round < 2000; ++round) {
+        check_index(random_text(1 + generator() % 120), parser);
+    }
+
+#if defined(__AVX2__)
+    for (int round = 0; round < 1000; ++round) {
+        std::string block(ftl::json::impl::block_size::value, ' ');
+        for (char& c : block) {
+            c = static_cast<char>(generator());
+        }
+        const auto masks = ftl::json::impl::classify_avx2(block.data());
+        const auto expected = ftl::json::impl::classify(block.data());
+        FTL_CHECK(masks.quote == expected.quote && masks.backslash == expected.backslash
+            && masks.op == expected.op && masks.whitespace == expected.whitespace);
+    }
+#endif
+#if defined(__PCLMUL__)
+    for (int round = 0; round < 1000; ++round) {
+        const std::uint64_t bits = generator();
+        FTL_CHECK(ftl::json::impl::prefix_xor_clmul(bits) == ftl::json::impl::prefix_xor(bits));
+    }
+#endif
+    return ftl::test::failures() != 0;
+}
@@ -0,0 +1,84 @@
+#include <ftl/json_schema.hh>
+
+#include <array>
+#include <cstdint>
+#include <string_view>
+#include <system_error>
+#include <tuple>
+
+/*
+ * key_table
+ */
+struct limits {
+    std::array<std::uint16_t, 3> ports;
+    bool strict;
+};
+
+struct account {
+    std::uint64_t id;
+    ftl::bigint<256> balance;
+    std::string_view owner;
+    std::int32_t delta;
+    limits policy;
+};
+
+template<>
+struct ftl::json::fields<limits> {
+    static constexpr auto value = std::make_tuple(
+        field("ports", &limits::ports),
+        field("strict", &limits::strict));
+};
+
+template<>
+struct ftl::json::fields<account> {
+    static constexpr auto value = std::make_tuple(
+        field("id", &account::id),
+        field("balance", &account::balance),
+        field("owner", &account::owner),
+        field("delta", &account::delta),
+        field("policy", &account::policy));
+};
+
+static_assert(ftl::json::impl::key_table<account>::size == 16);
+static_assert(ftl::json::impl::key_table<account>::find("balance") == 1);
+static_assert(ftl::json::impl::key_table<account>::find("policy") == 4);
+static_assert(ftl::json::impl::key_table<account>::find("polic") == 5);
+
+/*
+ * from_json & to_json
+ */
+static constexpr char account_text[] = R"({
+    "id": 18446744073709551615,
+    "unknown": [1, {"id": 2}],
+    "balance": 340282366920938463463374607431768211456,
+    "owner": "a \"b\"",
+    "delta": -7,
+    "policy": {"ports": [80, 443], "strict": true}
+})";
+
+static_assert([] {
+    account account = {};
+    const std::errc ec = ftl::json::from_json(ftl::json::constant_document_v<account_text>, account);
+    return ec == std::errc{}
+        && account.id == 0xFFFFFFFFFFFFFFFF
+        && account.balance[4] == 1 && account.balance[3] == 0
+        && account.owner == R"(a \"b\")"
+        && account.delta == -7
+        && account.policy.ports[1] == 443 && account.policy.ports[2] == 0
+        && account.policy.strict;
+}());
+static_assert([] {
+    account account = {};
+    ftl::json::from_json(ftl::json::constant_document_v<account_text>, account);
+    char buffer[160] = {};
+    ftl::json::writer out(buffer, buffer + sizeof(buffer));
+    ftl::json::to_json(out, account);
+    return out.good() && out.view() == R"({"id":18446744073709551615,"balance":340282366920938463463374607431768211456,"owner":"a \"b\"","delta":-7,"policy":{"ports":[80,443,0],"strict":true}})";
+}());
+static_assert([] {
+    limits limits = {};
+    return ftl::json::from_json(ftl::json::constant_document_v<account_text>.root()["policy"]["ports"], limits)
+        == std::errc::invalid_argument;
+}());
+
+int main() {}
@@ -0,0 +1,140 @@
+#include "check.hh"
+
+#include <ftl/json_stream.hh>
+
+#include <algorithm>
+#include <cstddef>
+#include <random>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#include <unistd.h>
+
+namespace {
+
+std::mt19937_64 generator(34);
+
+std::vector<std::string> serial_records(std::string_view text) {
+    std::vector<std::string> records;
+    ftl::json::impl::for_each_record(text, ftl::json::impl::find_newline, [&](std::string_view record) {
+        records.emplace_back(record);
+    });
+    return records;
+}
+
+// Records of up to 'longest' bytes, with blank lines, '\r\n' endings and
+// no newline after the last record
+std::string random_text(std::size_t records, std::size_t longest) {
+    std::string text;
+    for (std::size_t i = 0; i < records; ++i) {
+        const std::size_t kind = generator() % 8;
+        if (kind == 0) {
+            text += "  \n";
+            continue;
+        }
+        text += "{\"v\":\"";
+        text.append(generator() % longest, static_cast<char>('a' + i % 26));
+        text += kind == 1 ? "\"}\r\n" : "\"}\n";
+    }
+    text += "[1]";
+    return text;
+}
+
+/*
+ * find_newline_simd (Against find_newline from every position)
+ */
+void check_find_newline() {
+    for (std::size_t size = 0; size < 300; ++size) {
+        std::string text(size, 'x');
+        for (char& c : text) {
+            if (generator() % 40 == 0) {
+                c = '\n';
+            }
+        }
+        for (std::size_t from = 0; from <= size; ++from) {
+            FTL_CHECK(ftl::json::impl::find_newline_simd(text, from) == ftl::json::impl::find_newline(text, from));
+        }
+    }
+}
+
+/*
+ * split_records & for_each_record_parallel (Against the serial split)
+ */
+void check_split(const std::string& text) {
+    const std::vector<std::string> expected = serial_records(text);
+    for (const std::size_t threads : { 0, 1, 2, 3, 7, 64 }) {
+        const std::vector<std::string_view> ranges = ftl::json::split_records(text, threads);
+        FTL_CHECK(ranges.size() <= (threads == 0 ? 1 : threads));
+        std::string joined;
+        for (const std::string_view range : ranges) {
+            FTL_CHECK(!range.empty());
+            FTL_CHECK(range.data() == text.data() || range.data()[-1] == '\n');
+            joined += range;
+        }
+        FTL_CHECK(joined == text);
+
+        std::vector<std::vector<std::string>> per_worker(std::max<std::size_t>(threads, 1));
+        ftl::json::for_each_record_parallel(text, threads, [&](std::size_t worker, std::string_view record) {
+            per_worker[worker].emplace_back(record);
+        });
+        std::vector<std::string> records;
+        for (const auto& worker_records : per_worker) {
+            records.insert(records.end(), worker_records.begin(), worker_records.end());
+        }
+        FTL_CHECK(records == expected);
+    }
+}
+
+/*
+ * record_reader (Through a pipe written in uneven pieces)
+ */
+void check_reader(const std::string& text, std::size_t capacity) {
+    int fds[2];
+    FTL_CHECK(::pipe(fds) == 0);
+    std::thread writer([&, seed = generator()] {
+        std::mt19937_64 pieces(seed);
+        std::size_t written = 0;
+        while (written < text.size()) {
+            const std::size_t piece = std::min<std::size_t>(1 + pieces() % 97, text.size() - written);
+            const ::ssize_t count = ::write(fds[1], text.data() + written, piece);
+            if (count <= 0) {
+                break;
+            }
+            written += static_cast<std::size_t>(count);
+        }
+        ::close(fds[1]);
+    });
+
+    ftl::json::record_reader reader(fds[0], capacity);
+    std::vector<std::string> records;
+    std::string_view record;
+    while (reader.next(record)) {
+        records.emplace_back(record);
+    }
+    writer.join();
+    ::close(fds[0]);
+    FTL_CHECK(reader.good());
+    FTL_CHECK(records == serial_records(text));
+}
+
+} //namespace
+
+int main() {
+    check_find_newline();
+
+    const std::string text = random_text(2000, 200);
+    check_split(text);
+    check_split("");
+    check_split("\n\n");
+    check_split("{}");
+
+    // Capacities below, around and above the record lengths
+    for (const std::size_t capacity : { 0, 1, 7, 64, 256, 1 << 20 }) {
+        check_reader(text, capacity);
+    }
+    check_reader("", 4);
+    check_reader("\n{}\n", 1);
+    return ftl::test::failures() != 0;
+}
@@ -0,0 +1,114 @@
+#include "check.hh"
+
+#include <ftl/scratch.hh>
+
+#include <cstddef>
+#include <cstdint>
+#include <memory_resource>
+
+namespace {
+
+/*
+ * counting_resource (Counts the calls and the bytes outstanding upstream)
+ */
+class counting_resource : public std::pmr::memory_resource {
+public:
+    std::size_t allocations = 0;
+    std::size_t deallocations = 0;
+    std::size_t outstanding = 0;
+
+private:
+    void* do_allocate(std::size_t bytes, std::size_t alignment) override {
+        ++allocations;
+        outstanding += bytes;
+        return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+    }
+
+    void do_deallocate(void* p, std::size_t bytes, std::size_t alignment) override {
+        ++deallocations;
+        outstanding -= bytes;
+        std::pmr::new_delete_resource()->deallocate(p, bytes, alignment);
+    }
+
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override {
+        return this == &other;
+    }
+};
+
+} //namespace
+
+/*
+ * scratch_arena, scratch_scope & scratch_buffer
+ */
+int main() {
+    counting_resource upstream;
+    {
+        ftl::scratch_arena arena(&upstream, 1024);
+        FTL_CHECK(arena.in_use() == 0 && arena.peak() == 0 && arena.reserved() == 0);
+
+        // One round of work: a small allocation, an aligned one, then one
+        // that needs a second block
+        const ftl::scratch_arena::marker start = arena.mark();
+        void* const small = arena.allocate(100);
+        FTL_CHECK(upstream.allocations == 1 && arena.reserved() == 1024);
+        FTL_CHECK(arena.in_use() == 100 && arena.peak() == 100);
+
+        const ftl::scratch_arena::marker middle = arena.mark();
+        void* const aligned = arena.allocate(8, 64);
+        FTL_CHECK(reinterpret_cast<std::uintptr_t>(aligned) % 64 == 0);
+        FTL_CHECK(arena.in_use() == 136);
+        void* const large = arena.allocate(2000);
+        FTL_CHECK(upstream.allocations == 2 && arena.reserved() == 1024 + 2048);
+        FTL_CHECK(arena.in_use() == 1024 + 2000 && arena.peak() == 1024 + 2000);
+
+        // Rolling back to a mark hands out the same memory again
+        arena.release(middle);
+        FTL_CHECK(arena.in_use() == 100 && arena.peak() == 1024 + 2000);
+        FTL_CHECK(arena.allocate(8, 64) == aligned);
+
+        // Repeating the round reuses both blocks without the upstream
+        for (int round = 0; round < 10; ++round) {
+            arena.release(start);
+            FTL_CHECK(arena.in_use() == 0);
+            FTL_CHECK(arena.allocate(100) == small);
+            FTL_CHECK(arena.allocate(8, 64) == aligned);
+            FTL_CHECK(arena.allocate(2000) == large);
+        }
+        FTL_CHECK(upstream.allocations == 2 && upstream.deallocations == 0);
+        FTL_CHECK(arena.peak() == 1024 + 2000);
+
+        arena.release(start);
+        arena.reset_peak();
+        FTL_CHECK(arena.peak() == 0);
+        arena.allocate(10);
+        FTL_CHECK(arena.peak() == 10);
+
+        // A next block too small for the request goes back for a larger one
+        arena.allocate(5000);
+        FTL_CHECK(upstream.allocations == 3 && upstream.deallocations == 1);
+        FTL_CHECK(arena.reserved() == 1024 + 5056 && upstream.outstanding == arena.reserved());
+
+        // Buffers are zeroed and roll the arena back when destroyed
+        arena.release(start);
+        {
+            ftl::scratch_buffer<std::uint32_t> buffer(10, arena);
+            FTL_CHECK(buffer.size() == 10 && buffer[0] == 0 && buffer[9] == 0);
+            FTL_CHECK(reinterpret_cast<std::uintptr_t>(buffer.data()) % ftl::scratch_arena::block_alignment == 0);
+            buffer[9] = 7;
+            FTL_CHECK(arena.in_use() == 40);
+        }
+        FTL_CHECK(arena.in_use() == 0);
+
+        // A scope points this thread's scratch at the arena, then restores it
+        ftl::scratch_arena* const previous = &ftl::thread_scratch();
+        {
+            const ftl::scratch_scope scope(arena);
+            FTL_CHECK(&ftl::thread_scratch() == &arena);
+            const ftl::scratch_buffer<std::uint64_t> buffer(4);
+            FTL_CHECK(arena.in_use() == 32 && buffer[3] == 0);
+        }
+        FTL_CHECK(&ftl::thread_scratch() == previous && arena.in_use() == 0);
+    }
+    FTL_CHECK(upstream.outstanding == 0 && upstream.deallocations == upstream.allocations);
+    return ftl::test::failures() != 0;
+}